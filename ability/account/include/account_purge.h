@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ACCOUNT_PURGE_H
+#define ACCOUNT_PURGE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rdb_store.h"
+
+namespace OHOS {
+namespace Contacts {
+// 每个事务删除的raw_contact个数
+constexpr int ACCOUNT_PURGE_CHUNK_SIZE = 200;
+// 两个事务之间让出数据库的时间
+constexpr int ACCOUNT_PURGE_YIELD_MS = 5;
+
+// account_purge_cursor表中的一行：最后删除的raw_contact id、已删除个数
+struct AccountPurgeCursor {
+    int accountId = 0;
+    int lastRawContactId = 0;
+    int64_t deletedCount = 0;
+};
+
+/**
+ * 删除账号下的全部数据
+ * 按raw_contact分批删除contact_data、raw_contact、孤立的contact，每批一个事务，批次之间让出数据库，
+ * 进度记录在account_purge_cursor表中；最后一个事务删除群组、账号和游标。
+ * 进程中断后通过ResumePending从游标记录的位置继续
+ */
+class AccountPurge {
+public:
+    explicit AccountPurge(std::shared_ptr<OHOS::NativeRdb::RdbStore> store);
+    ~AccountPurge();
+    int Purge(int accountId);
+    // 是否有上次未完成的清理
+    bool HasPending();
+    // 按游标继续上次未完成的清理
+    void ResumePending();
+
+private:
+    struct RawContactChunk {
+        std::vector<OHOS::NativeRdb::ValueObject> rawContactIds;
+        std::vector<OHOS::NativeRdb::ValueObject> contactIds;
+        int lastRawContactId = 0;
+    };
+
+    int Purge(const AccountPurgeCursor &cursor);
+    int QueryCursors(std::vector<AccountPurgeCursor> &cursors);
+    int SaveCursor(int accountId, int lastRawContactId, int64_t deletedCount);
+    int QueryRawContactChunk(int accountId, int afterRawContactId, RawContactChunk &chunk);
+    int PurgeContactsChunk(int accountId, const RawContactChunk &chunk, int64_t deletedCount);
+    int PurgeAccount(int accountId);
+    int RunInTransaction(const std::function<int()> &operation);
+    static std::string BuildPlaceholders(size_t count);
+
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store_;
+};
+} // namespace Contacts
+} // namespace OHOS
+
+#endif // ACCOUNT_PURGE_H
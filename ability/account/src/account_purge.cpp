@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "account_purge.h"
+
+#include <chrono>
+#include <thread>
+
+#include "common.h"
+#include "contacts_columns.h"
+#include "contacts_common.h"
+#include "hilog_wrapper.h"
+#include "rdb_errno.h"
+
+namespace OHOS {
+namespace Contacts {
+namespace {
+constexpr int COLUMN_INDEX_RAW_CONTACT_ID = 0;
+constexpr int COLUMN_INDEX_CONTACT_ID = 1;
+constexpr int COLUMN_INDEX_CURSOR_ACCOUNT_ID = 0;
+constexpr int COLUMN_INDEX_CURSOR_LAST_RAW_CONTACT_ID = 1;
+constexpr int COLUMN_INDEX_CURSOR_DELETED_COUNT = 2;
+// ",?"
+constexpr size_t PLACEHOLDER_LENGTH = 2;
+}
+
+AccountPurge::AccountPurge(std::shared_ptr<OHOS::NativeRdb::RdbStore> store) : store_(store)
+{
+}
+
+AccountPurge::~AccountPurge()
+{
+}
+
+int AccountPurge::Purge(int accountId)
+{
+    if (store_ == nullptr) {
+        HILOG_ERROR("AccountPurge Purge store is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    if (accountId <= ID_EMPTY) {
+        return RDB_EXECUTE_OK;
+    }
+    AccountPurgeCursor cursor;
+    cursor.accountId = accountId;
+    return Purge(cursor);
+}
+
+// 从游标位置继续清理：lastRawContactId之后的raw_contact分批删除，删完后删除群组和账号
+int AccountPurge::Purge(const AccountPurgeCursor &cursor)
+{
+    int accountId = cursor.accountId;
+    auto start = std::chrono::steady_clock::now();
+    int64_t deletedCount = cursor.deletedCount;
+    int lastRawContactId = cursor.lastRawContactId;
+    int chunkCount = 0;
+    while (true) {
+        RawContactChunk chunk;
+        int ret = QueryRawContactChunk(accountId, lastRawContactId, chunk);
+        if (ret != RDB_EXECUTE_OK) {
+            return ret;
+        }
+        if (chunk.rawContactIds.empty()) {
+            break;
+        }
+        deletedCount += static_cast<int64_t>(chunk.rawContactIds.size());
+        ret = PurgeContactsChunk(accountId, chunk, deletedCount);
+        if (ret != RDB_EXECUTE_OK) {
+            // 进度保存在游标中，下次同步账号时继续
+            HILOG_ERROR("AccountPurge chunk failed, accountId:%{public}d, ret:%{public}d", accountId, ret);
+            return ret;
+        }
+        lastRawContactId = chunk.lastRawContactId;
+        chunkCount++;
+        // 让出数据库，其他读写不会被整个清理过程阻塞
+        std::this_thread::sleep_for(std::chrono::milliseconds(ACCOUNT_PURGE_YIELD_MS));
+    }
+    int ret = PurgeAccount(accountId);
+    auto costMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    HILOG_INFO("AccountPurge accountId:%{public}d, rawContacts:%{public}lld, chunks:%{public}d, "
+        "cost:%{public}lld ms, ret:%{public}d",
+        accountId, (long long) deletedCount, chunkCount, (long long) costMs, ret);
+    return ret;
+}
+
+bool AccountPurge::HasPending()
+{
+    if (store_ == nullptr) {
+        return false;
+    }
+    std::string sql = "SELECT 1 FROM ";
+    sql.append(ContactTableName::ACCOUNT_PURGE_CURSOR).append(" LIMIT 1");
+    std::vector<std::string> selectArgs;
+    auto resultSet = store_->QuerySql(sql, selectArgs);
+    if (resultSet == nullptr) {
+        return false;
+    }
+    bool hasPending = resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK;
+    resultSet->Close();
+    return hasPending;
+}
+
+void AccountPurge::ResumePending()
+{
+    if (store_ == nullptr) {
+        return;
+    }
+    std::vector<AccountPurgeCursor> cursors;
+    if (QueryCursors(cursors) != RDB_EXECUTE_OK) {
+        return;
+    }
+    for (const auto &cursor : cursors) {
+        HILOG_WARN("AccountPurge resume pending purge, accountId:%{public}d, lastRawContactId:%{public}d, "
+            "deleted:%{public}lld", cursor.accountId, cursor.lastRawContactId, (long long) cursor.deletedCount);
+        Purge(cursor);
+    }
+}
+
+int AccountPurge::QueryCursors(std::vector<AccountPurgeCursor> &cursors)
+{
+    std::string sql = "SELECT ";
+    sql.append(AccountPurgeCursorColumns::ACCOUNT_ID).append(", ")
+        .append(AccountPurgeCursorColumns::LAST_RAW_CONTACT_ID).append(", ")
+        .append(AccountPurgeCursorColumns::DELETED_COUNT)
+        .append(" FROM ")
+        .append(ContactTableName::ACCOUNT_PURGE_CURSOR);
+    std::vector<std::string> selectArgs;
+    auto resultSet = store_->QuerySql(sql, selectArgs);
+    if (resultSet == nullptr) {
+        HILOG_ERROR("AccountPurge QueryCursors query failed");
+        return RDB_EXECUTE_FAIL;
+    }
+    int resultSetNum = resultSet->GoToFirstRow();
+    while (resultSetNum == OHOS::NativeRdb::E_OK) {
+        AccountPurgeCursor cursor;
+        resultSet->GetInt(COLUMN_INDEX_CURSOR_ACCOUNT_ID, cursor.accountId);
+        resultSet->GetInt(COLUMN_INDEX_CURSOR_LAST_RAW_CONTACT_ID, cursor.lastRawContactId);
+        resultSet->GetLong(COLUMN_INDEX_CURSOR_DELETED_COUNT, cursor.deletedCount);
+        if (cursor.accountId > ID_EMPTY) {
+            cursors.push_back(cursor);
+        }
+        resultSetNum = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    return RDB_EXECUTE_OK;
+}
+
+int AccountPurge::SaveCursor(int accountId, int lastRawContactId, int64_t deletedCount)
+{
+    int64_t updateTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string sql = "INSERT OR REPLACE INTO ";
+    sql.append(ContactTableName::ACCOUNT_PURGE_CURSOR)
+        .append(" (")
+        .append(AccountPurgeCursorColumns::ACCOUNT_ID).append(", ")
+        .append(AccountPurgeCursorColumns::LAST_RAW_CONTACT_ID).append(", ")
+        .append(AccountPurgeCursorColumns::DELETED_COUNT).append(", ")
+        .append(AccountPurgeCursorColumns::UPDATE_TIME)
+        .append(") VALUES (?, ?, ?, ?)");
+    std::vector<OHOS::NativeRdb::ValueObject> bindArgs = {OHOS::NativeRdb::ValueObject(accountId),
+        OHOS::NativeRdb::ValueObject(lastRawContactId), OHOS::NativeRdb::ValueObject(deletedCount),
+        OHOS::NativeRdb::ValueObject(updateTime)};
+    return store_->ExecuteSql(sql, bindArgs);
+}
+
+int AccountPurge::QueryRawContactChunk(int accountId, int afterRawContactId, RawContactChunk &chunk)
+{
+    std::string sql = "SELECT ";
+    sql.append(RawContactColumns::ID).append(", ")
+        .append(RawContactColumns::CONTACT_ID)
+        .append(" FROM ")
+        .append(ContactTableName::RAW_CONTACT)
+        .append(" WHERE ")
+        .append(RawContactColumns::ACCOUNT_ID)
+        .append(" = ? AND ")
+        .append(RawContactColumns::ID)
+        .append(" > ? ORDER BY ")
+        .append(RawContactColumns::ID)
+        .append(" LIMIT ")
+        .append(std::to_string(ACCOUNT_PURGE_CHUNK_SIZE));
+    std::vector<std::string> selectArgs = {std::to_string(accountId), std::to_string(afterRawContactId)};
+    auto resultSet = store_->QuerySql(sql, selectArgs);
+    if (resultSet == nullptr) {
+        HILOG_ERROR("AccountPurge QueryRawContactChunk query failed");
+        return RDB_EXECUTE_FAIL;
+    }
+    int resultSetNum = resultSet->GoToFirstRow();
+    while (resultSetNum == OHOS::NativeRdb::E_OK) {
+        int rawContactId = ID_EMPTY;
+        int contactId = ID_EMPTY;
+        bool isContactIdNull = true;
+        resultSet->GetInt(COLUMN_INDEX_RAW_CONTACT_ID, rawContactId);
+        resultSet->IsColumnNull(COLUMN_INDEX_CONTACT_ID, isContactIdNull);
+        chunk.rawContactIds.emplace_back(rawContactId);
+        if (!isContactIdNull) {
+            resultSet->GetInt(COLUMN_INDEX_CONTACT_ID, contactId);
+            chunk.contactIds.emplace_back(contactId);
+        }
+        chunk.lastRawContactId = rawContactId;
+        resultSetNum = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    return RDB_EXECUTE_OK;
+}
+
+int AccountPurge::PurgeContactsChunk(int accountId, const RawContactChunk &chunk, int64_t deletedCount)
+{
+    std::string rawIdPlaceholders = BuildPlaceholders(chunk.rawContactIds.size());
+    return RunInTransaction([&]() {
+        std::string sql = "DELETE FROM ";
+        sql.append(ContactTableName::CONTACT_DATA)
+            .append(" WHERE ")
+            .append(ContactDataColumns::RAW_CONTACT_ID)
+            .append(" IN (").append(rawIdPlaceholders).append(")");
+        int ret = store_->ExecuteSql(sql, chunk.rawContactIds);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
+        sql = "DELETE FROM ";
+        sql.append(ContactTableName::RAW_CONTACT)
+            .append(" WHERE ")
+            .append(RawContactColumns::ID)
+            .append(" IN (").append(rawIdPlaceholders).append(")");
+        ret = store_->ExecuteSql(sql, chunk.rawContactIds);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
+        // 只删除不再被其他账号raw_contact引用的contact
+        if (!chunk.contactIds.empty()) {
+            sql = "DELETE FROM ";
+            sql.append(ContactTableName::CONTACT)
+                .append(" WHERE ")
+                .append(ContactColumns::ID)
+                .append(" IN (").append(BuildPlaceholders(chunk.contactIds.size())).append(")")
+                .append(" AND NOT EXISTS (SELECT 1 FROM ")
+                .append(ContactTableName::RAW_CONTACT)
+                .append(" WHERE ")
+                .append(ContactTableName::RAW_CONTACT).append(".").append(RawContactColumns::CONTACT_ID)
+                .append(" = ")
+                .append(ContactTableName::CONTACT).append(".").append(ContactColumns::ID)
+                .append(")");
+            ret = store_->ExecuteSql(sql, chunk.contactIds);
+            if (ret != OHOS::NativeRdb::E_OK) {
+                return ret;
+            }
+        }
+        return SaveCursor(accountId, chunk.lastRawContactId, deletedCount);
+    });
+}
+
+int AccountPurge::PurgeAccount(int accountId)
+{
+    // 群组、账号和游标在同一个事务中删除，中断时游标还在，下次从联系人已删完的位置继续
+    return RunInTransaction([&]() {
+        std::vector<OHOS::NativeRdb::ValueObject> bindArgs = {OHOS::NativeRdb::ValueObject(accountId)};
+        std::string sql = "DELETE FROM ";
+        sql.append(ContactTableName::GROUPS)
+            .append(" WHERE ")
+            .append(GroupsColumns::ACCOUNT_ID)
+            .append(" = ?");
+        int ret = store_->ExecuteSql(sql, bindArgs);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
+        sql = "DELETE FROM ";
+        sql.append(ContactTableName::ACCOUNT)
+            .append(" WHERE ")
+            .append(AccountColumns::ID)
+            .append(" = ?");
+        ret = store_->ExecuteSql(sql, bindArgs);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
+        sql = "DELETE FROM ";
+        sql.append(ContactTableName::ACCOUNT_PURGE_CURSOR)
+            .append(" WHERE ")
+            .append(AccountPurgeCursorColumns::ACCOUNT_ID)
+            .append(" = ?");
+        return store_->ExecuteSql(sql, bindArgs);
+    });
+}
+
+int AccountPurge::RunInTransaction(const std::function<int()> &operation)
+{
+    int ret = store_->BeginTransaction();
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("AccountPurge BeginTransaction failed:%{public}d", ret);
+        return RDB_EXECUTE_FAIL;
+    }
+    ret = operation();
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("AccountPurge operation failed:%{public}d", ret);
+        store_->RollBack();
+        return RDB_EXECUTE_FAIL;
+    }
+    ret = store_->Commit();
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("AccountPurge Commit failed:%{public}d", ret);
+        store_->RollBack();
+        return RDB_EXECUTE_FAIL;
+    }
+    return RDB_EXECUTE_OK;
+}
+
+std::string AccountPurge::BuildPlaceholders(size_t count)
+{
+    std::string placeholders;
+    placeholders.reserve(count * PLACEHOLDER_LENGTH);
+    for (size_t i = 0; i < count; i++) {
+        placeholders.append(i == 0 ? "?" : ",?");
+    }
+    return placeholders;
+}
+} // namespace Contacts
+} // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include <mutex>
 
+#include "account_purge.h"
 #include "common.h"
 #include "contacts.h"
 #include "contacts_account.h"
@@ -110,10 +111,14 @@ void AccountSync::SyncUpdateAccount(std::vector<OHOS::AccountSA::OhosAccountInfo
     std::vector<OHOS::AccountSA::OhosAccountInfo> shouldAddAccounts;
     getShouldUpdateAndAddAccounts(sysAccounts, accounts, shouldUpdateAccounts, shouldAddAccounts);
     HILOG_INFO("SyncUpdateAccount:%{public}zu, :%{public}zu", shouldUpdateAccounts.size(), shouldAddAccounts.size());
+    // 上次进程中断时未清理完的账号，与本次是否有新移除的账号无关，从游标位置继续
+    AccountPurge accountPurge(store);
+    bool hasPendingPurge = accountPurge.HasPending();
     store->BeginTransaction();
-    if (!notInSysAccounts.empty()) {
+    if (hasPendingPurge || !notInSysAccounts.empty()) {
         g_contactsAccount->StopForegin(store);
         store->Commit();
+        accountPurge.ResumePending();
         for (size_t i = 0; i < notInSysAccounts.size(); i++) {
             int accountId = g_contactsAccount->GetNotExistAccount(store, notInSysAccounts[i]);
             HILOG_INFO("SyncUpdateAccount getNotExistAccount value is :%{public}d", accountId);
@@ -131,31 +136,14 @@ void AccountSync::SyncUpdateAccount(std::vector<OHOS::AccountSA::OhosAccountInfo
 
 int AccountSync::ClearData(std::shared_ptr<OHOS::NativeRdb::RdbStore> store, int accountId)
 {
-    RawContacts contactsRawContact;
-    Contacts contactsContact;
-    if (accountId > ID_EMPTY) {
-        int needDeleteRawContactId = contactsRawContact.GetDeleteRawContactIdByAccountId(store, accountId);
-        HILOG_INFO("GetDeleteRawContactIdByAccountId successfully, needDeleteRawContactId is %{public}d",
-            needDeleteRawContactId);
-        int needDeleteContactId = contactsRawContact.GetDeleteContactIdByAccountId(store, accountId);
-        HILOG_INFO("GetDeleteContactIdByAccountId successfully needDeleteContactId is %{public}d", needDeleteContactId);
-        g_contactsAccount->DeleteDataByRawId(store, needDeleteRawContactId);
-        int ret = store->Commit();
-        HILOG_INFO("DeleteDataByRawId successfully commit ret %{public}d", ret);
-        contactsRawContact.DeleteRawcontactByRawId(store, needDeleteRawContactId);
-        ret = store->Commit();
-        HILOG_INFO("DeleteRawcontactByRawId successfully commit ret %{public}d", ret);
-        contactsContact.DeleteContactById(store, needDeleteContactId);
-        ret = store->Commit();
-        HILOG_INFO("DeletecontactsById successfully commit ret %{public}d", ret);
-        g_contactsAccount->DeleteGroupsByAccountId(store, accountId);
-        ret = store->Commit();
-        HILOG_INFO("DeleteGroupsByAccountId successfully commit ret %{public}d", ret);
-        g_contactsAccount->DeleteAccountByAccountId(store, accountId);
-        ret = store->Commit();
-        HILOG_INFO("DeleteAccountByAccountId successfully commit ret %{public}d", ret);
+    if (accountId <= ID_EMPTY) {
+        return RDB_EXECUTE_OK;
     }
-    return RDB_EXECUTE_OK;
+    // 按account_id分批在事务中删除账号下的联系人、群组和账号，中断后可以继续
+    AccountPurge accountPurge(store);
+    int ret = accountPurge.Purge(accountId);
+    HILOG_INFO("ClearData accountId %{public}d ret %{public}d", accountId, ret);
+    return ret;
 }
 } // namespace Contacts
 } // namespace OHOS
@@ -161,23 +161,91 @@ constexpr const char *CONTACT_DATA = "datashare:///com.ohos.contactsdataability/
 constexpr const char *UPDATE_CALLLOG_CHANGE_TIME =
     "UPDATE call_settings set calllog_change_time = datetime('now')";
 
+// 号码 -> 头像(extra4)，陌生号码新增通话记录时按主键查头像，不再扫描calllog
+constexpr const char *CREATE_NUMBER_AVATAR =
+    "CREATE TABLE IF NOT EXISTS [number_avatar]("
+    "[format_phone_number] TEXT PRIMARY KEY NOT NULL, "
+    "[extra4] TEXT NOT NULL) WITHOUT ROWID";
+
 constexpr const char *UPDATE_CALLLOG_AVATAR =
     "CREATE TRIGGER IF NOT EXISTS [update_calllog_avatar] AFTER INSERT ON [calllog] "
     "WHEN NEW.quicksearch_key = '' OR NEW.quicksearch_key IS NULL "
     "BEGIN "
     "UPDATE [calllog] "
     "SET "
-    "extra4 = (SELECT extra4 FROM calllog WHERE format_phone_number = NEW.format_phone_number "
-    "AND format_phone_number !='' AND extra4 IS NOT NULL LIMIT 1) "
+    "extra4 = (SELECT extra4 FROM number_avatar WHERE format_phone_number = NEW.format_phone_number "
+    "AND format_phone_number !='') "
     "WHERE rowid = NEW.rowid;"
     "END";
 
+// 已知联系人的通话记录带头像插入时记录号码的头像；条件与update_calllog_avatar互斥，两者的执行顺序无关
+constexpr const char *INSERT_NUMBER_AVATAR =
+    "CREATE TRIGGER IF NOT EXISTS [insert_number_avatar] AFTER INSERT ON [calllog] "
+    "WHEN NEW.extra4 IS NOT NULL AND NEW.format_phone_number != '' AND NEW.quicksearch_key != '' "
+    "BEGIN "
+    "INSERT OR REPLACE INTO [number_avatar]([format_phone_number], [extra4]) "
+    "VALUES (NEW.format_phone_number, NEW.extra4);"
+    "END";
+
+// 联系人头像变化时calllog按号码批量更新extra4，同步到number_avatar；extra4置空或号码变化时，
+// 旧号码改取剩余记录中最新的头像（走calllog_format_phone_number_begin_time_index），没有剩余时删除
+constexpr const char *UPDATE_NUMBER_AVATAR =
+    "CREATE TRIGGER IF NOT EXISTS [update_number_avatar] AFTER UPDATE OF [extra4], [format_phone_number] "
+    "ON [calllog] "
+    "WHEN OLD.extra4 IS NOT NULL OR NEW.extra4 IS NOT NULL "
+    "BEGIN "
+    "DELETE FROM [number_avatar] WHERE format_phone_number = OLD.format_phone_number "
+    "AND OLD.extra4 IS NOT NULL AND (NEW.extra4 IS NULL OR NEW.format_phone_number IS NOT OLD.format_phone_number);"
+    "INSERT INTO [number_avatar]([format_phone_number], [extra4]) "
+    "SELECT format_phone_number, extra4 FROM [calllog] WHERE format_phone_number = OLD.format_phone_number "
+    "AND extra4 IS NOT NULL AND OLD.extra4 IS NOT NULL AND OLD.format_phone_number != '' "
+    "AND (NEW.extra4 IS NULL OR NEW.format_phone_number IS NOT OLD.format_phone_number) "
+    "ORDER BY begin_time DESC LIMIT 1;"
+    "INSERT OR REPLACE INTO [number_avatar]([format_phone_number], [extra4]) "
+    "SELECT NEW.format_phone_number, NEW.extra4 WHERE NEW.extra4 IS NOT NULL AND NEW.format_phone_number != '';"
+    "END";
+
+// 删除带头像的通话记录时，号码改取剩余记录中最新的头像，没有剩余带头像的记录时删除
+constexpr const char *DELETE_NUMBER_AVATAR =
+    "CREATE TRIGGER IF NOT EXISTS [delete_number_avatar] AFTER DELETE ON [calllog] "
+    "WHEN OLD.extra4 IS NOT NULL AND OLD.format_phone_number != '' "
+    "BEGIN "
+    "DELETE FROM [number_avatar] WHERE format_phone_number = OLD.format_phone_number;"
+    "INSERT INTO [number_avatar]([format_phone_number], [extra4]) "
+    "SELECT format_phone_number, extra4 FROM [calllog] WHERE format_phone_number = OLD.format_phone_number "
+    "AND extra4 IS NOT NULL ORDER BY begin_time DESC LIMIT 1;"
+    "END";
+
+// 升级时按通话记录先后回填，同一号码保留最新的头像
+constexpr const char *INIT_NUMBER_AVATAR =
+    "INSERT OR REPLACE INTO [number_avatar]([format_phone_number], [extra4]) "
+    "SELECT format_phone_number, extra4 FROM calllog WHERE format_phone_number != '' AND extra4 IS NOT NULL "
+    "ORDER BY id";
+
 constexpr const char *CALL_LOG_FAIL_ABS_RECORD_ID_INDEX =
     "CREATE INDEX IF NOT EXISTS [fail_abs_record_id_index] ON [calllog] ([fail_abs_record_id])";
 
 constexpr const char *CALL_LOG_NOTES_ID_INDEX =
     "CREATE INDEX IF NOT EXISTS [notes_id_index] ON [calllog] ([notes_id])";
 
+// 查询非隐私记录时追加的条件，须与部分索引的WHERE一致（字面量，绑定参数无法匹配部分索引）
+constexpr const char *CALL_LOG_NOT_PRIVACY_CONDITION = "privacy_tag != 1";
+
+// 通话记录列表按时间倒序分页
+constexpr const char *CALL_LOG_BEGIN_TIME_NOT_PRIVACY_INDEX =
+    "CREATE INDEX IF NOT EXISTS [calllog_begin_time_not_privacy_index] ON [calllog] ([begin_time] DESC) "
+    "WHERE privacy_tag != 1";
+
+// 单个号码的通话记录
+constexpr const char *CALL_LOG_FORMAT_PHONE_NUMBER_BEGIN_TIME_INDEX =
+    "CREATE INDEX IF NOT EXISTS [calllog_format_phone_number_begin_time_index] ON [calllog] "
+    "([format_phone_number], [begin_time])";
+
+// 未读未接来电
+constexpr const char *CALL_LOG_MISSED_UNREAD_INDEX =
+    "CREATE INDEX IF NOT EXISTS [calllog_missed_unread_index] ON [calllog] "
+    "([call_direction], [answer_state], [is_read])";
+
 // v21版本后新增字段统计
 constexpr const char *CALL_LOG_ADD_IS_CNAP = "ALTER TABLE calllog ADD COLUMN is_cnap INTEGER DEFAULT 0;";
 constexpr const char *CALL_LOG_ADD_PRIVACY_TAG = "ALTER TABLE calllog ADD COLUMN privacy_tag INTEGER DEFAULT -1;";
@@ -214,6 +282,7 @@ const std::map<std::string, const char *> CALL_LOG_TABLES = {
     {CallsTableName::CALLLOG, CREATE_CALLLOG},
     {CallsTableName::VOICEMAIL, CREATE_VOICEMAIL},
     {CallsTableName::REPLYING, CREATE_REPLYING},
+    {CallsTableName::NUMBER_AVATAR, CREATE_NUMBER_AVATAR},
 };
 
 const std::map<std::string, const char *> CALL_LOG_ADD_COLUMNS = {
@@ -343,11 +343,17 @@ constexpr int DATABASE_VERSION_42 = 42;
 // DATABASE VERSION 43
 constexpr int DATABASE_VERSION_43 = 43;
 
+// DATABASE VERSION 44, 删除副作用outbox表
+constexpr int DATABASE_VERSION_44 = 44;
+
+// DATABASE VERSION 45, contact_data的has_*触发器支持批量写模式
+constexpr int DATABASE_VERSION_45 = 45;
+
 // DATABASE OPEN VERSION CONTACTS
-constexpr int DATABASE_CONTACTS_OPEN_VERSION = 43;
+constexpr int DATABASE_CONTACTS_OPEN_VERSION = 45;
 
 // DATABASE OPEN VERSION CallLog
-constexpr int DATABASE_CALL_LOG_OPEN_VERSION = 27;
+constexpr int DATABASE_CALL_LOG_OPEN_VERSION = 29;
 
 // DATABASE OPEN VERSION Blocklist
 constexpr int DATABASE_BLOCKLIST_OPEN_VERSION = 1;
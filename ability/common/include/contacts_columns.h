@@ -44,6 +44,10 @@ public:
     static constexpr const char *PRIVACY_CONTACTS_BACKUP = "privacy_contacts_backup";
     static constexpr const char *POSTER = "poster";
     static constexpr const char *KIT_CONTACTS_SYNC_INFO = "kit_contacts_sync_info";
+    static constexpr const char *SIDE_EFFECT_OUTBOX = "side_effect_outbox";
+    static constexpr const char *ACCOUNT_PURGE_CURSOR = "account_purge_cursor";
+    static constexpr const char *BULK_WRITE_SESSION = "bulk_write_session";
+    static constexpr const char *BULK_WRITE_RAW_CONTACT = "bulk_write_raw_contact";
 };
 
 class CallLogColumns {
@@ -111,6 +115,7 @@ public:
     static constexpr const char *CALLLOG = "calllog";
     static constexpr const char *VOICEMAIL = "voicemail";
     static constexpr const char *REPLYING = "replying";
+    static constexpr const char *NUMBER_AVATAR = "number_avatar";
 };
 
 class ViewName {
@@ -463,6 +468,22 @@ public:
     static constexpr const char *TOTAL_BATCHES = "total_batches";
     static constexpr const char *INSERT_STATUS = "insert_status";
 };
+class SideEffectOutboxColumns {
+public:
+    ~SideEffectOutboxColumns();
+    static constexpr const char *ID = "id";
+    static constexpr const char *EFFECT_TYPE = "effect_type";
+    static constexpr const char *PAYLOAD = "payload";
+    static constexpr const char *CREATE_TIME = "create_time";
+};
+class AccountPurgeCursorColumns {
+public:
+    ~AccountPurgeCursorColumns();
+    static constexpr const char *ACCOUNT_ID = "account_id";
+    static constexpr const char *LAST_RAW_CONTACT_ID = "last_raw_contact_id";
+    static constexpr const char *DELETED_COUNT = "deleted_count";
+    static constexpr const char *UPDATE_TIME = "update_time";
+};
 
 constexpr const char *RAW_CONTACT_ADD_PRIMARY_CONTACT =
     "ALTER TABLE raw_contact ADD COLUMN primary_contact INTEGER DEFAULT 0;";
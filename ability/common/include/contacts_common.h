@@ -655,6 +655,132 @@ constexpr const char *CREATE_KIT_CONTACTS_SYNC_INFO =
     "[total_batches] INTEGER, "
     "[insert_status] INTEGER DEFAULT 0)";
 
+// side_effect_outbox table creation statement, side effects of deletes waiting for the background drain
+constexpr const char *CREATE_SIDE_EFFECT_OUTBOX =
+    "CREATE TABLE IF NOT EXISTS [side_effect_outbox] ( "
+    "[id] INTEGER PRIMARY KEY AUTOINCREMENT, "
+    "[effect_type] INTEGER NOT NULL, "
+    "[payload] TEXT, "
+    "[create_time] INTEGER)";
+
+// account_purge_cursor table creation statement, progress of account purges so that an interrupted purge resumes
+constexpr const char *CREATE_ACCOUNT_PURGE_CURSOR =
+    "CREATE TABLE IF NOT EXISTS [account_purge_cursor] ( "
+    "[account_id] INTEGER PRIMARY KEY, "
+    "[last_raw_contact_id] INTEGER NOT NULL DEFAULT 0, "
+    "[deleted_count] INTEGER NOT NULL DEFAULT 0, "
+    "[update_time] INTEGER)";
+
+// bulk_write_session table creation statement, holds a row only inside a bulk write transaction; while it does, the
+// contact_data triggers below skip the per-row contact flag updates. start_data_id is the largest contact_data id when
+// the bulk write began, rows above it are the inserted ones
+constexpr const char *CREATE_BULK_WRITE_SESSION =
+    "CREATE TABLE IF NOT EXISTS [bulk_write_session] ( "
+    "[id] INTEGER PRIMARY KEY, "
+    "[start_data_id] INTEGER NOT NULL DEFAULT 0)";
+
+// bulk_write_raw_contact table creation statement, raw contacts whose contact_data changed during a bulk write
+constexpr const char *CREATE_BULK_WRITE_RAW_CONTACT =
+    "CREATE TABLE IF NOT EXISTS [bulk_write_raw_contact] ( "
+    "[raw_contact_id] INTEGER PRIMARY KEY)";
+
+// contacts.db v45 of update_contact_by_insert_contact_data, skipped during a bulk write
+constexpr const char *BULK_AWARE_UPDATE_CONTACT_BY_INSERT_CONTACT_DATA =
+    "CREATE TRIGGER IF NOT EXISTS [update_contact_by_insert_contact_data] AFTER INSERT ON [contact_data] FOR EACH ROW "
+    "WHEN NOT EXISTS (SELECT 1 FROM [bulk_write_session]) "
+    "BEGIN "
+    "UPDATE contact "
+    "SET "
+    "has_display_name = CASE WHEN NEW.type_id = 6 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_display_name END,"
+    "has_email = CASE WHEN NEW.type_id = 1 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_email END,"
+    "has_group = CASE WHEN NEW.type_id = 9 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_group END,"
+    "has_phone_number = CASE WHEN NEW.type_id = 5 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_phone_number END "
+    "WHERE NEW.raw_contact_id = name_raw_contact_id;"
+    "END";
+
+// contacts.db v45 of update_contact_by_update_contact_data, skipped during a bulk write
+constexpr const char *BULK_AWARE_UPDATE_CONTACT_BY_UPDATE_CONTACT_DATA =
+    "CREATE TRIGGER IF NOT EXISTS [update_contact_by_update_contact_data] AFTER UPDATE ON [contact_data] FOR EACH ROW "
+    "WHEN NOT EXISTS (SELECT 1 FROM [bulk_write_session]) "
+    "BEGIN "
+    "UPDATE contact "
+    "SET "
+    "has_display_name = CASE WHEN NEW.type_id = 6 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_display_name END,"
+    "has_email = CASE WHEN NEW.type_id = 1 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_email END,"
+    "has_group = CASE WHEN NEW.type_id = 9 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_group END,"
+    "has_phone_number = CASE WHEN NEW.type_id = 5 AND NEW.detail_info IS NOT NULL THEN 1 ELSE has_phone_number END "
+    "WHERE NEW.raw_contact_id = name_raw_contact_id;"
+    "END";
+
+// contacts.db v45 of update_contact_by_delete_contact_data, skipped during a bulk write
+constexpr const char *BULK_AWARE_UPDATE_CONTACT_BY_DELETE_CONTACT_DATA =
+    "CREATE TRIGGER IF NOT EXISTS [update_contact_by_delete_contact_data] AFTER DELETE ON [contact_data] FOR EACH ROW "
+    "WHEN NOT EXISTS (SELECT 1 FROM [bulk_write_session]) "
+    "BEGIN "
+    "UPDATE [contact] SET [has_display_name] = 0 "
+    "WHERE [OLD].[raw_contact_id] = [name_raw_contact_id] AND [OLD].[type_id] = 6; "
+    "UPDATE [contact] SET [has_email] = 0 "
+    "WHERE [OLD].[raw_contact_id] = [name_raw_contact_id] AND [OLD].[type_id] = 1; "
+    "UPDATE [contact] SET [has_group] = 0 "
+    "WHERE [OLD].[raw_contact_id] = [name_raw_contact_id] AND [OLD].[type_id] = 9; "
+    "UPDATE [contact] SET [has_phone_number] = 0 "
+    "WHERE [OLD].[raw_contact_id] = [name_raw_contact_id] AND [OLD].[type_id] = 5; "
+    "END";
+
+// 批量写期间插入的行由start_data_id识别，不逐行记录；has_*只取决于这三列，其他列的更新不需要重算
+constexpr const char *RECORD_BULK_WRITE_BY_UPDATE_CONTACT_DATA =
+    "CREATE TRIGGER IF NOT EXISTS [record_bulk_write_by_update_contact_data] "
+    "AFTER UPDATE OF [raw_contact_id], [type_id], [detail_info] ON [contact_data] "
+    "FOR EACH ROW WHEN EXISTS (SELECT 1 FROM [bulk_write_session]) "
+    "BEGIN "
+    "INSERT OR IGNORE INTO [bulk_write_raw_contact] ([raw_contact_id]) VALUES ([OLD].[raw_contact_id]); "
+    "INSERT OR IGNORE INTO [bulk_write_raw_contact] ([raw_contact_id]) VALUES ([NEW].[raw_contact_id]); "
+    "END";
+
+constexpr const char *RECORD_BULK_WRITE_BY_DELETE_CONTACT_DATA =
+    "CREATE TRIGGER IF NOT EXISTS [record_bulk_write_by_delete_contact_data] AFTER DELETE ON [contact_data] "
+    "FOR EACH ROW WHEN EXISTS (SELECT 1 FROM [bulk_write_session]) "
+    "BEGIN "
+    "INSERT OR IGNORE INTO [bulk_write_raw_contact] ([raw_contact_id]) VALUES ([OLD].[raw_contact_id]); "
+    "END";
+
+constexpr const char *BEGIN_BULK_WRITE_SESSION =
+    "INSERT OR REPLACE INTO [bulk_write_session] ([id], [start_data_id]) "
+    "SELECT 1, IFNULL(MAX([id]), 0) FROM [contact_data]";
+
+constexpr const char *RECORD_BULK_WRITE_BY_INSERTED_CONTACT_DATA =
+    "INSERT OR IGNORE INTO [bulk_write_raw_contact] ([raw_contact_id]) "
+    "SELECT [raw_contact_id] FROM [contact_data] "
+    "WHERE [id] > (SELECT [start_data_id] FROM [bulk_write_session]) AND [raw_contact_id] IS NOT NULL";
+
+// 批量写结束时按最终的contact_data一次重算涉及联系人的has_*标记，只改写有变化的contact行；
+// 与逐行触发器的来源相同，只汇总name_raw_contact_id对应raw_contact的数据，已删除的raw_contact不重算
+constexpr const char *RECOMPUTE_CONTACT_FLAGS_BY_BULK_WRITE =
+    "UPDATE [contact] SET "
+    "[has_display_name] = [flags].[has_display_name], "
+    "[has_email] = [flags].[has_email], "
+    "[has_group] = [flags].[has_group], "
+    "[has_phone_number] = [flags].[has_phone_number] "
+    "FROM (SELECT [touched].[id] AS [contact_id], "
+    "IFNULL(MAX([contact_data].[type_id] = 6 AND [contact_data].[detail_info] IS NOT NULL), 0) AS [has_display_name], "
+    "IFNULL(MAX([contact_data].[type_id] = 1 AND [contact_data].[detail_info] IS NOT NULL), 0) AS [has_email], "
+    "IFNULL(MAX([contact_data].[type_id] = 9 AND [contact_data].[detail_info] IS NOT NULL), 0) AS [has_group], "
+    "IFNULL(MAX([contact_data].[type_id] = 5 AND [contact_data].[detail_info] IS NOT NULL), 0) AS [has_phone_number] "
+    "FROM [contact] AS [touched] "
+    "LEFT JOIN [contact_data] ON [contact_data].[raw_contact_id] = [touched].[name_raw_contact_id] "
+    "WHERE [touched].[name_raw_contact_id] IN (SELECT [bulk_write_raw_contact].[raw_contact_id] "
+    "FROM [bulk_write_raw_contact] JOIN [raw_contact] "
+    "ON [raw_contact].[id] = [bulk_write_raw_contact].[raw_contact_id] WHERE [raw_contact].[is_deleted] = 0) "
+    "GROUP BY [touched].[id]) AS [flags] "
+    "WHERE [contact].[id] = [flags].[contact_id] "
+    "AND ([contact].[has_display_name] != [flags].[has_display_name] "
+    "OR [contact].[has_email] != [flags].[has_email] "
+    "OR [contact].[has_group] != [flags].[has_group] "
+    "OR [contact].[has_phone_number] != [flags].[has_phone_number])";
+
+constexpr const char *CLEAR_BULK_WRITE_RAW_CONTACT = "DELETE FROM [bulk_write_raw_contact]";
+constexpr const char *END_BULK_WRITE_SESSION = "DELETE FROM [bulk_write_session]";
+
 const std::map<std::string, const char *> CONTACT_TABLES = {
     {ContactTableName::ACCOUNT, CREATE_ACCOUNT},
     {ContactTableName::CONTACT, CREATE_CONTACT},
@@ -676,6 +802,10 @@ const std::map<std::string, const char *> CONTACT_TABLES = {
     {ContactTableName::PRIVACY_CONTACTS_BACKUP, CREATE_PRIVACY_CONTACTS_BACKUP},
     {ContactTableName::POSTER, CREATE_POSTER},
     {ContactTableName::KIT_CONTACTS_SYNC_INFO, CREATE_KIT_CONTACTS_SYNC_INFO},
+    {ContactTableName::SIDE_EFFECT_OUTBOX, CREATE_SIDE_EFFECT_OUTBOX},
+    {ContactTableName::ACCOUNT_PURGE_CURSOR, CREATE_ACCOUNT_PURGE_CURSOR},
+    {ContactTableName::BULK_WRITE_SESSION, CREATE_BULK_WRITE_SESSION},
+    {ContactTableName::BULK_WRITE_RAW_CONTACT, CREATE_BULK_WRITE_RAW_CONTACT},
 };
 
 const std::map<std::string, const char *> CONTACT_VIEWS = {
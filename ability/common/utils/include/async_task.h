@@ -28,12 +28,14 @@
 #include <thread>
 #include <vector>
 
+#include "async_task_queue.h"
 #include "common.h"
 #include "contacts_database.h"
 #include "contacts_update_helper.h"
 #include "hilog_wrapper.h"
 #include "match_candidate.h"
 #include "privacy_kit.h"
+#include "side_effect_outbox.h"
 
 namespace OHOS {
 namespace Contacts {
@@ -71,254 +73,6 @@ public:
         return count;
     }
 };
-/**
- * 阻塞队列
- * @tparam T
- */
-template<typename T>
-class BoundedBlockingQueue {
-public:
-    // make class non-copyable
-    BoundedBlockingQueue(const BoundedBlockingQueue<T> &) = delete;
-
-    BoundedBlockingQueue &operator=(const BoundedBlockingQueue<T> &) = delete;
-
-    /**
-     * 创建队列
-     * @param maxSize
-     */
-    explicit BoundedBlockingQueue<T>(size_t maxSize)
-        : mtx_(), maxSize_(maxSize)
-    {
-    }
-
-    /**
-     * 清空
-     */
-    void clear()
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        while (queue_.size() > 0)
-            queue_.pop();
-    }
-
-    /**
-     * 添加元素
-     * @param x
-     * @return
-     */
-    bool put(const T &x)
-    {
-        // 添加任务
-        std::unique_lock<std::mutex> locker(mtx_);
-        // 如果队列元素个数大于maxSize
-        // 此处应该直接返回false，打印异常
-        if (maxSize_ > 0 && queue_.size() >= maxSize_) {
-            HILOG_ERROR("blockQueue maxSize error");
-            return false;
-        }
-        queue_.push(x);
-        // 添加后，通知不为空
-        notEmptyCV_.notify_one();
-        return true;
-    }
-
-    /**
-     * 获取元素，将元素放到outRes
-     * @param outRes
-     * @return
-     */
-    bool take(T &outRes)
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        // 队列为空，阻塞等待任务
-        while (queue_.empty()) {
-            HILOG_INFO("blockQueue is empty, wait condition, ts = %{public}lld", (long long) time(NULL));
-            notEmptyCV_.wait(locker);
-        }
-        // 获取元素
-        outRes = queue_.front();
-        queue_.pop();
-        HILOG_INFO("take one element, remain: %{public}d, ts = %{public}lld",
-            static_cast<int>(queue_.size()), (long long) time(NULL));
-        return true;
-    }
-
-    /**
-     * 检查是否为空
-     * @return
-     */
-    bool empty() const
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        return queue_.empty();
-    }
-
-    /**
-     *
-     * @return
-     */
-    size_t size() const
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        return queue_.size();
-    }
-
-    size_t maxSize() const
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        return maxSize_;
-    }
-
-    void setMaxSize(size_t maxSize)
-    {
-        std::unique_lock<std::mutex> locker(mtx_);
-        maxSize_ = maxSize;
-    }
-
-private:
-    // 锁对象
-    mutable std::mutex mtx_;
-    // 条件变量
-    std::condition_variable notEmptyCV_;
-    // 队列最大长度
-    size_t maxSize_;
-    // 队列
-    std::queue<T> queue_;
-};
-
-//  任务基类
-class AsyncItem {
-public:
-    virtual ~AsyncItem()
-    {
-    }
-
-    virtual void Run() = 0;
-};
-
-// 异步任务锁
-class AsyncTaskMutex {
-public:
-    void lock()
-    {
-        while (flag.test_and_set(std::memory_order_acquire)) {
-        }
-    }
-
-    void unlock()
-    {
-        flag.clear(std::memory_order_release);
-    }
-
-private:
-    // 原子状态
-    std::atomic_flag flag = ATOMIC_FLAG_INIT;
-};
-
-// 异步任务队列，其中可以指定线程数，会启动指定数量的线程，从队列中获取任务执行
-// 无法停止
-class AsyncTaskQueue {
-public:
-    // 异步任务队列为单例
-    // single instance
-    static AsyncTaskQueue *Instance()
-    {
-        static AsyncTaskQueue obj;
-        return &obj;
-    }
-
-public:
-    // clear task
-    void Clear()
-    {
-        que.clear();
-    }
-
-    // que empty
-    bool Empty() const
-    {
-        return que.empty();
-    }
-
-    size_t Size() const
-    {
-        return que.size();
-    }
-
-    size_t GetThreads() const
-    {
-        std::lock_guard<AsyncTaskMutex> lk(mtx);
-        return threads;
-    }
-
-    // 添加任务
-    bool Push(std::unique_ptr<AsyncItem> &task)
-    {
-        HILOG_INFO("async task push task, ts = %{public}lld!", (long long) time(NULL));
-        return que.put(task.release());
-    }
-
-    // startTask
-    void Start(size_t threads = 1, size_t maxSize = 1000000)
-    {
-        std::lock_guard<AsyncTaskMutex> lk(mtx);
-        // 如果已经启动，直接返回
-        if (this->threads > 0) {
-            // 已经启动
-            return;
-        }
-        this->threads = threads;
-        this->maxSize = maxSize;
-        que.setMaxSize(maxSize);
-        // 启动指定数量的线程，执行队列中的任务
-        for (size_t i = 0; i < this->threads; i++) {
-            std::thread(std::bind(&AsyncTaskQueue::Run, this)).detach();
-        }
-    }
-
-public:
-    void Run()
-    {
-        AsyncItem *item = nullptr;
-        while (this->threads > 0) {
-            if (Pop(item)) {
-                if (item != nullptr) {
-                    item->Run();
-                    delete item;
-                    item = nullptr;
-                }
-            }
-        }
-    }
-
-private:
-    // 异步任务最大长度
-    size_t maxSize;
-    // 线程数
-    size_t threads;
-    // 异步任务锁
-    mutable AsyncTaskMutex mtx;
-    // 任务队列，阻塞队列
-    BoundedBlockingQueue<AsyncItem *> que{1000000};
-
-    AsyncTaskQueue()
-    {
-        this->maxSize = 0;
-        this->threads = 0;
-    }
-
-    /**
-     * 弹出一个任务，将任务弹给item参数
-    */
-    bool Pop(AsyncItem *&item)
-    {
-        que.take(item);
-        return true;
-    }
-};
-
-
 // 异步任务
 // impl run
 class AsyncTask : public AsyncItem {
@@ -389,6 +143,20 @@ public:
     }
 };
 
+class AsyncSideEffectOutboxTask : public AsyncItem {
+public:
+    void Run()
+    {
+        HILOG_INFO("AsyncSideEffectOutboxTask start,ts = %{public}lld", (long long) time(NULL));
+        SideEffectOutbox::GetInstance()->Drain();
+    }
+
+public:
+    AsyncSideEffectOutboxTask()
+    {
+    }
+};
+
 class AsyncDataShareProxyTask : public AsyncItem {
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper;
     DataShare::DataShareValuesBucket valuesBucket;
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACTSDATAABILITY_ASYNC_TASK_QUEUE_H
+#define CONTACTSDATAABILITY_ASYNC_TASK_QUEUE_H
+
+#include <atomic>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "bounded_blocking_queue.h"
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace Contacts {
+//  任务基类
+class AsyncItem {
+public:
+    virtual ~AsyncItem()
+    {
+    }
+
+    virtual void Run() = 0;
+};
+
+// 异步任务锁
+class AsyncTaskMutex {
+public:
+    void lock()
+    {
+        while (flag.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    void unlock()
+    {
+        flag.clear(std::memory_order_release);
+    }
+
+private:
+    // 原子状态
+    std::atomic_flag flag = ATOMIC_FLAG_INIT;
+};
+
+// 异步任务队列，其中可以指定线程数，会启动指定数量的线程，从队列中获取任务执行
+// 无法停止
+class AsyncTaskQueue {
+public:
+    // 异步任务队列为单例
+    // single instance
+    static AsyncTaskQueue *Instance()
+    {
+        static AsyncTaskQueue obj;
+        return &obj;
+    }
+
+public:
+    // clear task
+    void Clear()
+    {
+        que.clear();
+    }
+
+    // que empty
+    bool Empty() const
+    {
+        return que.empty();
+    }
+
+    size_t Size() const
+    {
+        return que.size();
+    }
+
+    size_t GetThreads() const
+    {
+        std::lock_guard<AsyncTaskMutex> lk(mtx);
+        return threads;
+    }
+
+    // 添加任务
+    bool Push(std::unique_ptr<AsyncItem> &task)
+    {
+        HILOG_INFO("async task push task, ts = %{public}lld!", (long long) time(NULL));
+        return que.put(task.release());
+    }
+
+    // startTask
+    void Start(size_t threads = 1, size_t maxSize = 1000000)
+    {
+        std::lock_guard<AsyncTaskMutex> lk(mtx);
+        // 如果已经启动，直接返回
+        if (this->threads > 0) {
+            // 已经启动
+            return;
+        }
+        this->threads = threads;
+        this->maxSize = maxSize;
+        que.setMaxSize(maxSize);
+        // 启动指定数量的线程，执行队列中的任务
+        for (size_t i = 0; i < this->threads; i++) {
+            std::thread(std::bind(&AsyncTaskQueue::Run, this)).detach();
+        }
+    }
+
+public:
+    void Run()
+    {
+        AsyncItem *item = nullptr;
+        while (this->threads > 0) {
+            if (Pop(item)) {
+                if (item != nullptr) {
+                    item->Run();
+                    delete item;
+                    item = nullptr;
+                }
+            }
+        }
+    }
+
+private:
+    // 异步任务最大长度
+    size_t maxSize;
+    // 线程数
+    size_t threads;
+    // 异步任务锁
+    mutable AsyncTaskMutex mtx;
+    // 任务队列，阻塞队列
+    BoundedBlockingQueue<AsyncItem *> que{1000000};
+
+    AsyncTaskQueue()
+    {
+        this->maxSize = 0;
+        this->threads = 0;
+    }
+
+    /**
+     * 弹出一个任务，将任务弹给item参数
+    */
+    bool Pop(AsyncItem *&item)
+    {
+        que.take(item);
+        return true;
+    }
+};
+} // namespace Contacts
+} // namespace OHOS
+
+#endif // CONTACTSDATAABILITY_ASYNC_TASK_QUEUE_H
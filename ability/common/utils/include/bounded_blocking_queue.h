@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACTSDATAABILITY_BOUNDED_BLOCKING_QUEUE_H
+#define CONTACTSDATAABILITY_BOUNDED_BLOCKING_QUEUE_H
+
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <queue>
+
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace Contacts {
+/**
+ * 阻塞队列
+ * @tparam T
+ */
+template<typename T>
+class BoundedBlockingQueue {
+public:
+    // make class non-copyable
+    BoundedBlockingQueue(const BoundedBlockingQueue<T> &) = delete;
+
+    BoundedBlockingQueue &operator=(const BoundedBlockingQueue<T> &) = delete;
+
+    /**
+     * 创建队列
+     * @param maxSize
+     */
+    explicit BoundedBlockingQueue<T>(size_t maxSize)
+        : mtx_(), maxSize_(maxSize)
+    {
+    }
+
+    /**
+     * 清空
+     */
+    void clear()
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        while (queue_.size() > 0)
+            queue_.pop();
+    }
+
+    /**
+     * 添加元素
+     * @param x
+     * @return
+     */
+    bool put(const T &x)
+    {
+        // 添加任务
+        std::unique_lock<std::mutex> locker(mtx_);
+        // 如果队列元素个数大于maxSize
+        // 此处应该直接返回false，打印异常
+        if (maxSize_ > 0 && queue_.size() >= maxSize_) {
+            HILOG_ERROR("blockQueue maxSize error");
+            return false;
+        }
+        queue_.push(x);
+        // 添加后，通知不为空
+        notEmptyCV_.notify_one();
+        return true;
+    }
+
+    /**
+     * 获取元素，将元素放到outRes
+     * @param outRes
+     * @return
+     */
+    bool take(T &outRes)
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        // 队列为空，阻塞等待任务
+        while (queue_.empty()) {
+            HILOG_INFO("blockQueue is empty, wait condition, ts = %{public}lld", (long long) time(NULL));
+            notEmptyCV_.wait(locker);
+        }
+        // 获取元素
+        outRes = queue_.front();
+        queue_.pop();
+        HILOG_INFO("take one element, remain: %{public}d, ts = %{public}lld",
+            static_cast<int>(queue_.size()), (long long) time(NULL));
+        return true;
+    }
+
+    /**
+     * 检查是否为空
+     * @return
+     */
+    bool empty() const
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        return queue_.empty();
+    }
+
+    /**
+     *
+     * @return
+     */
+    size_t size() const
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        return queue_.size();
+    }
+
+    size_t maxSize() const
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        return maxSize_;
+    }
+
+    void setMaxSize(size_t maxSize)
+    {
+        std::unique_lock<std::mutex> locker(mtx_);
+        maxSize_ = maxSize;
+    }
+
+private:
+    // 锁对象
+    mutable std::mutex mtx_;
+    // 条件变量
+    std::condition_variable notEmptyCV_;
+    // 队列最大长度
+    size_t maxSize_;
+    // 队列
+    std::queue<T> queue_;
+};
+} // namespace Contacts
+} // namespace OHOS
+
+#endif // CONTACTSDATAABILITY_BOUNDED_BLOCKING_QUEUE_H
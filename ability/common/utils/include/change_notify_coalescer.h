@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACTSDATAABILITY_CHANGE_NOTIFY_COALESCER_H
+#define CONTACTSDATAABILITY_CHANGE_NOTIFY_COALESCER_H
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "delay_async_task.h"
+
+namespace OHOS {
+namespace Contacts {
+// 变更通知合并：空闲后的第一次通知立即发布，距上次发布不足一个间隔的通知只记录最新时间，由延迟任务统一发布
+class ChangeNotifyCoalescer : public std::enable_shared_from_this<ChangeNotifyCoalescer> {
+public:
+    using PublishFunc = std::function<void(time_t)>;
+
+    ChangeNotifyCoalescer(DelayAsyncTask *delayAsyncTask, std::string taskKey, int64_t intervalMs,
+        PublishFunc publish)
+        : delayAsyncTask_(delayAsyncTask), taskKey_(std::move(taskKey)), intervalMs_(intervalMs),
+          publish_(std::move(publish)), lastPublishMs_(-intervalMs)
+    {
+    }
+
+    void Notify(time_t changeTime)
+    {
+        int64_t nowMs = SteadyNowMs();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (flushScheduled_) {
+                pendingChangeTime_ = changeTime;
+                return;
+            }
+            if (nowMs - lastPublishMs_ >= intervalMs_) {
+                lastPublishMs_ = nowMs;
+            } else {
+                pendingChangeTime_ = changeTime;
+                flushScheduled_ = true;
+                delayAsyncTask_->Start();
+                delayAsyncTask_->put(taskKey_, std::make_shared<FlushTask>(weak_from_this()));
+                return;
+            }
+        }
+        publish_(changeTime);
+    }
+
+    // 延迟任务到期时发布合并后的最新变更时间
+    void Flush()
+    {
+        time_t changeTime = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!flushScheduled_) {
+                return;
+            }
+            flushScheduled_ = false;
+            lastPublishMs_ = SteadyNowMs();
+            changeTime = pendingChangeTime_;
+        }
+        publish_(changeTime);
+    }
+
+private:
+    // 只持有弱引用，合并器先于延迟任务释放时任务不做任何事
+    class FlushTask : public AsyncItem {
+    public:
+        explicit FlushTask(std::weak_ptr<ChangeNotifyCoalescer> coalescer) : coalescer_(std::move(coalescer))
+        {
+        }
+
+        void Run()
+        {
+            std::shared_ptr<ChangeNotifyCoalescer> coalescer = coalescer_.lock();
+            if (coalescer != nullptr) {
+                coalescer->Flush();
+            }
+        }
+
+    private:
+        std::weak_ptr<ChangeNotifyCoalescer> coalescer_;
+    };
+
+    static int64_t SteadyNowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    DelayAsyncTask *delayAsyncTask_;
+    std::string taskKey_;
+    int64_t intervalMs_;
+    PublishFunc publish_;
+    std::mutex mutex_;
+    int64_t lastPublishMs_;
+    bool flushScheduled_ = false;
+    time_t pendingChangeTime_ = 0;
+};
+} // namespace Contacts
+} // namespace OHOS
+
+#endif // CONTACTSDATAABILITY_CHANGE_NOTIFY_COALESCER_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Contacts {
+/**
+ * 无锁的对数线性直方图（HDR风格），单位微秒
+ * 每个2的幂区间再等分为8个子桶，相对误差不超过12.5%；超过2^31us（约35分钟）的值记入最后一个桶
+ * Record只做几次relaxed原子操作，可在任意线程并发调用
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1ULL << SUB_BUCKET_BITS;
+    static constexpr int MAX_VALUE_BITS = 31;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_TRACKABLE_VALUE = (1ULL << MAX_VALUE_BITS) - 1;
+
+    LatencyHistogram()
+    {
+        for (auto &bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Record(uint64_t value)
+    {
+        buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+        uint64_t currentMax = max_.load(std::memory_order_relaxed);
+        while (value > currentMax &&
+            !max_.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t Count() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Max() const
+    {
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Mean() const
+    {
+        uint64_t count = Count();
+        return count == 0 ? 0 : sum_.load(std::memory_order_relaxed) / count;
+    }
+
+    /**
+     * 百分位值，返回所在桶的上界，不超过已记录的最大值
+     * @param percentile 0~100
+     * @return
+     */
+    uint64_t Percentile(double percentile) const
+    {
+        // 并发写入时各桶之和可能与count_不一致，以桶的快照为准
+        std::array<uint64_t, BUCKET_COUNT> snapshot;
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            snapshot[i] = buckets_[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(percentile / PERCENT * static_cast<double>(total) + ROUND_HALF);
+        rank = rank == 0 ? 1 : (rank > total ? total : rank);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += snapshot[i];
+            if (seen >= rank) {
+                uint64_t upper = BucketUpperBound(i);
+                uint64_t currentMax = Max();
+                return upper < currentMax ? upper : currentMax;
+            }
+        }
+        return Max();
+    }
+
+    void Reset()
+    {
+        for (auto &bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    static size_t BucketIndex(uint64_t value)
+    {
+        if (value > MAX_TRACKABLE_VALUE) {
+            return BUCKET_COUNT - 1;
+        }
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        int highestBit = HighestBit(value);
+        int shift = highestBit - SUB_BUCKET_BITS;
+        return static_cast<size_t>((shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT));
+    }
+
+    static uint64_t BucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+        uint64_t subBucket = index % SUB_BUCKET_COUNT;
+        return ((SUB_BUCKET_COUNT + subBucket) << shift) + (1ULL << shift) - 1;
+    }
+
+private:
+    static constexpr double PERCENT = 100.0;
+    static constexpr double ROUND_HALF = 0.5;
+
+    static constexpr int HIGHEST_BIT_INDEX = 63;
+
+    // value不为0
+    static int HighestBit(uint64_t value)
+    {
+        return HIGHEST_BIT_INDEX - __builtin_clzll(value);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> sum_ {0};
+    std::atomic<uint64_t> max_ {0};
+};
+} // namespace Contacts
+} // namespace OHOS
+#endif // LATENCY_HISTOGRAM_H
@@ -39,6 +39,24 @@ namespace PixelMapUtil {
      */
     std::unique_ptr<Media::PixelMap> GetPixelMapFromFile(const std::string &filePath);
 
+    /**
+     * @brief get thumbnail PixelMap from filePath, the decoder outputs the thumbnail size directly
+     *
+     * @param filePath filePath
+     * @return pixelMap
+     *
+     */
+    std::unique_ptr<Media::PixelMap> GetThumbnailPixelMapFromFile(const std::string &filePath);
+
+    /**
+     * @brief crop and scale pixelMap to the avatar size in one pass, the source is not modified
+     *
+     * @param pixelMap PixelMap
+     * @return avatar pixelMap, nullptr if failed
+     *
+     */
+    std::unique_ptr<Media::PixelMap> CreateAvatarPixelMap(const std::unique_ptr<Media::PixelMap> &pixelMap);
+
     /**
      * @brief get blob data from pixelMap
      *
@@ -31,7 +31,7 @@ public:
     ~SqlAnalyzer();
 
     bool CheckValuesBucket(const OHOS::NativeRdb::ValuesBucket &value);
-    bool FindIllegalWords(std::string sql);
+    bool FindIllegalWords(const std::string &sql);
     bool StrCheck(char &ch, std::size_t strlen, std::string sql, std::size_t &pos);
     bool CharCheck(char &ch, std::string sql, std::size_t &pos);
     bool CheckColumnExists(OHOS::NativeRdb::RdbStore &store, std::string table, std::string column);
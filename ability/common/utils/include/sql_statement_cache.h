@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SQL_STATEMENT_CACHE_H
+#define SQL_STATEMENT_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rdb_store.h"
+#include "result_set.h"
+
+namespace OHOS {
+namespace Contacts {
+// 固定文本的SQL模板，统计按模板下标存放
+enum class SqlTemplateId : int {
+    MERGE_QUERY_DATA = 0,
+    QUERY_IS_IN_BLOCK_LIST,
+    INTERCEPTION_CALL_COUNT_LIKE,
+    INTERCEPTION_CALL_COUNT_EQUAL,
+    CALLER_INFOS_BY_NUMBERS,
+    CALLER_INFO_ENHANCED,
+    QUERY_VIEW_CONTACT,
+    COUNT,
+};
+
+// 单个SQL模板的统计
+struct SqlTemplateStats {
+    // QuerySql调用次数
+    uint64_t queryCount = 0;
+    // QuerySql调用耗时，包含语句准备
+    uint64_t totalQueryUs = 0;
+    uint64_t maxQueryUs = 0;
+};
+
+/**
+ * @brief Query helper for SQL templates that only take bound parameters.
+ *
+ * Callers keep the SQL text of a template in a function-local static string, so every call passes the exact
+ * same text and the statement cache of the RdbStore connection can hand back an already prepared statement.
+ * Variable-length id or number sets are passed as one JSON array parameter and expanded with json_each,
+ * which keeps the SQL text independent of the set size. Per-template call times are kept in atomics, no
+ * lock is taken on the query path.
+ */
+class SqlStatementCache {
+public:
+    static SqlStatementCache *GetInstance();
+
+    /**
+     * @brief Query with a fixed SQL template and bound parameters, the call time is recorded in the stats
+     *
+     * @param store store to query
+     * @param id template id
+     * @param sql SQL text of the template
+     * @param args bound parameters
+     * @return std::shared_ptr<OHOS::NativeRdb::ResultSet> query result, nullptr on failure
+     */
+    std::shared_ptr<OHOS::NativeRdb::ResultSet> QuerySql(std::shared_ptr<OHOS::NativeRdb::RdbStore> store,
+        SqlTemplateId id, const std::string &sql, const std::vector<std::string> &args);
+
+    /**
+     * @brief Record the call time of a template query that was not run through QuerySql
+     *
+     * @param id template id
+     * @param elapsedUs call time in microseconds
+     */
+    void RecordQuery(SqlTemplateId id, uint64_t elapsedUs);
+
+    SqlTemplateStats GetStats(SqlTemplateId id);
+
+    // 以JSON数组形式作为一个参数传入，配合json_each使用
+    static std::string ToJsonArray(const std::set<int> &values);
+    static std::string ToJsonArray(const std::vector<std::string> &values);
+
+private:
+    struct AtomicTemplateStats {
+        std::atomic<uint64_t> queryCount{0};
+        std::atomic<uint64_t> totalQueryUs{0};
+        std::atomic<uint64_t> maxQueryUs{0};
+    };
+
+    SqlStatementCache() = default;
+    static const char *TemplateName(SqlTemplateId id);
+
+    std::array<AtomicTemplateStats, static_cast<size_t>(SqlTemplateId::COUNT)> stats_;
+};
+} // namespace Contacts
+} // namespace OHOS
+#endif // SQL_STATEMENT_CACHE_H
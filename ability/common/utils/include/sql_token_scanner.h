@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SQL_TOKEN_SCANNER_H
+#define SQL_TOKEN_SCANNER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace Contacts {
+/**
+ * SqlAnalyzer::FindIllegalWords的单遍实现
+ * 字符按预先生成的256项分类表判断，引号、括号、注释的闭合查找改为预先记录的最后出现位置，
+ * 整个字符串只扫描两遍，不拷贝字符串；不含任何触发字符的字符串（号码、中文名等）一次查表后直接返回
+ */
+class SqlTokenScanner {
+public:
+    /**
+     * 是否包含可能导致判定非法的字符：引号 ; - / [
+     * @param str
+     * @return
+     */
+    static bool HasTriggerChar(const std::string &str)
+    {
+        const CharClassTable &table = GetCharClassTable();
+        for (unsigned char ch : str) {
+            if ((table[ch] & CLASS_TRIGGER) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 判定规则与SqlAnalyzer原有的StrCheck、CharCheck逐字符扫描一致
+     * @param sql
+     * @return true 包含非法内容
+     */
+    static bool FindIllegalWords(const std::string &sql)
+    {
+        if (sql.empty() || !HasTriggerChar(sql)) {
+            return false;
+        }
+        LastPositions last = CollectLastPositions(sql);
+        const CharClassTable &table = GetCharClassTable();
+        const size_t length = sql.length();
+        size_t pos = 0;
+        while (pos < length) {
+            unsigned char ch = static_cast<unsigned char>(sql[pos]);
+            uint8_t charClass = table[ch];
+            if ((charClass & CLASS_LETTER) != 0) {
+                // 标识符后面紧跟的一个字符不参与判断
+                pos++;
+                while (pos < length && (table[static_cast<unsigned char>(sql[pos])] & CLASS_IDENTIFIER) != 0) {
+                    pos++;
+                }
+                pos++;
+                continue;
+            }
+            if ((charClass & CLASS_QUOTE) != 0) {
+                if (QuoteCheck(sql, last, ch, pos)) {
+                    return true;
+                }
+                continue;
+            }
+            if (CharCheck(sql, last, ch, pos)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr uint8_t CLASS_LETTER = 0x01;
+    static constexpr uint8_t CLASS_IDENTIFIER = 0x02;
+    static constexpr uint8_t CLASS_QUOTE = 0x04;
+    static constexpr uint8_t CLASS_TRIGGER = 0x08;
+    static constexpr size_t CHAR_COUNT = 256;
+    static constexpr size_t STEP_TWO = 2;
+
+    using CharClassTable = std::array<uint8_t, CHAR_COUNT>;
+
+    // 各闭合字符最后一次出现的位置，find(ch, pos)不为npos等价于最后位置>=pos
+    struct LastPositions {
+        std::array<size_t, CHAR_COUNT> charPos;
+        size_t commentEndPos = std::string::npos;
+    };
+
+    static const CharClassTable &GetCharClassTable()
+    {
+        static const CharClassTable table = BuildCharClassTable();
+        return table;
+    }
+
+    static CharClassTable BuildCharClassTable()
+    {
+        CharClassTable table{};
+        for (size_t ch = 0; ch < CHAR_COUNT; ch++) {
+            bool isLetter = (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+            if (isLetter) {
+                table[ch] |= CLASS_LETTER | CLASS_IDENTIFIER;
+            }
+            if (ch >= '0' && ch <= '9') {
+                table[ch] |= CLASS_IDENTIFIER;
+            }
+        }
+        for (unsigned char ch : std::string("'\"`")) {
+            table[ch] |= CLASS_QUOTE | CLASS_TRIGGER;
+        }
+        for (unsigned char ch : std::string(";-/[")) {
+            table[ch] |= CLASS_TRIGGER;
+        }
+        return table;
+    }
+
+    static LastPositions CollectLastPositions(const std::string &sql)
+    {
+        LastPositions last;
+        last.charPos.fill(std::string::npos);
+        for (size_t i = 0; i < sql.length(); i++) {
+            unsigned char ch = static_cast<unsigned char>(sql[i]);
+            last.charPos[ch] = i;
+            if (ch == '/' && i > 0 && sql[i - 1] == '*') {
+                last.commentEndPos = i - 1;
+            }
+        }
+        return last;
+    }
+
+    static bool ExistsFrom(size_t lastPos, size_t pos)
+    {
+        return lastPos != std::string::npos && lastPos >= pos;
+    }
+
+    static char PickChar(const std::string &sql, size_t index)
+    {
+        return index < sql.length() ? sql[index] : '\0';
+    }
+
+    static bool QuoteCheck(const std::string &sql, const LastPositions &last, unsigned char ch, size_t &pos)
+    {
+        pos++;
+        while (pos < sql.length()) {
+            if (!ExistsFrom(last.charPos[ch], pos)) {
+                return true;
+            }
+            if (static_cast<unsigned char>(PickChar(sql, pos + 1)) != ch) {
+                break;
+            }
+            pos += STEP_TWO;
+        }
+        return false;
+    }
+
+    static bool CharCheck(const std::string &sql, const LastPositions &last, unsigned char ch, size_t &pos)
+    {
+        if (ch == '[') {
+            pos++;
+            if (!ExistsFrom(last.charPos[static_cast<unsigned char>(']')], pos)) {
+                return true;
+            }
+            pos++;
+        }
+        if (ch == '-' && PickChar(sql, pos + 1) == '-') {
+            pos += STEP_TWO;
+            if (!ExistsFrom(last.charPos[static_cast<unsigned char>('\n')], pos)) {
+                return true;
+            }
+            pos++;
+        }
+        if (ch == '/' && PickChar(sql, pos + 1) == '*') {
+            pos += STEP_TWO;
+            if (!ExistsFrom(last.commentEndPos, pos)) {
+                return true;
+            }
+            pos += STEP_TWO;
+        }
+        if (ch == ';') {
+            return true;
+        }
+        pos++;
+        return false;
+    }
+};
+} // namespace Contacts
+} // namespace OHOS
+#endif // SQL_TOKEN_SCANNER_H
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACTSDATAABILITY_TIMER_WHEEL_H
+#define CONTACTSDATAABILITY_TIMER_WHEEL_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "async_task_queue.h"
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace Contacts {
+// 时间源，单元测试可以注入手动推进的时钟
+class TimerClock {
+public:
+    virtual ~TimerClock()
+    {
+    }
+
+    virtual int64_t NowMs() = 0;
+};
+
+class SteadyTimerClock : public TimerClock {
+public:
+    int64_t NowMs() override
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+// 相同key重复提交时的合并方式
+enum class TimerCoalescePolicy : int {
+    // 替换任务，保持原来的到期时间，延迟期间最多执行一次
+    REPLACE = 0,
+    // 替换任务，并从本次提交重新计算到期时间
+    EXTEND = 1,
+};
+
+/**
+ * 分层时间轮，一个定时线程驱动所有延迟任务
+ * 每层64个槽，第0层一个槽对应一个tick，上层的槽到期时把任务下放到下层
+ * 添加、取消都是O(1)，超出三层范围的任务放到溢出链表，最高层转完一圈时重新分配
+ */
+class TimerWheel {
+public:
+    // 默认tick长度
+    static constexpr int64_t DEFAULT_TICK_MS = 100;
+    static constexpr uint64_t INVALID_TIMER_ID = 0;
+
+    explicit TimerWheel(std::shared_ptr<TimerClock> clock = std::make_shared<SteadyTimerClock>(),
+        int64_t tickMs = DEFAULT_TICK_MS)
+        : clock_(clock), tickMs_(tickMs > 0 ? tickMs : DEFAULT_TICK_MS)
+    {
+        startMs_ = clock_->NowMs();
+    }
+
+    TimerWheel(const TimerWheel &) = delete;
+
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    ~TimerWheel()
+    {
+        Shutdown(false);
+    }
+
+    /**
+     * 添加延迟任务
+     * @param task 任务
+     * @param delayMs 延迟时间，按tick向上取整
+     * @return 定时器id，可用于取消
+     */
+    uint64_t Schedule(std::shared_ptr<AsyncItem> task, int64_t delayMs)
+    {
+        if (task == nullptr) {
+            return INVALID_TIMER_ID;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return INVALID_TIMER_ID;
+        }
+        uint64_t id = AddEntry("", task, delayMs);
+        cv_.notify_one();
+        return id;
+    }
+
+    /**
+     * 添加带key的延迟任务，key相同的任务还未执行时按policy合并，只执行一次
+     * @param key 去重key
+     * @param task 任务
+     * @param delayMs 延迟时间
+     * @param policy 合并方式
+     * @return 定时器id，合并时返回已有任务的id
+     */
+    uint64_t Schedule(const std::string &key, std::shared_ptr<AsyncItem> task, int64_t delayMs,
+        TimerCoalescePolicy policy = TimerCoalescePolicy::REPLACE)
+    {
+        if (task == nullptr) {
+            return INVALID_TIMER_ID;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return INVALID_TIMER_ID;
+        }
+        auto keyIt = keyIndex_.find(key);
+        if (keyIt == keyIndex_.end()) {
+            uint64_t id = AddEntry(key, task, delayMs);
+            cv_.notify_one();
+            return id;
+        }
+        Entry &entry = entries_[keyIt->second];
+        entry.task = task;
+        if (policy == TimerCoalescePolicy::EXTEND) {
+            Unlink(entry);
+            entry.expireTick = ExpireTick(delayMs);
+            Link(entry, nowTick_ + 1);
+        }
+        return entry.id;
+    }
+
+    bool Cancel(uint64_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return RemoveEntry(id);
+    }
+
+    bool Cancel(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto keyIt = keyIndex_.find(key);
+        if (keyIt == keyIndex_.end()) {
+            return false;
+        }
+        return RemoveEntry(keyIt->second);
+    }
+
+    size_t Pending()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    /**
+     * 推进时间轮到时钟当前时间，在调用线程执行所有到期任务
+     * 定时线程循环调用；单元测试推进注入的时钟后直接调用
+     * @return 执行的任务数
+     */
+    size_t Advance()
+    {
+        std::vector<std::shared_ptr<AsyncItem>> dueTasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t targetTick = CurrentTick();
+            while (nowTick_ < targetTick && !entries_.empty()) {
+                Tick(dueTasks);
+            }
+            // 没有任务时直接对齐到当前tick
+            if (nowTick_ < targetTick) {
+                nowTick_ = targetTick;
+            }
+        }
+        for (auto &task : dueTasks) {
+            task->Run();
+        }
+        return dueTasks.size();
+    }
+
+    // 启动定时线程，重复调用只启动一次
+    void Start()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (started_ || stopped_) {
+            return;
+        }
+        started_ = true;
+        thread_ = std::thread([this]() { this->Run(); });
+    }
+
+    /**
+     * 停止定时线程，之后提交的任务会被拒绝
+     * @param drain true时立即按到期顺序执行所有未到期任务，false时丢弃
+     * @return 执行的任务数
+     */
+    size_t Shutdown(bool drain)
+    {
+        std::vector<std::shared_ptr<AsyncItem>> pendingTasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopped_) {
+                return 0;
+            }
+            stopped_ = true;
+            cv_.notify_all();
+        }
+        if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+            thread_.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (drain && !entries_.empty()) {
+                Tick(pendingTasks);
+            }
+            ClearEntries();
+        }
+        HILOG_INFO("TimerWheel shutdown, drain = %{public}d, size = %{public}zu", drain, pendingTasks.size());
+        for (auto &task : pendingTasks) {
+            task->Run();
+        }
+        return pendingTasks.size();
+    }
+
+private:
+    static constexpr uint64_t SLOT_BITS = 6;
+    static constexpr uint64_t SLOT_COUNT = 1 << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr size_t LEVEL_COUNT = 3;
+
+    struct Entry {
+        uint64_t id = INVALID_TIMER_ID;
+        std::string key;
+        std::shared_ptr<AsyncItem> task;
+        uint64_t expireTick = 0;
+        std::list<uint64_t> *slot = nullptr;
+        std::list<uint64_t>::iterator position;
+    };
+
+    std::shared_ptr<TimerClock> clock_;
+    int64_t tickMs_;
+    int64_t startMs_ = 0;
+    // 已处理到的tick
+    uint64_t nowTick_ = 0;
+    uint64_t nextId_ = 1;
+    std::array<std::array<std::list<uint64_t>, SLOT_COUNT>, LEVEL_COUNT> wheels_;
+    std::list<uint64_t> overflow_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::unordered_map<std::string, uint64_t> keyIndex_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool started_ = false;
+    bool stopped_ = false;
+
+    // 时钟当前时间对应的tick，向下取整
+    uint64_t CurrentTick()
+    {
+        int64_t elapsed = clock_->NowMs() - startMs_;
+        return elapsed > 0 ? static_cast<uint64_t>(elapsed / tickMs_) : 0;
+    }
+
+    uint64_t ExpireTick(int64_t delayMs)
+    {
+        int64_t delay = delayMs > 0 ? delayMs : 0;
+        int64_t expireMs = clock_->NowMs() - startMs_ + delay;
+        // 向上取整，保证不会早于延迟时间执行
+        uint64_t expireTick = static_cast<uint64_t>((expireMs + tickMs_ - 1) / tickMs_);
+        return expireTick > nowTick_ ? expireTick : nowTick_ + 1;
+    }
+
+    uint64_t AddEntry(const std::string &key, std::shared_ptr<AsyncItem> &task, int64_t delayMs)
+    {
+        // 空闲时定时线程不推进时间轮，先对齐到当前tick，避免按过期的nowTick_分配槽位后逐tick追赶
+        if (entries_.empty()) {
+            uint64_t currentTick = CurrentTick();
+            if (nowTick_ < currentTick) {
+                nowTick_ = currentTick;
+            }
+        }
+        uint64_t id = nextId_++;
+        Entry &entry = entries_[id];
+        entry.id = id;
+        entry.key = key;
+        entry.task = task;
+        entry.expireTick = ExpireTick(delayMs);
+        if (!key.empty()) {
+            keyIndex_[key] = id;
+        }
+        Link(entry, nowTick_ + 1);
+        return id;
+    }
+
+    bool RemoveEntry(uint64_t id)
+    {
+        auto it = entries_.find(id);
+        if (it == entries_.end()) {
+            return false;
+        }
+        Unlink(it->second);
+        if (!it->second.key.empty()) {
+            keyIndex_.erase(it->second.key);
+        }
+        entries_.erase(it);
+        return true;
+    }
+
+    void ClearEntries()
+    {
+        for (auto &level : wheels_) {
+            for (auto &slot : level) {
+                slot.clear();
+            }
+        }
+        overflow_.clear();
+        entries_.clear();
+        keyIndex_.clear();
+    }
+
+    /**
+     * 按到期tick所在的区间放入对应层的槽
+     * @param entry 任务
+     * @param baseTick 下一个要处理的tick
+     */
+    void Link(Entry &entry, uint64_t baseTick)
+    {
+        if (entry.expireTick < baseTick) {
+            entry.expireTick = baseTick;
+        }
+        std::list<uint64_t> *slot = &overflow_;
+        for (size_t level = 0; level < LEVEL_COUNT; level++) {
+            uint64_t shift = SLOT_BITS * (level + 1);
+            // 与baseTick处在上一层的同一个槽内，就放在本层
+            if ((entry.expireTick >> shift) == (baseTick >> shift)) {
+                slot = &wheels_[level][(entry.expireTick >> (SLOT_BITS * level)) & SLOT_MASK];
+                break;
+            }
+        }
+        entry.slot = slot;
+        entry.position = slot->insert(slot->end(), entry.id);
+    }
+
+    void Unlink(Entry &entry)
+    {
+        if (entry.slot != nullptr) {
+            entry.slot->erase(entry.position);
+            entry.slot = nullptr;
+        }
+    }
+
+    // 把上层一个槽中的任务重新分配到下层
+    void Cascade(std::list<uint64_t> &slot, uint64_t baseTick)
+    {
+        std::list<uint64_t> ids;
+        ids.swap(slot);
+        for (uint64_t id : ids) {
+            Entry &entry = entries_[id];
+            entry.slot = nullptr;
+            Link(entry, baseTick);
+        }
+    }
+
+    // 处理下一个tick，到期任务移出时间轮放入dueTasks
+    void Tick(std::vector<std::shared_ptr<AsyncItem>> &dueTasks)
+    {
+        uint64_t tick = nowTick_ + 1;
+        if ((tick & SLOT_MASK) == 0) {
+            for (size_t level = LEVEL_COUNT; level > 0; level--) {
+                uint64_t lowerBits = SLOT_BITS * level;
+                if ((tick & ((static_cast<uint64_t>(1) << lowerBits) - 1)) != 0) {
+                    continue;
+                }
+                if (level == LEVEL_COUNT) {
+                    Cascade(overflow_, tick);
+                } else {
+                    Cascade(wheels_[level][(tick >> lowerBits) & SLOT_MASK], tick);
+                }
+            }
+        }
+        std::list<uint64_t> ids;
+        ids.swap(wheels_[0][tick & SLOT_MASK]);
+        for (uint64_t id : ids) {
+            auto it = entries_.find(id);
+            if (it == entries_.end()) {
+                continue;
+            }
+            dueTasks.push_back(it->second.task);
+            if (!it->second.key.empty()) {
+                keyIndex_.erase(it->second.key);
+            }
+            entries_.erase(it);
+        }
+        nowTick_ = tick;
+    }
+
+    void Run()
+    {
+        HILOG_INFO("TimerWheel thread start, ts = %{public}lld", (long long) time(NULL));
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (stopped_) {
+                    break;
+                }
+                // 没有任务时休眠，添加任务后被唤醒
+                if (entries_.empty()) {
+                    cv_.wait(lock, [this] { return stopped_ || !entries_.empty(); });
+                } else {
+                    cv_.wait_for(lock, std::chrono::milliseconds(tickMs_));
+                }
+                if (stopped_) {
+                    break;
+                }
+            }
+            Advance();
+        }
+    }
+};
+} // namespace Contacts
+} // namespace OHOS
+
+#endif // CONTACTSDATAABILITY_TIMER_WHEEL_H
@@ -16,14 +16,46 @@
 #ifndef URI_UTILS_H
 #define URI_UTILS_H
 
+#include "common.h"
 #include "uri.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace OHOS {
 namespace Contacts {
+/**
+ * 一次解析uri得到的路由码与查询参数，字符串字段均指向被解析的uri字符串，使用期间该字符串须保持有效
+ */
+struct UriInfo {
+    int code = OPERATION_ERROR;
+    std::string_view path;
+    std::string_view isSyncFromCloud;
+    std::string_view isFromBatch;
+    std::string_view handleType;
+};
+
+/**
+ * 由各ability的uriValueMap_生成的完美哈希路由表：构造时选取使所有路径互不冲突的种子，查找只需一次哈希和一次比较
+ */
+class UriRouteTable {
+public:
+    explicit UriRouteTable(const std::map<std::string, int> &routes);
+    int Find(std::string_view path) const;
+
+private:
+    static uint32_t Hash(std::string_view key, uint32_t seed);
+    bool TryBuild(const std::map<std::string, int> &routes, size_t capacity, uint32_t seed);
+
+    std::vector<std::pair<std::string, int>> slots_;
+    std::vector<bool> used_;
+    uint32_t seed_ = 0;
+    size_t mask_ = 0;
+};
+
 class UriUtils {
 public:
     UriUtils();
@@ -32,6 +64,8 @@ public:
     std::map<std::string, std::string> getQueryParameter(OHOS::Uri &uri);
     int UriParse(OHOS::Uri &uri, std::map<std::string, int> &keyMap);
     void GetFileTypeAndFileName(const OHOS::Uri &uri, std::string &openFileType, std::string &fileName);
+    UriInfo ParseUri(std::string_view uri, const UriRouteTable &routes);
+    std::string_view GetPathSegment(std::string_view path, size_t index);
 };
 } // namespace Contacts
 } // namespace OHOS
@@ -17,6 +17,7 @@
 
 #include "contacts_columns.h"
 #include "contacts_database.h"
+#include "sql_statement_cache.h"
 
 namespace OHOS {
 namespace Contacts {
@@ -72,25 +73,15 @@ std::set<std::string> MergeUtils::QueryDataExecute(
     if (size < 1) {
         return result;
     }
-    std::string query = "SELECT ";
-    query.append(ContactDataColumns::DETAIL_INFO)
-        .append(" FROM ")
-        .append(ContactTableName::CONTACT_DATA)
-        .append(" WHERE ");
-    for (auto rawId = rawIds.begin(); rawId != rawIds.end(); ++rawId) {
-        query.append(ContactDataColumns::RAW_CONTACT_ID)
-            .append(" = ")
-            .append(std::to_string(*rawId))
-            .append(" AND ")
-            .append(ContactDataColumns::TYPE_ID)
-            .append(" = ? ");
-        if (*rawId != *rawIds.rbegin()) {
-            query.append(" OR ");
-        }
-    }
+    // raw_contact_id集合作为一个JSON数组参数，代替按个数拼接的OR条件
+    static const std::string querySql = std::string("SELECT ") + ContactDataColumns::DETAIL_INFO + " FROM " +
+        ContactTableName::CONTACT_DATA + " WHERE " + ContactDataColumns::RAW_CONTACT_ID +
+        " IN (SELECT value FROM json_each(?)) AND " + ContactDataColumns::TYPE_ID + " = ?";
     std::vector<std::string> selectionArgs;
+    selectionArgs.push_back(SqlStatementCache::ToJsonArray(rawIds));
     selectionArgs.push_back(std::to_string(typeId));
-    auto resultSet = store->QuerySql(query, selectionArgs);
+    auto resultSet =
+        SqlStatementCache::GetInstance()->QuerySql(store, SqlTemplateId::MERGE_QUERY_DATA, querySql, selectionArgs);
     if (resultSet == nullptr) {
         HILOG_ERROR("QueryDataExecute QuerySqlResult is null");
         return result;
@@ -14,6 +14,9 @@
  */
 
 #include "pixel_map_util.h"
+
+#include <sys/stat.h>
+
 #include "image_packer.h"
 #include "hilog_wrapper.h"
 #include "image_source.h"
@@ -35,6 +38,8 @@ constexpr int32_t MIN_RESOLUTION = 409600;
 constexpr int32_t MIN_TUMBNAIL_FILE_SIZE = 1024 * 1024;
 constexpr float SMALL_AVATAR_SIZE = 280;
 const std::string IMAGE_FORMAT = "image/jpeg";
+constexpr int32_t DEFAULT_IMAGE_SIDE = 100;
+constexpr int32_t HALF = 2;
 
 uint32_t SavePixelMapToFile(const std::unique_ptr<PixelMap>& pixelMap, const int fileDescriptor)
 {
@@ -87,15 +92,78 @@ std::unique_ptr<PixelMap> GetPixelMapFromFile(const std::string &filePath)
     return pixelMap;
 }
 
-uint32_t GetArrayBufferFromPixelMap(const std::unique_ptr<PixelMap> &pixelMap, std::vector<uint8_t> &data)
+std::unique_ptr<PixelMap> GetThumbnailPixelMapFromFile(const std::string &filePath)
+{
+    uint32_t errorCode = 0;
+    SourceOptions opts;
+    std::unique_ptr<ImageSource> imageSource = ImageSource::CreateImageSource(filePath, opts, errorCode);
+    if (imageSource == nullptr) {
+        HILOG_ERROR("PixelMapUtil GetThumbnailPixelMapFromFile CreateImageSource Failed %{public}u", errorCode);
+        return nullptr;
+    }
+    int32_t value = 0;
+    imageSource->GetImagePropertyInt(0, "Orientation", value);
+    DecodeOptions decodeOpts;
+    // 大于1M图片按缩略图规格解码，解码器直接输出目标尺寸，不再先解出原图再缩放
+    struct stat fileStat;
+    ImageInfo srcInfo;
+    if (stat(filePath.c_str(), &fileStat) == 0 && fileStat.st_size > MIN_TUMBNAIL_FILE_SIZE &&
+        imageSource->GetImageInfo(0, srcInfo) == 0 && srcInfo.size.height > 0 && srcInfo.size.width > 0) {
+        float scale = GetThumbnailScale(srcInfo.size.height, srcInfo.size.width);
+        if (scale < 1.0f) {
+            decodeOpts.desiredSize.width = static_cast<int32_t>(srcInfo.size.width * scale);
+            decodeOpts.desiredSize.height = static_cast<int32_t>(srcInfo.size.height * scale);
+        }
+        HILOG_INFO("GetThumbnailPixelMapFromFile height %{public}d width %{public}d scale %{public}f",
+            srcInfo.size.height, srcInfo.size.width, scale);
+    }
+    std::unique_ptr<PixelMap> pixelMap = imageSource->CreatePixelMap(decodeOpts, errorCode);
+    if (pixelMap == nullptr) {
+        HILOG_ERROR("PixelMapUtil GetThumbnailPixelMapFromFile CreatePixelMap Failed %{public}u", errorCode);
+        return nullptr;
+    }
+    pixelMap->rotate(value);
+    return pixelMap;
+}
+
+std::unique_ptr<PixelMap> CreateAvatarPixelMap(const std::unique_ptr<PixelMap> &pixelMap)
 {
-    CropPixelMap(pixelMap);
     ImageInfo info;
     pixelMap->GetImageInfo(info);
-    int32_t height = (info.size.height != 0) ? info.size.height : 100;
-    int32_t width = (info.size.width != 0) ? info.size.width : 100;
+    int32_t height = (info.size.height != 0) ? info.size.height : DEFAULT_IMAGE_SIDE;
+    int32_t width = (info.size.width != 0) ? info.size.width : DEFAULT_IMAGE_SIDE;
+    int32_t shortSide = height > width ? width : height;
+    int32_t cropY = (height - width) / HALF;
+    cropY = cropY < 0 ? 0 : cropY;
+    // 与CropPixelMap的裁剪区域一致，裁剪和缩放在一次拷贝中完成
+    Rect rect { 0, cropY, shortSide, shortSide };
+    InitializationOptions opts;
+    opts.size.width = static_cast<int32_t>(SMALL_AVATAR_SIZE);
+    opts.size.height = static_cast<int32_t>(SMALL_AVATAR_SIZE);
+    opts.pixelFormat = info.pixelFormat;
+    opts.alphaType = info.alphaType;
+    opts.scaleMode = ScaleMode::FIT_TARGET_SIZE;
+    opts.editable = true;
+    std::unique_ptr<PixelMap> avatar = PixelMap::Create(*pixelMap, rect, opts);
+    if (avatar == nullptr) {
+        HILOG_ERROR("PixelMapUtil CreateAvatarPixelMap failed, height %{public}d width %{public}d", height, width);
+    }
+    return avatar;
+}
+
+uint32_t GetArrayBufferFromPixelMap(const std::unique_ptr<PixelMap> &pixelMap, std::vector<uint8_t> &data)
+{
+    std::unique_ptr<PixelMap> avatar = CreateAvatarPixelMap(pixelMap);
+    const std::unique_ptr<PixelMap> &target = avatar != nullptr ? avatar : pixelMap;
+    if (avatar == nullptr) {
+        CropPixelMap(pixelMap);
+    }
+    ImageInfo info;
+    target->GetImageInfo(info);
+    int32_t height = (info.size.height != 0) ? info.size.height : DEFAULT_IMAGE_SIDE;
+    int32_t width = (info.size.width != 0) ? info.size.width : DEFAULT_IMAGE_SIDE;
     HILOG_INFO("GetArrayBufferFromPixelMap height %{public}d width %{public}d", height, width);
-    data.resize(pixelMap->GetByteCount());
+    data.resize(target->GetByteCount());
     ImagePacker imagePacker;
     PackOption option = {
         .format = IMAGE_FORMAT,
@@ -108,13 +176,17 @@ uint32_t GetArrayBufferFromPixelMap(const std::unique_ptr<PixelMap> &pixelMap, s
         HILOG_ERROR("GetArrayBufferFromPixelMap Failed to StartPacking %{public}d", err);
         return err;
     }
-    err = imagePacker.AddImage(*pixelMap);
+    err = imagePacker.AddImage(*target);
     if (err != 0) {
         HILOG_ERROR("GetArrayBufferFromPixelMap Failed to AddPicture %{public}d", err);
         return err;
     }
     int64_t packedSize = 0;
     imagePacker.FinalizePacking(packedSize);
+    // 缓冲区按未压缩大小申请，只保留编码后的jpeg数据
+    if (packedSize > 0 && static_cast<size_t>(packedSize) < data.size()) {
+        data.resize(static_cast<size_t>(packedSize));
+    }
     HILOG_DEBUG("PixelMapUtil GetArrayBufferFromPixelMap success");
     return 0;
 }
@@ -15,6 +15,7 @@
 #include "sql_analyzer.h"
 
 #include "hilog_wrapper.h"
+#include "sql_token_scanner.h"
 
 namespace OHOS {
 namespace Contacts {
@@ -33,18 +34,22 @@ bool SqlAnalyzer::CheckValuesBucket(const OHOS::NativeRdb::ValuesBucket &value)
     std::map<std::string, NativeRdb::ValueObject> valuesMap;
     value.GetAll(valuesMap);
     for (auto it = valuesMap.begin(); it != valuesMap.end(); ++it) {
-        std::string key = it->first;
-        bool isKey = FindIllegalWords(key);
+        const std::string &key = it->first;
+        bool isKey = SqlTokenScanner::FindIllegalWords(key);
         if (isKey) {
             HILOG_ERROR("SqlAnalyzer CheckValuesBucket key is %{public}s error", key.c_str());
             return false;
         }
-        NativeRdb::ValueObject value = it->second;
-        if (value.GetType() == NativeRdb::ValueObjectType::TYPE_STRING) {
+        const NativeRdb::ValueObject &valueObject = it->second;
+        if (valueObject.GetType() == NativeRdb::ValueObjectType::TYPE_STRING) {
             std::string str;
-            value.GetString(str);
+            valueObject.GetString(str);
+            // 号码、中文名等不含触发字符的值不需要转义和扫描
+            if (!SqlTokenScanner::HasTriggerChar(str)) {
+                continue;
+            }
             str = ParseSpecial(str);
-            bool isValue = FindIllegalWords(str);
+            bool isValue = SqlTokenScanner::FindIllegalWords(str);
             if (isValue) {
                 HILOG_ERROR("SqlAnalyzer CheckValuesBucket value is %{public}s error", str.c_str());
                 return false;
@@ -105,39 +110,11 @@ bool SqlAnalyzer::StrCheck(char &ch, std::size_t strlen, std::string sql, std::s
     return false;
 }
 
-bool SqlAnalyzer::FindIllegalWords(std::string sql)
+bool SqlAnalyzer::FindIllegalWords(const std::string &sql)
 {
-    if (sql.empty()) {
-        return false;
-    }
-    std::size_t pos = 0;
-    std::size_t strlen = sql.length();
-    while (pos < strlen) {
-        char ch = PickChar(sql, pos);
-        if (IsLetter(ch)) {
-            std::size_t start = pos;
-            pos++;
-            while (IsLetterNumber(PickChar(sql, pos))) {
-                pos++;
-            }
-            std::size_t count = pos - start + 1;
-            sql.substr(start, count);
-        }
-        if (IsInStr(ch, "'\"`") == 0) {
-            if (StrCheck(ch, strlen, sql, pos)) {
-                return true;
-            } else {
-                continue;
-            }
-        }
-        if (CharCheck(ch, sql, pos)) {
-            return true;
-        } else {
-            continue;
-        }
-    }
-    return false;
+    return SqlTokenScanner::FindIllegalWords(sql);
 }
+
 bool SqlAnalyzer::CheckColumnExists(OHOS::NativeRdb::RdbStore &store, std::string table, std::string column)
 {
     std::string querySql = "SELECT * FROM " + table + " LIMIT 0";
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sql_statement_cache.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace Contacts {
+namespace {
+// 每个模板每执行多少次打印一次统计
+constexpr uint64_t STATS_LOG_INTERVAL = 500;
+constexpr int UNICODE_ESCAPE_LENGTH = 7;
+}
+
+SqlStatementCache *SqlStatementCache::GetInstance()
+{
+    static SqlStatementCache instance;
+    return &instance;
+}
+
+const char *SqlStatementCache::TemplateName(SqlTemplateId id)
+{
+    switch (id) {
+        case SqlTemplateId::MERGE_QUERY_DATA:
+            return "MergeQueryDataExecute";
+        case SqlTemplateId::QUERY_IS_IN_BLOCK_LIST:
+            return "QueryIsInBlockList";
+        case SqlTemplateId::INTERCEPTION_CALL_COUNT_LIKE:
+            return "QueryInterceptionCallCountLike";
+        case SqlTemplateId::INTERCEPTION_CALL_COUNT_EQUAL:
+            return "QueryInterceptionCallCountEqual";
+        case SqlTemplateId::CALLER_INFOS_BY_NUMBERS:
+            return "QueryCallerInfosByNumbers";
+        case SqlTemplateId::CALLER_INFO_ENHANCED:
+            return "GetContactInfoEnhanced";
+        case SqlTemplateId::QUERY_VIEW_CONTACT:
+            return "QueryViewContact";
+        default:
+            return "Unknown";
+    }
+}
+
+std::shared_ptr<OHOS::NativeRdb::ResultSet> SqlStatementCache::QuerySql(
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store, SqlTemplateId id, const std::string &sql,
+    const std::vector<std::string> &args)
+{
+    if (store == nullptr) {
+        HILOG_ERROR("SqlStatementCache QuerySql %{public}s store is nullptr", TemplateName(id));
+        return nullptr;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto resultSet = store->QuerySql(sql, args);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    RecordQuery(id, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    if (resultSet == nullptr) {
+        HILOG_ERROR("SqlStatementCache QuerySql %{public}s result is nullptr", TemplateName(id));
+    }
+    return resultSet;
+}
+
+void SqlStatementCache::RecordQuery(SqlTemplateId id, uint64_t elapsedUs)
+{
+    size_t index = static_cast<size_t>(id);
+    if (index >= stats_.size()) {
+        return;
+    }
+    AtomicTemplateStats &stats = stats_[index];
+    uint64_t queryCount = stats.queryCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t totalQueryUs = stats.totalQueryUs.fetch_add(elapsedUs, std::memory_order_relaxed) + elapsedUs;
+    uint64_t maxQueryUs = stats.maxQueryUs.load(std::memory_order_relaxed);
+    while (elapsedUs > maxQueryUs &&
+        !stats.maxQueryUs.compare_exchange_weak(maxQueryUs, elapsedUs, std::memory_order_relaxed)) {
+    }
+    if (queryCount % STATS_LOG_INTERVAL != 0) {
+        return;
+    }
+    // 计数之间没有同步，打印的平均值只是近似值
+    HILOG_INFO("SqlStatementCache %{public}s queries %{public}llu, avg query %{public}lluus, "
+        "max query %{public}lluus", TemplateName(id), (unsigned long long) queryCount,
+        (unsigned long long) (totalQueryUs / queryCount),
+        (unsigned long long) stats.maxQueryUs.load(std::memory_order_relaxed));
+}
+
+SqlTemplateStats SqlStatementCache::GetStats(SqlTemplateId id)
+{
+    SqlTemplateStats snapshot;
+    size_t index = static_cast<size_t>(id);
+    if (index >= stats_.size()) {
+        return snapshot;
+    }
+    snapshot.queryCount = stats_[index].queryCount.load(std::memory_order_relaxed);
+    snapshot.totalQueryUs = stats_[index].totalQueryUs.load(std::memory_order_relaxed);
+    snapshot.maxQueryUs = stats_[index].maxQueryUs.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+std::string SqlStatementCache::ToJsonArray(const std::set<int> &values)
+{
+    std::string json = "[";
+    for (auto it = values.begin(); it != values.end(); ++it) {
+        if (it != values.begin()) {
+            json.append(",");
+        }
+        json.append(std::to_string(*it));
+    }
+    json.append("]");
+    return json;
+}
+
+std::string SqlStatementCache::ToJsonArray(const std::vector<std::string> &values)
+{
+    std::string json = "[";
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i != 0) {
+            json.append(",");
+        }
+        json.append("\"");
+        for (unsigned char ch : values[i]) {
+            if (ch == '"' || ch == '\\') {
+                json.push_back('\\');
+                json.push_back(static_cast<char>(ch));
+            } else if (ch < 0x20) {
+                char escaped[UNICODE_ESCAPE_LENGTH] = {0};
+                snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                json.append(escaped);
+            } else {
+                json.push_back(static_cast<char>(ch));
+            }
+        }
+        json.append("\"");
+    }
+    json.append("]");
+    return json;
+}
+} // namespace Contacts
+} // namespace OHOS
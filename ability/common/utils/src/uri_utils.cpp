@@ -19,6 +19,123 @@
 
 namespace OHOS {
 namespace Contacts {
+namespace {
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+constexpr uint32_t FNV_PRIME = 16777619U;
+constexpr uint32_t HASH_MIX_SHIFT = 16;
+constexpr uint32_t ROUTE_SEED_ATTEMPTS = 4096;
+constexpr size_t ROUTE_MAX_CAPACITY = 1 << 16;
+constexpr std::string_view PARAM_IS_SYNC_FROM_CLOUD = "isSyncFromCloud";
+constexpr std::string_view PARAM_IS_FROM_BATCH = "isFromBatch";
+constexpr std::string_view PARAM_HANDLE_TYPE = "handleType";
+
+// 与getQueryParameter一致：按'='切分并跳过空串，恰好切出键和值两段才是有效参数
+bool SplitQueryParam(std::string_view param, std::string_view &key, std::string_view &value)
+{
+    std::string_view parts[REQUEST_PARAMS_NUM];
+    int count = 0;
+    size_t start = param.find_first_not_of('=');
+    while (start != std::string_view::npos) {
+        if (count == REQUEST_PARAMS_NUM) {
+            return false;
+        }
+        size_t end = param.find('=', start);
+        parts[count++] = param.substr(start, end == std::string_view::npos ? end : end - start);
+        start = end == std::string_view::npos ? end : param.find_first_not_of('=', end);
+    }
+    if (count != REQUEST_PARAMS_NUM) {
+        return false;
+    }
+    key = parts[0];
+    value = parts[1];
+    return true;
+}
+
+// 同名参数以第一次出现的为准，与getQueryParameter中map::insert的行为一致
+void AssignQueryParam(UriInfo &info, std::string_view key, std::string_view value)
+{
+    std::string_view *field = nullptr;
+    if (key == PARAM_IS_SYNC_FROM_CLOUD) {
+        field = &info.isSyncFromCloud;
+    } else if (key == PARAM_IS_FROM_BATCH) {
+        field = &info.isFromBatch;
+    } else if (key == PARAM_HANDLE_TYPE) {
+        field = &info.handleType;
+    }
+    if (field != nullptr && field->empty()) {
+        *field = value;
+    }
+}
+} // namespace
+
+UriRouteTable::UriRouteTable(const std::map<std::string, int> &routes)
+{
+    size_t capacity = 1;
+    while (capacity < routes.size() * 2) {
+        capacity <<= 1;
+    }
+    for (; capacity <= ROUTE_MAX_CAPACITY; capacity <<= 1) {
+        for (uint32_t seed = 0; seed < ROUTE_SEED_ATTEMPTS; seed++) {
+            if (TryBuild(routes, capacity, seed)) {
+                return;
+            }
+        }
+    }
+    // 找不到无冲突的种子时退化为线性探测，Find的结果不受影响
+    HILOG_WARN("UriRouteTable no perfect seed, fall back to probing");
+    seed_ = 0;
+    mask_ = ROUTE_MAX_CAPACITY - 1;
+    slots_.assign(ROUTE_MAX_CAPACITY, {});
+    used_.assign(ROUTE_MAX_CAPACITY, false);
+    for (const auto &route : routes) {
+        size_t index = Hash(route.first, seed_) & mask_;
+        while (used_[index]) {
+            index = (index + 1) & mask_;
+        }
+        slots_[index] = route;
+        used_[index] = true;
+    }
+}
+
+bool UriRouteTable::TryBuild(const std::map<std::string, int> &routes, size_t capacity, uint32_t seed)
+{
+    std::vector<bool> used(capacity, false);
+    for (const auto &route : routes) {
+        size_t index = Hash(route.first, seed) & (capacity - 1);
+        if (used[index]) {
+            return false;
+        }
+        used[index] = true;
+    }
+    seed_ = seed;
+    mask_ = capacity - 1;
+    slots_.assign(capacity, {});
+    for (const auto &route : routes) {
+        slots_[Hash(route.first, seed) & mask_] = route;
+    }
+    used_ = std::move(used);
+    return true;
+}
+
+uint32_t UriRouteTable::Hash(std::string_view key, uint32_t seed)
+{
+    uint32_t hash = FNV_OFFSET_BASIS ^ seed;
+    for (char c : key) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV_PRIME;
+    }
+    return hash ^ (hash >> HASH_MIX_SHIFT);
+}
+
+int UriRouteTable::Find(std::string_view path) const
+{
+    for (size_t index = Hash(path, seed_) & mask_; used_[index]; index = (index + 1) & mask_) {
+        if (slots_[index].first == path) {
+            return slots_[index].second;
+        }
+    }
+    return OPERATION_ERROR;
+}
 UriUtils::UriUtils(void)
 {
 }
@@ -52,12 +169,13 @@ std::map<std::string, std::string> UriUtils::getQueryParameter(OHOS::Uri &uri)
 
 std::vector<std::string> UriUtils::split(const std::string &str, const std::string &split)
 {
-    char *saveChar = nullptr;
-    char *token = strtok_r(const_cast<char *>(str.c_str()), split.c_str(), &saveChar);
+    // 与strtok_r相同：split中的每个字符都是分隔符，连续分隔符之间的空串跳过；不修改入参
     std::vector<std::string> result;
-    while (token != nullptr) {
-        result.emplace_back(token);
-        token = strtok_r(nullptr, split.c_str(), &saveChar);
+    size_t start = str.find_first_not_of(split);
+    while (start != std::string::npos) {
+        size_t end = str.find_first_of(split, start);
+        result.emplace_back(str, start, end == std::string::npos ? end : end - start);
+        start = end == std::string::npos ? end : str.find_first_not_of(split, end);
     }
     return result;
 }
@@ -83,5 +201,72 @@ void UriUtils::GetFileTypeAndFileName(const OHOS::Uri &uri, std::string &openFil
         fileName = parts[parts.size() - 1];
     }
 }
+/**
+ * @brief Parse the route code and the query parameters of a uri in one pass without allocating
+ *
+ * @param uri The uri string, it must outlive the returned UriInfo
+ * @param routes Route table of the ability
+ *
+ * @return Route code, path and query parameters of the uri
+ */
+UriInfo UriUtils::ParseUri(std::string_view uri, const UriRouteTable &routes)
+{
+    UriInfo info;
+    size_t pathStart = 0;
+    size_t schemeEnd = uri.find_first_of(":/?#");
+    if (schemeEnd != std::string_view::npos && uri[schemeEnd] == ':') {
+        pathStart = schemeEnd + 1;
+        // 跳过authority，与Uri::GetPath一致
+        if (uri.substr(pathStart, 2) == "//") {
+            pathStart = uri.find_first_of("/?#", pathStart + 2);
+            pathStart = pathStart == std::string_view::npos ? uri.size() : pathStart;
+        }
+    }
+    size_t pathEnd = uri.find_first_of("?#", pathStart);
+    pathEnd = pathEnd == std::string_view::npos ? uri.size() : pathEnd;
+    info.path = uri.substr(pathStart, pathEnd - pathStart);
+    if (!info.path.empty()) {
+        info.code = routes.Find(info.path);
+    }
+    if (pathEnd == uri.size() || uri[pathEnd] != '?') {
+        return info;
+    }
+    std::string_view query = uri.substr(pathEnd + 1);
+    query = query.substr(0, query.find('#'));
+    size_t start = query.find_first_not_of('&');
+    while (start != std::string_view::npos) {
+        size_t end = query.find('&', start);
+        std::string_view param = query.substr(start, end == std::string_view::npos ? end : end - start);
+        std::string_view key;
+        std::string_view value;
+        if (SplitQueryParam(param, key, value)) {
+            AssignQueryParam(info, key, value);
+        }
+        start = end == std::string_view::npos ? end : query.find_first_not_of('&', end);
+    }
+    return info;
+}
+
+/**
+ * @brief Get a segment of a uri path, empty segments are skipped like Uri::GetPathSegments
+ *
+ * @param path Path of the uri
+ * @param index Index of the segment
+ *
+ * @return The segment, empty if the path has fewer segments
+ */
+std::string_view UriUtils::GetPathSegment(std::string_view path, size_t index)
+{
+    size_t start = path.find_first_not_of('/');
+    while (start != std::string_view::npos) {
+        size_t end = path.find('/', start);
+        if (index == 0) {
+            return path.substr(start, end == std::string_view::npos ? end : end - start);
+        }
+        index--;
+        start = end == std::string_view::npos ? end : path.find_first_not_of('/', end);
+    }
+    return std::string_view();
+}
 } // namespace Contacts
 } // namespace OHOS
\ No newline at end of file
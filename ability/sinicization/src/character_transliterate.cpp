@@ -15,8 +15,10 @@
 
 #include "character_transliterate.h"
 
+#include <algorithm>
 #include <codecvt>
 #include <iostream>
+#include <locale>
 
 #include "common.h"
 #include "hilog_wrapper.h"
@@ -15,6 +15,9 @@
 
 #include "construction_name.h"
 
+#include <algorithm>
+#include <cctype>
+
 #include "character_transliterate.h"
 #include "hilog_wrapper.h"
 
@@ -59,7 +62,7 @@ ConstructionName ConstructionName::GetConstructionName(
         std::string sortFirstLetterTemp = characterTransliterate.WstringToString(sortKeyWstring.substr(0, 1));
         // 转大写
         std::transform(
-            sortFirstLetterTemp.begin(), sortFirstLetterTemp.end(), sortFirstLetterTemp.begin(), std::toupper);
+            sortFirstLetterTemp.begin(), sortFirstLetterTemp.end(), sortFirstLetterTemp.begin(), ::toupper);
         constructionName.sortFirstLetter_ = sortFirstLetterTemp;
         int code = constructionName.sortFirstLetter_.c_str()[0];
         constructionName.sortFirstLetterCode_ = code;
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACT_DATA_CHANGES_H
+#define CONTACT_DATA_CHANGES_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "datashare_result_set.h"
+#include "datashare_values_bucket.h"
+
+namespace OHOS {
+namespace ContactsApi {
+/**
+ * @brief Diff of the contact_data rows of an updated contact against the stored rows
+ */
+class ContactDataChanges {
+public:
+    /**
+     * @brief Columns to query the stored rows with, in the order ReadStoredRows reads them
+     */
+    static std::vector<std::string> QueryColumns();
+
+    /**
+     * @brief Read the stored contact_data rows, keyed like BuildBucketKey
+     *
+     * @param resultSet Rows queried with QueryColumns
+     * @param storedRows Row ids of the stored rows by key
+     */
+    static void ReadStoredRows(const std::shared_ptr<DataShare::DataShareResultSet> &resultSet,
+        std::map<std::string, std::vector<int>> &storedRows);
+
+    /**
+     * @brief Build the key comparing a new contact_data bucket with a stored row
+     *
+     * @param bucket The contact_data bucket built from the contact object
+     * @param key Content type and compared column values
+     *
+     * @return Whether the bucket can be matched against stored rows
+     */
+    static bool BuildBucketKey(const DataShare::DataShareValuesBucket &bucket, std::string &key);
+
+    /**
+     * @brief Split the new contact_data buckets into the stored rows to delete and the buckets to insert
+     *
+     * @param buckets The contact_data buckets built from the contact object
+     * @param storedRows Row ids of the stored rows by key, matched rows are removed
+     * @param deleteIds Ids of the stored rows to delete
+     * @param insertValues Buckets to insert
+     */
+    static void Split(const std::vector<DataShare::DataShareValuesBucket> &buckets,
+        std::map<std::string, std::vector<int>> &storedRows, std::vector<std::string> &deleteIds,
+        std::vector<DataShare::DataShareValuesBucket> &insertValues);
+};
+} // namespace ContactsApi
+} // namespace OHOS
+#endif // CONTACT_DATA_CHANGES_H
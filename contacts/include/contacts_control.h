@@ -70,7 +70,11 @@ public:
     std::shared_ptr<DataShare::DataShareResultSet> HolderQuery(
         std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, std::vector<std::string> columns,
         DataShare::DataSharePredicates predicates);
-    int QueryCallLogCount(
+    bool ContactDataExists(
+        std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, DataShare::DataSharePredicates predicates);
+    bool MyCardExists(
+        std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, DataShare::DataSharePredicates predicates);
+    int QueryCallLogExists(
         std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, const DataShare::DataSharePredicates &predicates);
     std::string QueryAppGroupDir(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper);
     int OpenFileByDataShare(const std::string &fileName,
@@ -78,6 +82,9 @@ public:
     std::shared_ptr<DataShare::DataShareResultSet> QueryContactByRawContactId(
         std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, std::vector<std::string> &columns,
         int rawContactId);
+    std::shared_ptr<DataShare::DataShareResultSet> QueryContactByRawContactIds(
+        std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, std::vector<std::string> &columns,
+        const std::vector<std::string> &rawContactIds);
     int HandleAddFailed(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper,
         const DataShare::DataSharePredicates &predicates, const std::string &fileName);
 };
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONTACT_DATASHARE_HELPER_POOL_H
+#define CONTACT_DATASHARE_HELPER_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "context.h"
+#include "datashare_helper.h"
+
+namespace OHOS {
+namespace ContactsApi {
+/**
+ * 按ability上下文和uri复用DataShareHelper，避免每次接口调用都重新连接联系人数据ability
+ *
+ * Acquire与Release成对调用：同一上下文的多个异步任务共享一个helper，引用计数归零后helper保留在池中；
+ * 上下文销毁或连接失效后，helper在最后一个使用者归还时释放。FA模型的helper不入池，Release时直接释放
+ */
+class DataShareHelperPool {
+public:
+    static DataShareHelperPool &GetInstance();
+    std::shared_ptr<DataShare::DataShareHelper> Acquire(
+        const std::shared_ptr<AbilityRuntime::Context> &context, const std::string &uri);
+    // isBroken为true表示本次调用因连接问题失败，池中不再复用该helper，下次Acquire重新连接
+    void Release(const std::shared_ptr<DataShare::DataShareHelper> &helper, bool isBroken);
+
+private:
+    struct Entry {
+        std::weak_ptr<AbilityRuntime::Context> context;
+        IRemoteObject *token = nullptr;
+        std::string uri;
+        std::shared_ptr<DataShare::DataShareHelper> helper;
+        int refCount = 0;
+        bool retired = false;
+    };
+
+    DataShareHelperPool() = default;
+    std::shared_ptr<DataShare::DataShareHelper> AcquireLocked(const IRemoteObject *token, const std::string &uri);
+    void SweepLocked(std::vector<std::shared_ptr<DataShare::DataShareHelper>> &released);
+    static void ReleaseHelpers(const std::vector<std::shared_ptr<DataShare::DataShareHelper>> &helpers);
+
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+};
+} // namespace ContactsApi
+} // namespace OHOS
+#endif // CONTACT_DATASHARE_HELPER_POOL_H
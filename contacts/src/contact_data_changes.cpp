@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "contact_data_changes.h"
+
+#include <algorithm>
+#include <set>
+#include <variant>
+
+#include "rdb_errno.h"
+
+namespace OHOS {
+namespace ContactsApi {
+namespace {
+// 更新联系人时比较新旧数据所用的列，均为view_contact_data可查询、且ContactsBuild会写入的列
+const std::vector<std::string> UPDATE_CONTACT_COMPARE_COLUMNS = {
+    "detail_info", "custom_data", "extend7", "alias_detail_info", "neighborhood", "pobox", "postcode", "region",
+    "street", "city", "country", "alpha_name", "other_lan_last_name", "other_lan_first_name", "family_name",
+    "middle_name_phonetic", "given_name", "given_name_phonetic", "phonetic_name"
+};
+// organization的position不在view_contact_data中，photo的detail_info插入时会被转换，这两类数据总是重新写入
+const std::set<std::string> UPDATE_CONTACT_REWRITE_TYPES = {"organization", "photo"};
+constexpr char KEY_SEPARATOR = '\x1f';
+// 查询列前两列为id、content_type
+constexpr int COMPARE_COLUMN_OFFSET = 2;
+
+std::string ValueObjectToString(const DataShare::DataShareValueObject &object)
+{
+    if (const auto *text = std::get_if<std::string>(&object.value)) {
+        return *text;
+    }
+    if (const auto *number = std::get_if<int64_t>(&object.value)) {
+        return std::to_string(*number);
+    }
+    if (const auto *real = std::get_if<double>(&object.value)) {
+        return std::to_string(*real);
+    }
+    if (const auto *flag = std::get_if<bool>(&object.value)) {
+        return *flag ? "1" : "0";
+    }
+    return "";
+}
+}
+
+std::vector<std::string> ContactDataChanges::QueryColumns()
+{
+    std::vector<std::string> columns = {"id", "content_type"};
+    columns.insert(columns.end(), UPDATE_CONTACT_COMPARE_COLUMNS.begin(), UPDATE_CONTACT_COMPARE_COLUMNS.end());
+    return columns;
+}
+
+void ContactDataChanges::ReadStoredRows(const std::shared_ptr<DataShare::DataShareResultSet> &resultSet,
+    std::map<std::string, std::vector<int>> &storedRows)
+{
+    if (resultSet == nullptr) {
+        return;
+    }
+    int resultSetNum = resultSet->GoToFirstRow();
+    while (resultSetNum == OHOS::NativeRdb::E_OK) {
+        int id = 0;
+        resultSet->GetInt(0, id);
+        std::string key;
+        resultSet->GetString(1, key);
+        for (size_t i = 0; i < UPDATE_CONTACT_COMPARE_COLUMNS.size(); i++) {
+            std::string value;
+            resultSet->GetString(static_cast<int>(i) + COMPARE_COLUMN_OFFSET, value);
+            key.append(1, KEY_SEPARATOR).append(value);
+        }
+        storedRows[key].push_back(id);
+        resultSetNum = resultSet->GoToNextRow();
+    }
+}
+
+bool ContactDataChanges::BuildBucketKey(const DataShare::DataShareValuesBucket &bucket, std::string &key)
+{
+    auto typeIt = bucket.valuesMap.find("content_type");
+    if (typeIt == bucket.valuesMap.end()) {
+        return false;
+    }
+    std::string contentType = ValueObjectToString(typeIt->second);
+    if (UPDATE_CONTACT_REWRITE_TYPES.count(contentType) != 0) {
+        return false;
+    }
+    for (const auto &item : bucket.valuesMap) {
+        if (item.first != "content_type" && item.first != "raw_contact_id" &&
+            std::find(UPDATE_CONTACT_COMPARE_COLUMNS.begin(), UPDATE_CONTACT_COMPARE_COLUMNS.end(), item.first) ==
+            UPDATE_CONTACT_COMPARE_COLUMNS.end()) {
+            return false;
+        }
+    }
+    key = contentType;
+    for (const auto &column : UPDATE_CONTACT_COMPARE_COLUMNS) {
+        auto it = bucket.valuesMap.find(column);
+        key.append(1, KEY_SEPARATOR).append(it == bucket.valuesMap.end() ? "" : ValueObjectToString(it->second));
+    }
+    return true;
+}
+
+/**
+ * 与已存数据完全相同的bucket保持不动；其余旧数据删除、新数据插入。变化的数据不走Update，
+ * 因为contact_data的Update不会重算插入时派生的列（如format_phone_number）。
+ * 头像文件bucket没有content_type，始终随插入提交以走BatchInsert的头像处理
+ */
+void ContactDataChanges::Split(const std::vector<DataShare::DataShareValuesBucket> &buckets,
+    std::map<std::string, std::vector<int>> &storedRows, std::vector<std::string> &deleteIds,
+    std::vector<DataShare::DataShareValuesBucket> &insertValues)
+{
+    for (const auto &bucket : buckets) {
+        std::string key;
+        if (BuildBucketKey(bucket, key)) {
+            auto it = storedRows.find(key);
+            if (it != storedRows.end() && !it->second.empty()) {
+                it->second.pop_back();
+                continue;
+            }
+        }
+        insertValues.push_back(bucket);
+    }
+    for (const auto &item : storedRows) {
+        for (int id : item.second) {
+            deleteIds.push_back(std::to_string(id));
+        }
+    }
+}
+} // namespace ContactsApi
+} // namespace OHOS
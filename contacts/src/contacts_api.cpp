@@ -15,8 +15,12 @@
 
 #include "contacts_api.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <set>
+#include <thread>
 
 #include "datashare_predicates.h"
 #include "rdb_errno.h"
@@ -27,8 +31,10 @@
 #include "result_set.h"
 #include "securec.h"
 
+#include "contact_data_changes.h"
 #include "contacts_napi_common.h"
 #include "contacts_napi_utils.h"
+#include "datashare_helper_pool.h"
 #include "hilog_wrapper_api.h"
 #include "result_convert.h"
 #include "contacts_telephony_permission.h"
@@ -71,6 +77,7 @@ const std::vector<int> needGroupVec = {
 };
 constexpr int64_t WITH_IN_TIME_MAX = 6 * 3600;
 constexpr int CARRIER_CALL_FEATURES_LIMIT = 1000;
+constexpr size_t PORTRAIT_WORKER_LIMIT = 4;
 
 /**
  * @brief Initialize NAPI object
@@ -231,12 +238,11 @@ bool GetDataShareHelper(napi_env env, napi_callback_info info, ExecuteHelper *ex
             HILOG_ERROR("Failed to get native stage context instance");
             return false;
         }
+        // 同一上下文的调用复用连接，避免逐次连接联系人数据ability
         if (executeHelper->actionCode == HAS_MATCHED_CALL_LOG) {
-            executeHelper->dataShareHelper = DataShare::DataShareHelper::Creator(context->GetToken(),
-                CALL_LOG_CHECK_URI);
+            executeHelper->dataShareHelper = DataShareHelperPool::GetInstance().Acquire(context, CALL_LOG_CHECK_URI);
         } else {
-            executeHelper->dataShareHelper = DataShare::DataShareHelper::Creator(context->GetToken(),
-                CONTACTS_DATA_URI);
+            executeHelper->dataShareHelper = DataShareHelperPool::GetInstance().Acquire(context, CONTACTS_DATA_URI);
         }
     }
     return false;
@@ -858,7 +864,7 @@ void ExecuteDone(napi_env env, napi_status status, void *data)
     executeHelper->deferred = nullptr;
     NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, executeHelper->work));
     if (executeHelper->dataShareHelper != nullptr) {
-        executeHelper->dataShareHelper->Release();
+        DataShareHelperPool::GetInstance().Release(executeHelper->dataShareHelper, executeHelper->resultData == ERROR);
         executeHelper->dataShareHelper = nullptr;
     }
     delete executeHelper;
@@ -931,7 +937,8 @@ void ExecuteSyncDone(napi_env env, napi_status status, void *data)
             std::vector<DataShare::DataShareValuesBucket>().swap(executeHelper->valueUpdateContact);
         }
         if (executeHelper->dataShareHelper != nullptr) {
-            executeHelper->dataShareHelper->Release();
+            DataShareHelperPool::GetInstance().Release(executeHelper->dataShareHelper,
+                executeHelper->resultData == ERROR);
             executeHelper->dataShareHelper = nullptr;
         }
         if (executeHelper->callBack != nullptr) {
@@ -1212,27 +1219,167 @@ void LocalExecuteAddContacts(napi_env env, ExecuteHelper *executeHelper)
     BatchInsertPortrait(results, executeHelper);
 }
 
+/**
+ * @brief Write the portrait file of a contact and build its contact_data bucket
+ *
+ * @param dataShareHelper Helper used to open the portrait file
+ * @param contactsControl Control used to open the portrait file
+ * @param photo The portrait image
+ * @param contactId Contact id of the raw contact
+ * @param rawContactId Raw contact the portrait belongs to
+ * @param addPortraitType Add portrait type stored in the bucket
+ * @param valuesBucketPortrait The portrait bucket, filled on success
+ *
+ * @return ERR_OK on success, otherwise the open file or save error
+ */
+static int SaveContactPortraitFile(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper,
+    ContactsControl &contactsControl, const std::shared_ptr<Media::PixelMap> &photo, const std::string &contactId,
+    int rawContactId, int32_t addPortraitType, DataShare::DataShareValuesBucket &valuesBucketPortrait)
+{
+    std::string fileName = contactId + "_" + std::to_string(rawContactId) + ".jpg";
+    int fd = contactsControl.OpenFileByDataShare(fileName, dataShareHelper);
+    if (fd == OPEN_FILE_FAILED || fd == RDB_PERMISSION_ERROR) {
+        HILOG_ERROR("InsertContactPortrait OpenFileByDataShare failed");
+        return fd;
+    }
+    int32_t srcHeight = 0;
+    int32_t srcWidth = 0;
+    OHOS::Contacts::KitPixelMapUtil::GetPixelMapSize(photo, srcHeight, srcWidth);
+    int result = OHOS::Contacts::KitPixelMapUtil::SavePixelMapToFile(photo, fd);
+    close(fd);
+    if (result != ERR_OK) {
+        return result;
+    }
+    valuesBucketPortrait.Put("PortraitFileName", fileName);
+    valuesBucketPortrait.Put("contactId", contactId);
+    valuesBucketPortrait.Put("rawContactId", std::to_string(rawContactId));
+    valuesBucketPortrait.Put("srcHeight", srcHeight);
+    valuesBucketPortrait.Put("srcWidth", srcWidth);
+    valuesBucketPortrait.Put("addPortraitType", addPortraitType);
+    return result;
+}
+
+struct PortraitJob {
+    int rawContactId = 0;
+    std::string contactId;
+    Portrait portrait;
+    int result = ERR_OK;
+    DataShare::DataShareValuesBucket valuesBucket;
+};
+
+// 批量查询raw_contact对应的contact_id，替代逐个联系人查询
+static void QueryContactIdsByRawContactIds(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper,
+    ContactsControl &contactsControl, std::vector<PortraitJob> &jobs)
+{
+    std::vector<std::string> rawContactIds;
+    for (const auto &job : jobs) {
+        rawContactIds.push_back(std::to_string(job.rawContactId));
+    }
+    std::vector<std::string> columns = {"id", "contact_id"};
+    auto resultSet = contactsControl.QueryContactByRawContactIds(dataShareHelper, columns, rawContactIds);
+    if (resultSet == nullptr) {
+        HILOG_ERROR("QueryContactIdsByRawContactIds failed, resultSet is nullptr");
+        return;
+    }
+    std::map<int, std::string> contactIds;
+    int resultSetNum = resultSet->GoToFirstRow();
+    while (resultSetNum == OHOS::NativeRdb::E_OK) {
+        int rawContactId = 0;
+        std::string contactId;
+        resultSet->GetInt(0, rawContactId);
+        resultSet->GetString(1, contactId);
+        contactIds[rawContactId] = contactId;
+        resultSetNum = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    for (auto &job : jobs) {
+        auto it = contactIds.find(job.rawContactId);
+        if (it != contactIds.end()) {
+            job.contactId = it->second;
+        }
+    }
+}
+
+static void ProcessPortraitJob(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper,
+    ContactsControl &contactsControl, PortraitJob &job)
+{
+    if (job.contactId.empty()) {
+        HILOG_ERROR("InsertContactPortrait failed, contactId is null %{public}d", job.rawContactId);
+        job.result = OPEN_FILE_FAILED;
+        return;
+    }
+    bool isUriPortrait = !job.portrait.uri.empty();
+    std::shared_ptr<Media::PixelMap> photo = isUriPortrait ?
+        std::shared_ptr<Media::PixelMap>(OHOS::Contacts::KitPixelMapUtil::GetPixelMapFromUri(job.portrait.uri)) :
+        job.portrait.photo;
+    job.result = SaveContactPortraitFile(dataShareHelper, contactsControl, photo, job.contactId, job.rawContactId,
+        OHOS::Contacts::KitPixelMapUtil::GetAddPortraitType(true, isUriPortrait), job.valuesBucket);
+}
+
+// 头像的解码、编码和写文件在有限个工作线程中并行执行，当前线程也参与处理
+static void RunPortraitJobs(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper,
+    std::vector<PortraitJob> &jobs)
+{
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t workerCount = std::min({jobs.size(), hardwareThreads, PORTRAIT_WORKER_LIMIT});
+    std::atomic<size_t> nextJob {0};
+    auto work = [&dataShareHelper, &jobs, &nextJob]() {
+        ContactsControl contactsControl;
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+            ProcessPortraitJob(dataShareHelper, contactsControl, jobs[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
 void BatchInsertPortrait(const std::vector<DataShare::ExecResult> &results, ExecuteHelper *executeHelper)
 {
     ContactsControl contactsControl;
-    ContactsBuild contactsBuild;
+    std::vector<PortraitJob> jobs;
     for (const auto &[index, portrait] : executeHelper->portraits) {
         if (results[index].code != DataShare::ExecErrorCode::EXEC_SUCCESS) {
             HILOG_ERROR("BatchInsertPortrait Insert Contact[%{public}zu] failed, skip insert portrait", index);
             continue;
         }
         auto rawId = std::stoi(results[index].message);
-        Contacts contact;
-        contact.portrait = portrait;
-        contactsBuild.BuildExecuteHelperPortrait(contact, executeHelper);
-        int insertPortraitResult = InsertContactPortrait(executeHelper, contactsControl, rawId, true);
-        if (insertPortraitResult != ERR_OK) {
-            HILOG_ERROR("BatchInsertPortrait InsertContactPortrait failed: %{public}d", insertPortraitResult);
-            auto &opResult = executeHelper->operationResultData;
-            auto iter = std::find(opResult.begin(), opResult.end(), rawId);
-            if (iter != opResult.end()) {
-                *iter = INVALID_CONTACT_ID;
-            }
+        // 适配旧uri类型，photo/contactId_rawContactId，直接写入头像数据
+        if (portrait.uri.find("photo/") == 0 && portrait.uri.find('_') != std::string::npos) {
+            DataShare::DataShareValuesBucket valuesBucketPortrait;
+            valuesBucketPortrait.Put("raw_contact_id", rawId);
+            valuesBucketPortrait.Put("detail_info", portrait.uri);
+            valuesBucketPortrait.Put("content_type", "photo");
+            executeHelper->valueContactData.push_back(valuesBucketPortrait);
+            continue;
+        }
+        PortraitJob job;
+        job.rawContactId = rawId;
+        job.portrait = portrait;
+        jobs.push_back(std::move(job));
+    }
+    if (!jobs.empty()) {
+        QueryContactIdsByRawContactIds(executeHelper->dataShareHelper, contactsControl, jobs);
+        RunPortraitJobs(executeHelper->dataShareHelper, jobs);
+    }
+    for (auto &job : jobs) {
+        if (job.result == ERR_OK) {
+            executeHelper->valueContactData.push_back(job.valuesBucket);
+            continue;
+        }
+        HILOG_ERROR("BatchInsertPortrait InsertContactPortrait failed: %{public}d", job.result);
+        if (!job.contactId.empty()) {
+            HandleConverPortraitFailed(executeHelper, contactsControl, job.rawContactId, job.contactId, job.result);
+        }
+        auto &opResult = executeHelper->operationResultData;
+        auto iter = std::find(opResult.begin(), opResult.end(), job.rawContactId);
+        if (iter != opResult.end()) {
+            *iter = INVALID_CONTACT_ID;
         }
     }
     if (!executeHelper->valueContactData.empty()) {
@@ -1323,31 +1470,15 @@ int InsertContactPortrait(ExecuteHelper *executeHelper, ContactsControl &contact
         HILOG_ERROR("InsertContactPortrait failed, contactId is null %{public}d", rawContactId);
         return OPEN_FILE_FAILED;
     }
-    std::string fileName = contactId + "_" + std::to_string(rawContactId) + ".jpg";
-    int fd = contactsControl.OpenFileByDataShare(fileName, executeHelper->dataShareHelper);
-    if (fd == OPEN_FILE_FAILED || fd == RDB_PERMISSION_ERROR) {
-        HILOG_ERROR("InsertContactPortrait OpenFileByDataShare failed");
-        HandleConverPortraitFailed(executeHelper, contactsControl, rawContactId, contactId, fd);
-        return fd;
-    }
-    int32_t srcHeight = 0;
-    int32_t srcWidth = 0;
-    OHOS::Contacts::KitPixelMapUtil::GetPixelMapSize(executeHelper->portrait.photo, srcHeight, srcWidth);
-    int result = OHOS::Contacts::KitPixelMapUtil::SavePixelMapToFile(executeHelper->portrait.photo, fd);
-    close(fd);
+    DataShare::DataShareValuesBucket valuesBucketPortrait;
+    int result = SaveContactPortraitFile(executeHelper->dataShareHelper, contactsControl,
+        executeHelper->portrait.photo, contactId, rawContactId,
+        OHOS::Contacts::KitPixelMapUtil::GetAddPortraitType(isAddType, executeHelper->portrait.isUriPortrait),
+        valuesBucketPortrait);
     if (result != ERR_OK) {
         HandleConverPortraitFailed(executeHelper, contactsControl, rawContactId, contactId, result);
         return result;
     }
-    DataShare::DataShareValuesBucket valuesBucketPortrait;
-
-    valuesBucketPortrait.Put("PortraitFileName", fileName);
-    valuesBucketPortrait.Put("contactId", contactId);
-    valuesBucketPortrait.Put("rawContactId", std::to_string(rawContactId));
-    valuesBucketPortrait.Put("srcHeight", srcHeight);
-    valuesBucketPortrait.Put("srcWidth", srcWidth);
-    valuesBucketPortrait.Put("addPortraitType",
-        OHOS::Contacts::KitPixelMapUtil::GetAddPortraitType(isAddType, executeHelper->portrait.isUriPortrait));
     executeHelper->valueContactData.push_back(valuesBucketPortrait);
     return result;
 }
@@ -1444,14 +1575,13 @@ void LocalExecuteQueryContactsByData(napi_env env, ExecuteHelper *executeHelper)
     executeHelper->resultSet = contactsControl.ContactDataQuery(
         executeHelper->dataShareHelper, executeHelper->columns, executeHelper->predicates);
     std::shared_ptr<DataShare::DataShareResultSet> resultSet = executeHelper->resultSet;
-    int rowCount = 0;
     if (resultSet == nullptr) {
         HILOG_ERROR("LocalExecuteQueryContactsByData resultSet is nullprt");
         executeHelper->resultData = RDB_PARAMETER_ERROR;
         return;
     }
-    resultSet->GetRowCount(rowCount);
-    if (rowCount == 0) {
+    // 只需判断结果非空，GetRowCount会让结果集遍历全部匹配行
+    if (resultSet->GoToFirstRow() != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR("LocalExecuteQueryContactsByData parameter verification failed");
         executeHelper->resultData = RDB_PARAMETER_ERROR;
         resultSet->Close();
@@ -1484,6 +1614,28 @@ void LocalExecuteQueryMyCard(napi_env env, ExecuteHelper *executeHelper)
     executeHelper->resultData = SUCCESS;
 }
 
+/**
+ * @brief Query the stored contact_data rows in the update scope, keyed like ContactDataChanges::BuildBucketKey
+ *
+ * @param executeHelper Update context, deletePredicates selects the rows the update replaces
+ * @param contactsControl Control used to query contact_data
+ * @param storedRows Row ids of the stored rows by key
+ *
+ * @return Whether the query succeeded
+ */
+static bool QueryStoredContactData(ExecuteHelper *executeHelper, ContactsControl &contactsControl,
+    std::map<std::string, std::vector<int>> &storedRows)
+{
+    std::shared_ptr<DataShare::DataShareResultSet> resultSet = contactsControl.ContactDataQuery(
+        executeHelper->dataShareHelper, ContactDataChanges::QueryColumns(), executeHelper->deletePredicates);
+    if (resultSet == nullptr) {
+        return false;
+    }
+    ContactDataChanges::ReadStoredRows(resultSet, storedRows);
+    resultSet->Close();
+    return true;
+}
+
 void LocalExecuteUpdateContact(napi_env env, ExecuteHelper *executeHelper)
 {
     ContactsControl contactsControl;
@@ -1503,8 +1655,12 @@ void LocalExecuteUpdateContact(napi_env env, ExecuteHelper *executeHelper)
     }
     executeHelper->deletePredicates.And();
     executeHelper->deletePredicates.EqualTo("raw_contact_id", std::to_string(rawId));
-    int resultCode = contactsControl.ContactDataDelete(
-        executeHelper->dataShareHelper, executeHelper->deletePredicates);
+    std::map<std::string, std::vector<int>> storedRows;
+    if (!QueryStoredContactData(executeHelper, contactsControl, storedRows)) {
+        HILOG_ERROR("LocalExecuteUpdateContact query stored contact data failed");
+        executeHelper->resultData = ERROR;
+        return;
+    }
     if (executeHelper->portrait.isNeedHandlePhoto) {
         int result = InsertContactPortrait(executeHelper, contactsControl, rawId, false);
         if (result != ERR_OK) {
@@ -1512,49 +1668,36 @@ void LocalExecuteUpdateContact(napi_env env, ExecuteHelper *executeHelper)
             return;
         }
     }
-    if (resultCode >= 0 && size > 0) {
-        resultCode = contactsControl.ContactDataInsert(
-            executeHelper->dataShareHelper, executeHelper->valueContactData);
+    // 只提交有变化的数据；仍走Delete与BatchInsert，由数据提供方发送变更通知并置脏
+    std::vector<std::string> deleteIds;
+    std::vector<DataShare::DataShareValuesBucket> insertValues;
+    ContactDataChanges::Split(executeHelper->valueContactData, storedRows, deleteIds, insertValues);
+    HILOG_INFO("LocalExecuteUpdateContact keep %{public}zu, delete %{public}zu, insert %{public}zu",
+        executeHelper->valueContactData.size() - insertValues.size(), deleteIds.size(), insertValues.size());
+    int resultCode = SUCCESS;
+    if (!deleteIds.empty()) {
+        DataShare::DataSharePredicates changedPredicates;
+        changedPredicates.In("id", deleteIds);
+        resultCode = contactsControl.ContactDataDelete(executeHelper->dataShareHelper, changedPredicates);
+    }
+    if (resultCode >= 0 && !insertValues.empty()) {
+        resultCode = contactsControl.ContactDataInsert(executeHelper->dataShareHelper, insertValues);
     }
     executeHelper->resultData = resultCode;
 }
 
 void LocalExecuteIsLocalContact(napi_env env, ExecuteHelper *executeHelper)
 {
-    int64_t isLocal = 0;
     ContactsControl contactsControl;
-    std::shared_ptr<DataShare::DataShareResultSet> resultSet = contactsControl.ContactQuery(
-        executeHelper->dataShareHelper, executeHelper->columns, executeHelper->predicates);
-    if (resultSet == nullptr) {
-        executeHelper->resultData = isLocal;
-        return;
-    }
-    int resultSetNum = resultSet->GoToFirstRow();
-    if (resultSetNum == OHOS::NativeRdb::E_OK) {
-        isLocal = 1;
-    }
-    executeHelper->resultData = isLocal;
-    resultSet->Close();
+    bool isLocal = contactsControl.ContactDataExists(executeHelper->dataShareHelper, executeHelper->predicates);
+    executeHelper->resultData = isLocal ? 1 : 0;
 }
 
 void LocalExecuteIsMyCard(napi_env env, ExecuteHelper *executeHelper)
 {
-    int64_t isMyCard = 0;
     ContactsControl contactsControl;
-    std::shared_ptr<DataShare::DataShareResultSet> resultSet = contactsControl.MyCardQuery(
-        executeHelper->dataShareHelper, executeHelper->columns, executeHelper->predicates);
-    if (resultSet == nullptr) {
-        executeHelper->resultData = isMyCard;
-        return;
-    }
-    int rowCount = 0;
-    resultSet->GetRowCount(rowCount);
-    int resultSetNum = resultSet->GoToFirstRow();
-    if (resultSetNum == OHOS::NativeRdb::E_OK) {
-        isMyCard = 1;
-    }
-    executeHelper->resultData = isMyCard;
-    resultSet->Close();
+    bool isMyCard = contactsControl.MyCardExists(executeHelper->dataShareHelper, executeHelper->predicates);
+    executeHelper->resultData = isMyCard ? 1 : 0;
 }
 
 void LocalExecuteHasMatchedCallLog(napi_env env, ExecuteHelper *executeHelper)
@@ -1565,9 +1708,8 @@ void LocalExecuteHasMatchedCallLog(napi_env env, ExecuteHelper *executeHelper)
         return;
     }
     ContactsControl contactsControl;
-    int queryCallLogCountRet =
-        contactsControl.QueryCallLogCount(executeHelper->dataShareHelper, executeHelper->predicates);
-    executeHelper->resultData = queryCallLogCountRet > 0 ? 1 : queryCallLogCountRet;
+    executeHelper->resultData =
+        contactsControl.QueryCallLogExists(executeHelper->dataShareHelper, executeHelper->predicates);
     HILOG_INFO("LocalExecuteHasMatchedCallLog end");
 }
 
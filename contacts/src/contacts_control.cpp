@@ -133,6 +133,19 @@ std::shared_ptr<DataShare::DataShareResultSet> ContactsControl::QueryContactByRa
     return resultSet;
 }
 
+std::shared_ptr<DataShare::DataShareResultSet> ContactsControl::QueryContactByRawContactIds(
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, std::vector<std::string> &columns,
+    const std::vector<std::string> &rawContactIds)
+{
+    HILOG_INFO("ContactsControl::QueryContactByRawContactIds is start, size %{public}zu", rawContactIds.size());
+    std::shared_ptr<DataShare::DataShareResultSet> resultSet;
+    OHOS::Uri uriContact("datashare:///com.ohos.contactsdataability/contacts/raw_contact");
+    DataShare::DataSharePredicates predicates;
+    predicates.In("id", rawContactIds);
+    resultSet = dataShareHelper->Query(uriContact, predicates, columns);
+    return resultSet;
+}
+
 std::string ContactsControl::QueryAppGroupDir(std::shared_ptr<DataShare::DataShareHelper> dataShareHelper)
 {
     HILOG_INFO("ContactsControl::QueryAppGroupDir is start");
@@ -196,12 +209,60 @@ std::shared_ptr<DataShare::DataShareResultSet> ContactsControl::MyCardQuery(
     return resultSet;
 }
 
-int ContactsControl::QueryCallLogCount(
+// 只判断是否存在匹配行：LIMIT 1随谓词下发到数据ability，查到第一行即停止，不统计总数
+static bool QueryFirstRowExists(const std::shared_ptr<DataShare::DataShareHelper> &dataShareHelper, OHOS::Uri &uri,
+    DataShare::DataSharePredicates &predicates, int &errorCode)
+{
+    errorCode = SUCCESS;
+    std::vector<std::string> columns{"id"};
+    predicates.Limit(1, 0);
+    auto resultSet = dataShareHelper->Query(uri, predicates, columns);
+    if (resultSet == nullptr) {
+        errorCode = ERROR;
+        return false;
+    }
+    bool exists = resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK;
+    resultSet->Close();
+    return exists;
+}
+
+bool ContactsControl::ContactDataExists(
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, DataShare::DataSharePredicates predicates)
+{
+    OHOS::Uri uriContactData("datashare:///com.ohos.contactsdataability/contacts/contact_data");
+    int errorCode = SUCCESS;
+    return QueryFirstRowExists(dataShareHelper, uriContactData, predicates, errorCode);
+}
+
+bool ContactsControl::MyCardExists(
+    std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, DataShare::DataSharePredicates predicates)
+{
+    int errorCode = SUCCESS;
+    DataShare::DataSharePredicates profilePredicates = predicates;
+    OHOS::Uri uriProfileContact("datashare:///com.ohos.contactsdataability/profile/contact_data");
+    if (QueryFirstRowExists(dataShareHelper, uriProfileContact, profilePredicates, errorCode)) {
+        HILOG_INFO("ContactsControl::MyCardExists profile");
+        return true;
+    }
+    OHOS::Uri uriContactsContactData("datashare:///com.ohos.contactsdataability/contacts/contact_data");
+    predicates.EqualTo("primary_contact", "1");
+    return QueryFirstRowExists(dataShareHelper, uriContactsContactData, predicates, errorCode);
+}
+
+/**
+ * @brief Check whether any call log matches the predicates
+ *
+ * @param dataShareHelper Helper connected to the call log ability
+ * @param predicates Conditions of the call logs to match
+ *
+ * @return 1 if a call log matches, 0 if none, an error code otherwise
+ */
+int ContactsControl::QueryCallLogExists(
     std::shared_ptr<DataShare::DataShareHelper> dataShareHelper, const DataShare::DataSharePredicates &predicates)
 {
-    HILOG_INFO("QueryCallLogCount start");
+    HILOG_INFO("QueryCallLogExists start");
     if (dataShareHelper == nullptr) {
-        HILOG_ERROR("QueryCallLogCount query dataShareHelper is nullptr");
+        HILOG_ERROR("QueryCallLogExists query dataShareHelper is nullptr");
         return ERROR;
     }
     ContactsTelephonyPermission permission;
@@ -211,31 +272,18 @@ int ContactsControl::QueryCallLogCount(
     } else if (permission.CheckPermission(ContactsApi::Permission::CHECK_CALL_LOG)) {
         uri = OHOS::Uri("datashare:///com.ohos.calllogcheckability/calls/calllog");
     } else {
-        HILOG_ERROR("QueryCallLogCount query permission denied");
+        HILOG_ERROR("QueryCallLogExists query permission denied");
         return RDB_PERMISSION_ERROR;
     }
-    std::vector<std::string> columns{"COUNT(*)"};
-    auto resultSet = dataShareHelper->Query(uri, predicates, columns);
-    if (resultSet == nullptr) {
-        HILOG_ERROR("QueryCallLogCount query result is nullptr");
-        return ERROR;
+    DataShare::DataSharePredicates existsPredicates = predicates;
+    int errorCode = SUCCESS;
+    bool exists = QueryFirstRowExists(dataShareHelper, uri, existsPredicates, errorCode);
+    if (errorCode != SUCCESS) {
+        HILOG_ERROR("QueryCallLogExists query result is nullptr");
+        return errorCode;
     }
-    if (resultSet->GoToFirstRow() != 0) {
-        HILOG_ERROR("QueryCallLogCount query result is empty");
-        resultSet->Close();
-        return ERROR;
-    }
-    int callLogCount = 0;
-    auto ret = resultSet->GetInt(0, callLogCount);
-    if (ret != SUCCESS) {
-        HILOG_ERROR("QueryCallLogCount get callLogCount failed");
-        resultSet->Close();
-        return ERROR;
-    }
-    HILOG_WARN("QueryCallLogCount query call log count: %{private}d", callLogCount);
-    resultSet->Close();
-    HILOG_INFO("QueryCallLogCount end");
-    return callLogCount;
+    HILOG_INFO("QueryCallLogExists end, exists: %{public}d", exists);
+    return exists ? 1 : 0;
 }
 
 int ContactsControl::OpenFileByDataShare(const std::string &fileName,
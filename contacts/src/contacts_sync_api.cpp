@@ -22,6 +22,7 @@
 #include "contacts_api.h"
 #include "contacts_napi_common.h"
 #include "contacts_napi_utils.h"
+#include "datashare_helper_pool.h"
 #include "hilog_wrapper_api.h"
 #include "result_convert.h"
 #include "sync_json_helper.h"
@@ -298,6 +299,10 @@ static napi_value RejectSyncWithError(napi_env env, ExecuteHelper *executeHelper
     executeHelper->resultData = errorCode;
     napi_value error;
     HandleSyncContactsErrorCode(env, executeHelper, error);
+    if (executeHelper->dataShareHelper != nullptr) {
+        DataShareHelperPool::GetInstance().Release(executeHelper->dataShareHelper, false);
+        executeHelper->dataShareHelper = nullptr;
+    }
     delete executeHelper;
     napi_throw(env, error);
     return error;
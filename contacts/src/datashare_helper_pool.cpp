@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "datashare_helper_pool.h"
+
+#include <algorithm>
+
+#include "hilog_wrapper_api.h"
+
+namespace OHOS {
+namespace ContactsApi {
+DataShareHelperPool &DataShareHelperPool::GetInstance()
+{
+    static DataShareHelperPool instance;
+    return instance;
+}
+
+/**
+ * @brief Get a pooled dataShareHelper, connect when the context has none for the uri
+ *
+ * @param context Ability context the helper is created with
+ * @param uri Uri the helper connects to
+ *
+ * @return The dataShareHelper, nullptr if the connection failed
+ */
+std::shared_ptr<DataShare::DataShareHelper> DataShareHelperPool::Acquire(
+    const std::shared_ptr<AbilityRuntime::Context> &context, const std::string &uri)
+{
+    if (context == nullptr) {
+        return nullptr;
+    }
+    sptr<IRemoteObject> token = context->GetToken();
+    std::vector<std::shared_ptr<DataShare::DataShareHelper>> released;
+    std::shared_ptr<DataShare::DataShareHelper> pooled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SweepLocked(released);
+        pooled = AcquireLocked(token.GetRefPtr(), uri);
+    }
+    ReleaseHelpers(released);
+    if (pooled != nullptr) {
+        return pooled;
+    }
+    // 连接数据ability耗时较长，不持有池锁，避免阻塞其他上下文的Acquire和Release
+    std::shared_ptr<DataShare::DataShareHelper> helper = DataShare::DataShareHelper::Creator(token, uri);
+    if (helper == nullptr) {
+        HILOG_ERROR("DataShareHelperPool Acquire Creator failed");
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 连接期间其他调用已为同一上下文建立了helper时复用该helper，释放本次新建的连接
+        pooled = AcquireLocked(token.GetRefPtr(), uri);
+        if (pooled == nullptr) {
+            Entry entry;
+            entry.context = context;
+            entry.token = token.GetRefPtr();
+            entry.uri = uri;
+            entry.helper = helper;
+            entry.refCount = 1;
+            entries_.push_back(std::move(entry));
+            HILOG_INFO("DataShareHelperPool Acquire connected, pool size %{public}zu", entries_.size());
+            return helper;
+        }
+    }
+    helper->Release();
+    return pooled;
+}
+
+/**
+ * @brief Return a dataShareHelper got from Acquire
+ *
+ * @param helper The dataShareHelper to return
+ * @param isBroken Whether the operation failed, the helper is not reused then
+ */
+void DataShareHelperPool::Release(const std::shared_ptr<DataShare::DataShareHelper> &helper, bool isBroken)
+{
+    if (helper == nullptr) {
+        return;
+    }
+    std::vector<std::shared_ptr<DataShare::DataShareHelper>> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(entries_.begin(), entries_.end(), [&helper](const Entry &entry) {
+            return entry.helper == helper;
+        });
+        // FA模型的helper不经过池，直接释放
+        if (it == entries_.end()) {
+            released.push_back(helper);
+        } else {
+            it->refCount = it->refCount > 0 ? it->refCount - 1 : 0;
+            if (isBroken && !it->retired) {
+                HILOG_WARN("DataShareHelperPool Release retire helper after failure");
+                it->retired = true;
+            }
+            SweepLocked(released);
+        }
+    }
+    ReleaseHelpers(released);
+}
+
+// 取同一上下文和uri下可复用的helper并增加引用计数，没有时返回nullptr
+std::shared_ptr<DataShare::DataShareHelper> DataShareHelperPool::AcquireLocked(
+    const IRemoteObject *token, const std::string &uri)
+{
+    for (auto &entry : entries_) {
+        if (!entry.retired && entry.token == token && entry.uri == uri) {
+            entry.refCount++;
+            return entry.helper;
+        }
+    }
+    return nullptr;
+}
+
+// 移出已失效且无人使用的helper，由调用方在释放池锁后Release；上下文已销毁但仍在使用的helper先标记失效，
+// 不再分配给新的调用
+void DataShareHelperPool::SweepLocked(std::vector<std::shared_ptr<DataShare::DataShareHelper>> &released)
+{
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->context.expired()) {
+            it->retired = true;
+        }
+        if (!it->retired || it->refCount > 0) {
+            ++it;
+            continue;
+        }
+        released.push_back(it->helper);
+        it = entries_.erase(it);
+    }
+}
+
+// 断开连接涉及跨进程调用，不在池锁内执行
+void DataShareHelperPool::ReleaseHelpers(const std::vector<std::shared_ptr<DataShare::DataShareHelper>> &helpers)
+{
+    for (const auto &helper : helpers) {
+        helper->Release();
+    }
+}
+} // namespace ContactsApi
+} // namespace OHOS
@@ -23,6 +23,7 @@
 #include "want.h"
 
 #include "calllog_database.h"
+#include "uri_utils.h"
 
 namespace OHOS {
 namespace AbilityRuntime {
@@ -47,7 +48,8 @@ private:
     static std::shared_ptr<Contacts::CallLogDataBase> callLogDataBase_;
     static std::map<std::string, int> uriValueMap_;
     int UriParse(Uri &uri);
-    std::string UriParseBatchParam(Uri &uri);
+    // 返回值引用uriString，使用期间uriString须保持有效
+    static Contacts::UriInfo ParseUri(const std::string &uriString);
     int InsertExecute(const Uri &uri, const OHOS::NativeRdb::ValuesBucket &value);
     void DataBaseNotifyChange(int code, Uri uri);
     bool IsBeginTransactionOK(int code, std::mutex &mutex);
@@ -18,6 +18,9 @@
 
 #include <pthread.h>
 #include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "datashare_result_set.h"
 #include "rdb_open_callback.h"
 #include "rdb_predicates.h"
@@ -38,12 +41,19 @@ enum DatabaseStoragePath {
     EL4,
     EL5
 };
+// 通话号码匹配到的联系人信息，写入通话记录的display_name、quicksearch_key和头像
+struct CallLogCallerInfo {
+    std::string name;
+    std::string quickSearchKey;
+    std::string meetimeAvatar;
+};
+
 class CallLogDataBase {
 public:
     static std::shared_ptr<CallLogDataBase> GetInstance();
     static std::shared_ptr<OHOS::NativeRdb::RdbStore> store_;
     int64_t InsertCallLog(OHOS::NativeRdb::ValuesBucket insertValues);
-    int64_t BatchInsertCallLog(const std::vector<OHOS::NativeRdb::ValuesBucket> &values);
+    int64_t BatchInsertCallLog(std::vector<OHOS::NativeRdb::ValuesBucket> values);
     int UpdateCallLog(OHOS::NativeRdb::ValuesBucket values, OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     int DeleteCallLog(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     std::shared_ptr<OHOS::NativeRdb::ResultSet> Query(
@@ -55,7 +65,7 @@ public:
         std::string operateTable = CallsTableName::CALLLOG);
     void GetContactInfoEnhanced(std::string phoneNumber, OHOS::NativeRdb::ValuesBucket &insertValues,
         std::string operateTable);
-    std::string QueryContactsByCallsGetSubPhoneNumberSql(std::string subPhoneNumber);
+    std::string QueryContactsByCallsGetSubPhoneNumberSql();
     void QueryContactsByCallsInsertValues(OHOS::NativeRdb::ValuesBucket &insertValues, std::string name,
         std::string quickSearchKey, std::string meetimeAvatar, std::string operateTable);
     std::string QueryContactsByInsertCallsGetSql();
@@ -69,10 +79,15 @@ private:
     const CallLogDataBase &operator=(const CallLogDataBase &);
     static std::shared_ptr<CallLogDataBase> callLogDataBase_;
     static std::shared_ptr<DataShare::DataShareHelper> dataShareCallLogHelper_;
+    static void PushCallLogChangeTime(time_t changeTime);
     int UpdateTopContact(OHOS::NativeRdb::ValuesBucket &insertValues);
     bool MoveDbFile();
     int UpdateContactedStatus(OHOS::NativeRdb::ValuesBucket &insertValues);
     int GetCallerIndex(std::shared_ptr<DataShare::DataShareResultSet> resultSet, std::string phoneNumber);
+    bool QueryCallerInfoEnhanced(const std::string &phoneNumber, CallLogCallerInfo &callerInfo);
+    void EnrichCallLogsByContacts(std::vector<OHOS::NativeRdb::ValuesBucket> &values);
+    void QueryCallerInfosByNumbers(const std::vector<std::string> &phoneNumbers,
+        std::unordered_map<std::string, CallLogCallerInfo> &callerInfos);
     int DeleteEL1CallLog(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     std::shared_ptr<OHOS::NativeRdb::ResultSet> QueryEL1(
         OHOS::NativeRdb::RdbPredicates &rdbPredicates, std::vector<std::string> columns);
@@ -124,6 +139,8 @@ private:
     int UpgradeToV26(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int UpgradeV27(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int UpgradeToV27(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
+    int UpgradeToV28(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
+    int UpgradeToV29(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int AddColumnAbs(OHOS::NativeRdb::RdbStore &store);
     int AddColumnNotes(OHOS::NativeRdb::RdbStore &store);
     int Commit(OHOS::NativeRdb::RdbStore &store);
@@ -30,12 +30,12 @@ public:
     virtual std::shared_ptr<DataShare::DataShareResultSet> Query(const Uri &uri,
         const DataShare::DataSharePredicates &predicates, std::vector<std::string> &columns,
         DataShare::DatashareBusinessError &businessError) override;
+    static void AddQueryNotPrivacyCondition(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
 
 private:
     static std::shared_ptr<Contacts::CallLogDataBase> callLogDataBase_;
     static std::map<std::string, int> uriValueMap_;
     int UriParse(Uri &uri);
-    void AddQueryNotPrivacyCondition(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
 };
 } // namespace AbilityRuntime
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #include "calllog_ability.h"
 
 #include <mutex>
+#include <utility>
 
 #include "board_report_util.h"
 #include "common.h"
@@ -87,21 +88,15 @@ void CallLogAbility::OnStart(const Want &want)
 
 int CallLogAbility::UriParse(Uri &uri)
 {
-    Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uri, uriValueMap_);
-    return parseCode;
+    std::string uriString = uri.ToString();
+    return ParseUri(uriString).code;
 }
 
-std::string CallLogAbility::UriParseBatchParam(Uri &uri)
+Contacts::UriInfo CallLogAbility::ParseUri(const std::string &uriString)
 {
+    static const Contacts::UriRouteTable routeTable(uriValueMap_);
     Contacts::UriUtils uriUtils;
-    std::string isFromBatch;
-    std::map<std::string, std::string> mapParams;
-    mapParams = uriUtils.getQueryParameter(uri);
-    if (!mapParams.empty()) {
-        isFromBatch = mapParams["isFromBatch"];
-    }
-    return isFromBatch;
+    return uriUtils.ParseUri(uriString, routeTable);
 }
 
 /**
@@ -281,12 +276,11 @@ int CallLogAbility::BatchInsert(const Uri &uri, const std::vector<DataShare::Dat
         HILOG_ERROR("BatchInsert value is error");
         return rowRet;
     }
-    OHOS::Uri uriTemp = uri;
+    std::string uriString = uri.ToString();
     std::vector<DataShare::DataShareValuesBucket> insertValues = values;
-    std::string isFromBatch = UriParseBatchParam(uriTemp);
-    if (isFromBatch == "true") {
+    if (ParseUri(uriString).isFromBatch == "true") {
         std::vector<DataShare::DataShareValuesBucket> unprocessedValues;
-        if (uri.ToString().find("isPrivacy") == std::string::npos) {
+        if (uriString.find("isPrivacy") == std::string::npos) {
             Contacts::PrivacyContactsManager::GetInstance()->ProcessPrivacyCallLog(insertValues, unprocessedValues);
         } else {
             unprocessedValues = insertValues;
@@ -326,7 +320,7 @@ int CallLogAbility::BatchInsertByMigrate(const Uri &uri, const std::vector<DataS
     }
     g_mutex.lock();
     callLogDataBase_ = Contacts::CallLogDataBase::GetInstance();
-    int code = callLogDataBase_->BatchInsertCallLog(batchInsertValues);
+    int code = callLogDataBase_->BatchInsertCallLog(std::move(batchInsertValues));
     g_mutex.unlock();
     DataBaseNotifyChange(Contacts::CONTACT_INSERT, uri);
     HILOG_INFO("CallLogAbility BatchInsertByMigrate end, ts = %{public}lld", (long long) time(NULL));
@@ -445,8 +439,7 @@ std::shared_ptr<DataShare::DataShareResultSet> CallLogAbility::Query(const Uri &
     Contacts::PredicatesConvert predicatesConvert;
     std::shared_ptr<OHOS::NativeRdb::ResultSet> result;
     OHOS::Uri uriTemp = uri;
-    Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uriTemp, uriValueMap_);
+    int parseCode = UriParse(uriTemp);
     DataShare::DataSharePredicates dataSharePredicates = predicates;
     OHOS::NativeRdb::RdbPredicates rdbPredicates("");
     std::vector<std::string> columnsTemp = columns;
@@ -514,10 +507,10 @@ void CallLogAbility::AddQueryNotPrivacyCondition(OHOS::NativeRdb::RdbPredicates
     std::string whereSql = rdbPredicates.GetWhereClause();
     if (whereSql.find(Contacts::CallLogColumns::PRIVACY_TAG) == std::string::npos) {
         HILOG_INFO("query calllog, not has privacy_tag conditoin, add condition, ts = %{public}lld", (long long) time(NULL));
-        // 不存在是否隐私记录条件，需要设置为非隐私
-        rdbPredicates.And();
-        rdbPredicates.NotEqualTo(
-            Contacts::CallLogColumns::PRIVACY_TAG, static_cast<int32_t>(Contacts::PrivacyTag::CALL_LOG_PRIVACY_TAG));
+        // 不存在是否隐私记录条件，需要设置为非隐私；原条件加括号，避免OR与追加的AND优先级错误
+        // 以字面量追加，与calllog_begin_time_not_privacy_index部分索引的条件一致
+        std::string notPrivacy = Contacts::CALL_LOG_NOT_PRIVACY_CONDITION;
+        rdbPredicates.SetWhereClause(whereSql.empty() ? notPrivacy : "(" + whereSql + ") AND " + notPrivacy);
     }
 }
 } // namespace AbilityRuntime
@@ -15,6 +15,8 @@
 
 #include "calllog_database.h"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <cstdio>
@@ -31,9 +33,12 @@
 #include "datashare_log.h"
 #include "datashare_errno.h"
 #include "async_task.h"
+#include "change_notify_coalescer.h"
+#include "delay_async_task.h"
 #include "rdb_store_config.h"
 #include "security_label.h"
 #include "sql_analyzer.h"
+#include "sql_statement_cache.h"
 #include "predicates_convert.h"
 #include "contacts_common_event.h"
 #include "calllog_manager.h"
@@ -54,6 +59,28 @@ namespace {
 std::mutex g_mutex;
 std::mutex g_resourcemutex_;
 std::mutex g_mtx;
+// 通话记录变更时间的合并间隔，距上次写入不足一个间隔的通知由延迟任务统一写入最新时间
+constexpr int64_t CALLLOG_CHANGE_NOTIFY_INTERVAL_MS = DelayAsyncTask::DEFAULT_DELAY_MS;
+const std::string CALLLOG_CHANGE_FLUSH_TASK_KEY = "calllog-change-time";
+
+// 批量插入时每次查询联系人的号码个数，号码集合作为一个JSON数组参数传入
+constexpr size_t CALLER_LOOKUP_BATCH_SIZE = 1000;
+
+// 从firstColumn起依次为display_name、contact_id、company、position、extra3
+// 名称按display_name->company->position的顺序取第一个非空值
+template <typename ResultSetType>
+void ReadCallerInfo(ResultSetType &resultSet, int firstColumn, CallLogCallerInfo &callerInfo)
+{
+    resultSet.GetString(firstColumn + INDEX_ZERO, callerInfo.name);
+    resultSet.GetString(firstColumn + INDEX_ONE, callerInfo.quickSearchKey);
+    if (callerInfo.name.empty()) {
+        resultSet.GetString(firstColumn + INDEX_TWO, callerInfo.name);
+    }
+    if (callerInfo.name.empty()) {
+        resultSet.GetString(firstColumn + INDEX_THREE, callerInfo.name);
+    }
+    resultSet.GetString(firstColumn + INDEX_FOUR, callerInfo.meetimeAvatar);
+}
 }
 std::shared_ptr<CallLogDataBase> CallLogDataBase::callLogDataBase_ = nullptr;
 std::shared_ptr<OHOS::NativeRdb::RdbStore> CallLogDataBase::store_ = nullptr;
@@ -236,9 +263,16 @@ int SqliteOpenHelperCallLogCallback::OnCreate(OHOS::NativeRdb::RdbStore &store)
     judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_PHONE_NUMBER_INDEX));
     judgeSuccess.push_back(store.ExecuteSql(CREATE_CALL_SETTINGS));
     judgeSuccess.push_back(store.ExecuteSql(INIT_CALLlOG_CHANGE_TIME));
+    judgeSuccess.push_back(store.ExecuteSql(CREATE_NUMBER_AVATAR));
     judgeSuccess.push_back(store.ExecuteSql(UPDATE_CALLLOG_AVATAR));
+    judgeSuccess.push_back(store.ExecuteSql(INSERT_NUMBER_AVATAR));
+    judgeSuccess.push_back(store.ExecuteSql(UPDATE_NUMBER_AVATAR));
+    judgeSuccess.push_back(store.ExecuteSql(DELETE_NUMBER_AVATAR));
     judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_FAIL_ABS_RECORD_ID_INDEX));
     judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_NOTES_ID_INDEX));
+    judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_BEGIN_TIME_NOT_PRIVACY_INDEX));
+    judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_FORMAT_PHONE_NUMBER_BEGIN_TIME_INDEX));
+    judgeSuccess.push_back(store.ExecuteSql(CALL_LOG_MISSED_UNREAD_INDEX));
     unsigned int size = judgeSuccess.size();
     for (unsigned int i = 0; i < size; i++) {
         int ret = judgeSuccess[i];
@@ -335,6 +369,22 @@ int SqliteOpenHelperCallLogCallback::UpgradeV27(OHOS::NativeRdb::RdbStore &store
             return result;
         }
     }
+    if (oldVersion < DATABASE_VERSION_28 && newVersion >= DATABASE_VERSION_28) {
+        result = UpgradeToV28(store, oldVersion, newVersion);
+        if (result != OHOS::NativeRdb::E_OK) {
+            BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, CALLS_DB_NAME, result,
+                                                      "UpgradeToV28 fail");
+            return result;
+        }
+    }
+    if (oldVersion < DATABASE_VERSION_29 && newVersion >= DATABASE_VERSION_29) {
+        result = UpgradeToV29(store, oldVersion, newVersion);
+        if (result != OHOS::NativeRdb::E_OK) {
+            BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, CALLS_DB_NAME, result,
+                                                      "UpgradeToV29 fail");
+            return result;
+        }
+    }
     return result;
 }
 
@@ -612,6 +662,63 @@ int SqliteOpenHelperCallLogCallback::UpgradeToV27(OHOS::NativeRdb::RdbStore &sto
     return OHOS::NativeRdb::E_OK;
 }
 
+// 头像传播改为查number_avatar表，回填已有通话记录的头像
+int SqliteOpenHelperCallLogCallback::UpgradeToV28(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+{
+    HILOG_INFO("UpgradeToV28 oldVersion is %{public}d , newVersion is %{public}d", oldVersion, newVersion);
+    if (oldVersion >= newVersion) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    if (store.BeginTransaction() != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV28 BeginTransaction failed");
+        return OHOS::NativeRdb::E_ERROR;
+    }
+    const std::vector<std::string> statements = {CREATE_NUMBER_AVATAR, INIT_NUMBER_AVATAR,
+        "DROP TRIGGER IF EXISTS update_calllog_avatar", UPDATE_CALLLOG_AVATAR, INSERT_NUMBER_AVATAR,
+        UPDATE_NUMBER_AVATAR, DELETE_NUMBER_AVATAR};
+    for (const auto &sql : statements) {
+        if (!ExecuteAndCheck(store, sql)) {
+            HILOG_ERROR("UpgradeToV28 create number_avatar failed");
+            return OHOS::NativeRdb::E_ERROR;
+        }
+    }
+    if (Commit(store) != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV28 Commit failed");
+        RollBack(store);
+        return OHOS::NativeRdb::E_ERROR;
+    }
+    HILOG_INFO("calllog UpgradeToV28 succeed.");
+    return OHOS::NativeRdb::E_OK;
+}
+
+// 通话记录列表、单号码记录、未接来电查询的索引
+int SqliteOpenHelperCallLogCallback::UpgradeToV29(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+{
+    HILOG_INFO("UpgradeToV29 oldVersion is %{public}d , newVersion is %{public}d", oldVersion, newVersion);
+    if (oldVersion >= newVersion) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    if (store.BeginTransaction() != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV29 BeginTransaction failed");
+        return OHOS::NativeRdb::E_ERROR;
+    }
+    const std::vector<std::string> statements = {CALL_LOG_BEGIN_TIME_NOT_PRIVACY_INDEX,
+        CALL_LOG_FORMAT_PHONE_NUMBER_BEGIN_TIME_INDEX, CALL_LOG_MISSED_UNREAD_INDEX};
+    for (const auto &sql : statements) {
+        if (!ExecuteAndCheck(store, sql)) {
+            HILOG_ERROR("UpgradeToV29 create index failed");
+            return OHOS::NativeRdb::E_ERROR;
+        }
+    }
+    if (Commit(store) != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV29 Commit failed");
+        RollBack(store);
+        return OHOS::NativeRdb::E_ERROR;
+    }
+    HILOG_INFO("calllog UpgradeToV29 succeed.");
+    return OHOS::NativeRdb::E_OK;
+}
+
 // 升级到27版本需要添加的字段
 int SqliteOpenHelperCallLogCallback::AddColumnAbs(OHOS::NativeRdb::RdbStore &store)
 {
@@ -899,13 +1006,16 @@ void CallLogDataBase::PrintCallInfoLog(OHOS::NativeRdb::ValuesBucket insertValue
 }
 
 /**
- * @brief InsertCallLog operation
+ * @brief BatchInsertCallLog operation, used by migration and restore
  *
- * @param insertValues Conditions for update operation
+ * The rows are linked to contacts first, every distinct number is looked up once, then all rows are inserted
+ * in one transaction.
  *
- * @return InsertCallLog operation results
+ * @param values Call log rows to insert
+ *
+ * @return BatchInsertCallLog operation results
  */
-int64_t CallLogDataBase::BatchInsertCallLog(const std::vector<OHOS::NativeRdb::ValuesBucket> &values)
+int64_t CallLogDataBase::BatchInsertCallLog(std::vector<OHOS::NativeRdb::ValuesBucket> values)
 {
     int64_t outRowId = RDB_EXECUTE_FAIL;
     if (store_ == nullptr) {
@@ -914,16 +1024,139 @@ int64_t CallLogDataBase::BatchInsertCallLog(const std::vector<OHOS::NativeRdb::V
             "BatchInsertCallLog store is nullptr");
         return RDB_OBJECT_EMPTY;
     }
+    EnrichCallLogsByContacts(values);
+    if (BeginTransaction() != OHOS::NativeRdb::E_OK) {
+        BoardReportUtil::InsertCallLogReport(ExecuteResult::FAIL, "", values.size(),
+            "BatchInsertCallLog BeginTransaction fail");
+        return RDB_EXECUTE_FAIL;
+    }
     int ret = store_->BatchInsert(outRowId, CallsTableName::CALLLOG, values);
     if (ret != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR("CallLogDataBase BatchInsertCallLog ret :%{public}d", ret);
+        RollBack();
         BoardReportUtil::InsertCallLogReport(ExecuteResult::FAIL, "", values.size(), "BatchInsertCallLog is fail");
         return RDB_EXECUTE_FAIL;
     }
+    if (Commit() != OHOS::NativeRdb::E_OK) {
+        RollBack();
+        BoardReportUtil::InsertCallLogReport(ExecuteResult::FAIL, "", values.size(),
+            "BatchInsertCallLog Commit fail");
+        return RDB_EXECUTE_FAIL;
+    }
     BoardReportUtil::InsertCallLogReport(ExecuteResult::SUCCESS, "", values.size(), "BatchInsertCallLog success");
     return outRowId;
 }
 
+/**
+ * @brief Fill display_name, quicksearch_key and avatar of batch inserted call logs from the matched contacts
+ *
+ * Same match as QueryContactsByInsertCalls, but each distinct number of the batch is resolved once and exact
+ * matches are queried CALLER_LOOKUP_BATCH_SIZE numbers at a time. Rows without a match keep their values.
+ * contacted_count is not touched, restored contacts bring their own.
+ *
+ * @param values Call log rows to insert
+ */
+void CallLogDataBase::EnrichCallLogsByContacts(std::vector<OHOS::NativeRdb::ValuesBucket> &values)
+{
+    std::unordered_map<std::string, std::vector<size_t>> rowsByNumber;
+    for (size_t i = 0; i < values.size(); i++) {
+        OHOS::NativeRdb::ValueObject value;
+        if (!values[i].GetObject(CallLogColumns::PHONE_NUMBER, value)) {
+            continue;
+        }
+        std::string phoneNumber;
+        value.GetString(phoneNumber);
+        if (!phoneNumber.empty()) {
+            rowsByNumber[phoneNumber].push_back(i);
+        }
+    }
+    if (rowsByNumber.empty()) {
+        return;
+    }
+    std::unordered_map<std::string, CallLogCallerInfo> callerInfos;
+    std::vector<std::string> exactNumbers;
+    exactNumbers.reserve(rowsByNumber.size());
+    for (const auto &entry : rowsByNumber) {
+#ifdef ABILITY_CUST_SUPPORT
+        // 与单条插入一致，七位及以上的号码走增强匹配，按号码逐个查询
+        unsigned int subPhoneNumberLength = 7;
+        if (entry.first.length() >= subPhoneNumberLength) {
+            CallLogCallerInfo callerInfo;
+            if (QueryCallerInfoEnhanced(entry.first, callerInfo)) {
+                callerInfos.emplace(entry.first, std::move(callerInfo));
+            }
+            continue;
+        }
+#endif
+        exactNumbers.push_back(entry.first);
+    }
+    QueryCallerInfosByNumbers(exactNumbers, callerInfos);
+    size_t linkedRows = 0;
+    for (const auto &entry : rowsByNumber) {
+        auto callerInfo = callerInfos.find(entry.first);
+        if (callerInfo == callerInfos.end()) {
+            continue;
+        }
+        for (size_t row : entry.second) {
+            QueryContactsByCallsInsertValues(values[row], callerInfo->second.name, callerInfo->second.quickSearchKey,
+                callerInfo->second.meetimeAvatar, CallsTableName::CALLLOG);
+        }
+        linkedRows += entry.second.size();
+    }
+    HILOG_INFO("EnrichCallLogsByContacts rows:%{public}zu, numbers:%{public}zu, matched:%{public}zu, "
+               "linkedRows:%{public}zu",
+        values.size(), rowsByNumber.size(), callerInfos.size(), linkedRows);
+}
+
+/**
+ * @brief Exactly match phone numbers to contacts, the first raw contact of a number wins
+ *
+ * @param phoneNumbers Distinct phone numbers
+ * @param callerInfos Matched contact info by phone number
+ */
+void CallLogDataBase::QueryCallerInfosByNumbers(const std::vector<std::string> &phoneNumbers,
+    std::unordered_map<std::string, CallLogCallerInfo> &callerInfos)
+{
+    static std::shared_ptr<ContactsDataBase> contactsDataBase = ContactsDataBase::GetInstance();
+    if (phoneNumbers.empty() || contactsDataBase == nullptr || contactsDataBase->contactStore_ == nullptr) {
+        return;
+    }
+    ContactsType contactsType;
+    std::string typeId =
+        std::to_string(contactsType.LookupTypeId(contactsDataBase->contactStore_, ContentTypeData::PHONE));
+    // 与QueryContactsByInsertCallsGetSql的匹配条件相同，按号码分组取最小的raw_contact_id
+    static const std::string querySql = std::string("SELECT matched.detail_info, raw.display_name, raw.contact_id, "
+        "raw.company, raw.position, raw.extra3 FROM ") + ContactTableName::RAW_CONTACT +
+        " AS raw JOIN (SELECT detail_info, min(raw_contact_id) AS raw_contact_id FROM " + ViewName::VIEW_CONTACT_DATA +
+        " WHERE primary_contact != 1 AND detail_info IN (SELECT value FROM json_each(?))"
+        " AND is_deleted = 0 AND type_id = ? GROUP BY detail_info) AS matched"
+        " ON raw.id = matched.raw_contact_id WHERE raw.is_deleted = 0";
+    SqlStatementCache *statementCache = SqlStatementCache::GetInstance();
+    for (size_t start = 0; start < phoneNumbers.size(); start += CALLER_LOOKUP_BATCH_SIZE) {
+        size_t end = std::min(start + CALLER_LOOKUP_BATCH_SIZE, phoneNumbers.size());
+        std::vector<std::string> chunk(phoneNumbers.begin() + start, phoneNumbers.begin() + end);
+        std::vector<std::string> args;
+        args.push_back(SqlStatementCache::ToJsonArray(chunk));
+        args.push_back(typeId);
+        auto resultSet = statementCache->QuerySql(
+            contactsDataBase->contactStore_, SqlTemplateId::CALLER_INFOS_BY_NUMBERS, querySql, args);
+        if (resultSet == nullptr) {
+            HILOG_ERROR("QueryCallerInfosByNumbers QuerySqlResult is nullptr");
+            return;
+        }
+        int resultSetNum = resultSet->GoToFirstRow();
+        while (resultSetNum == OHOS::NativeRdb::E_OK) {
+            std::string phoneNumber;
+            resultSet->GetString(INDEX_ZERO, phoneNumber);
+            CallLogCallerInfo callerInfo;
+            ReadCallerInfo(*resultSet, INDEX_ONE, callerInfo);
+            callerInfos.emplace(phoneNumber, std::move(callerInfo));
+            resultSetNum = resultSet->GoToNextRow();
+        }
+        resultSet->Close();
+    }
+}
+
 /**
  * @brief UpdateCallLog operation
  *
@@ -1091,22 +1324,45 @@ void CallLogDataBase::GetContactInfoEnhanced(std::string phoneNumber, OHOS::Nati
     std::string operateTable)
 {
     HILOG_INFO("GetContactInfoEnhanced resultId begin, ts = %{public}lld", (long long) time(NULL));
+    CallLogCallerInfo callerInfo;
+    if (QueryCallerInfoEnhanced(phoneNumber, callerInfo)) {
+        QueryContactsByCallsInsertValues(insertValues, callerInfo.name, callerInfo.quickSearchKey,
+            callerInfo.meetimeAvatar, operateTable);
+    }
+    UpdateTopContact(insertValues);
+    UpdateContactedStatus(insertValues);
+}
+
+/**
+ * @brief Match a number to a contact by its last seven digits, the candidate is picked by GetCallerIndex
+ *
+ * @param phoneNumber Phone number, at least seven digits
+ * @param callerInfo Matched contact info
+ *
+ * @return true if a contact matched
+ */
+bool CallLogDataBase::QueryCallerInfoEnhanced(const std::string &phoneNumber, CallLogCallerInfo &callerInfo)
+{
     unsigned int subPhoneNumberLength = 7;
     std::string subPhoneNumber = phoneNumber.substr(phoneNumber.size() - subPhoneNumberLength, subPhoneNumberLength);
-    std::string sql = QueryContactsByCallsGetSubPhoneNumberSql(subPhoneNumber);
     static std::shared_ptr<ContactsDataBase> contactsDataBase = ContactsDataBase::GetInstance();
     if (contactsDataBase == nullptr || contactsDataBase->contactStore_ == nullptr) {
         HILOG_ERROR("GetContactInfoEnhanced ContactsDataBase is nullptr or ContactsDataBase->contactStore_ is nullptr");
-        return;
+        return false;
     }
-    auto resultSet = contactsDataBase->contactStore_->QuerySql(sql);
+    static const std::string querySql = QueryContactsByCallsGetSubPhoneNumberSql();
+    std::vector<std::string> args;
+    args.push_back("%" + subPhoneNumber);
+    auto resultSet = SqlStatementCache::GetInstance()->QuerySql(
+        contactsDataBase->contactStore_, SqlTemplateId::CALLER_INFO_ENHANCED, querySql, args);
     if (resultSet == nullptr) {
         HILOG_ERROR("GetContactInfoEnhanced QuerySqlResult is nullptr");
-        return;
+        return false;
     }
     int rowCount = 0;
     resultSet->GetRowCount(rowCount);
     HILOG_INFO("GetContactInfoEnhanced resultSetCount = %{public}d, ts = %{public}lld", rowCount, (long long) time(NULL));
+    bool matched = false;
     if (rowCount > 0) {
         auto queryResultSet = RdbDataShareAdapter::RdbUtils::ToResultSetBridge(resultSet);
         std::shared_ptr<DataShare::DataShareResultSet> sharedPtrResult =
@@ -1114,28 +1370,13 @@ void CallLogDataBase::GetContactInfoEnhanced(std::string phoneNumber, OHOS::Nati
         int resultId = this->GetCallerIndex(sharedPtrResult, phoneNumber);
         if (sharedPtrResult->GoToRow(resultId) == OHOS::NativeRdb::E_OK) {
             HILOG_INFO("GetContactInfoEnhanced resultSet,ts = %{public}lld", (long long) time(NULL));
-            std::string quickSearchKey;
-            std::string name;
-            std::string meetimeAvatar;
-            sharedPtrResult->GetString(INDEX_ZERO, name);
-            sharedPtrResult->GetString(INDEX_ONE, quickSearchKey);
-            // displayName->company->position
-            // 如果名称为空，取公司信息
-            if (name.empty()) {
-                sharedPtrResult->GetString(INDEX_TWO, name);
-            }
-            // 如果名称仍为空，取职位信息
-             if (name.empty()) {
-                 sharedPtrResult->GetString(INDEX_THREE, name);
-             }
-             sharedPtrResult->GetString(INDEX_FOUR, meetimeAvatar);
-             sharedPtrResult->Close();
-             QueryContactsByCallsInsertValues(insertValues, name, quickSearchKey, meetimeAvatar, operateTable);
+            ReadCallerInfo(*sharedPtrResult, INDEX_ZERO, callerInfo);
+            sharedPtrResult->Close();
+            matched = true;
         }
     }
     resultSet->Close();
-    UpdateTopContact(insertValues);
-    UpdateContactedStatus(insertValues);
+    return matched;
 }
 
 int CallLogDataBase::GetCallerIndex(std::shared_ptr<DataShare::DataShareResultSet> resultSet, std::string phoneNumber)
@@ -1156,12 +1397,12 @@ int CallLogDataBase::GetCallerIndex(std::shared_ptr<DataShare::DataShareResultSe
 }
 #endif
 
-std::string CallLogDataBase::QueryContactsByCallsGetSubPhoneNumberSql(std::string subPhoneNumber)
+std::string CallLogDataBase::QueryContactsByCallsGetSubPhoneNumberSql()
 {
+    // 号码后七位作为参数绑定，SQL文本固定
     std::string sql = "SELECT display_name, contact_id, company, position, extra3, format_phone_number, detail_info"
-        " FROM view_contact_data WHERE primary_contact != 1 AND detail_info LIKE '%";
-    sql.append(subPhoneNumber)
-        .append("' AND is_deleted = 0 AND type_id = 5 order by raw_contact_id ASC");
+        " FROM view_contact_data WHERE primary_contact != 1 AND detail_info LIKE ?";
+    sql.append(" AND is_deleted = 0 AND type_id = 5 order by raw_contact_id ASC");
     return sql;
 }
 
@@ -1288,7 +1529,22 @@ int CallLogDataBase::UpdateContactedStatus(OHOS::NativeRdb::ValuesBucket &insert
     return ContactsDataBase::GetInstance()->UpdateContactedStautsByPhoneNum(phone);
 }
 
+/**
+ * @brief Notify that the call log changed, updates within one interval are coalesced
+ *
+ * The first notification after an idle interval is written at once. Later ones only record the latest change
+ * time, and a delayed task writes it when the interval has passed, so a burst of missed calls costs one
+ * cross-process update per interval instead of one per record.
+ */
 void CallLogDataBase::NotifyCallLogChange()
+{
+    static std::shared_ptr<ChangeNotifyCoalescer> coalescer = std::make_shared<ChangeNotifyCoalescer>(
+        DelayAsyncTask::GetInstanceDelay1S(), CALLLOG_CHANGE_FLUSH_TASK_KEY, CALLLOG_CHANGE_NOTIFY_INTERVAL_MS,
+        PushCallLogChangeTime);
+    coalescer->Notify(time(NULL));
+}
+
+void CallLogDataBase::PushCallLogChangeTime(time_t changeTime)
 {
     HILOG_INFO("Calllog NotifyCallLogChange start. AsyncDataShareProxyTask");
     if (dataShareCallLogHelper_ == nullptr) {
@@ -1304,14 +1560,17 @@ void CallLogDataBase::NotifyCallLogChange()
     DataShare::DataSharePredicates predicates;
     predicates.EqualTo("id", 1);
     DataShare::DataShareValuesBucket valuesBucket;
-    valuesBucket.Put("calllog_change_time", time(NULL));
+    valuesBucket.Put("calllog_change_time", changeTime);
     std::unique_ptr<AsyncItem> task = std::make_unique<AsyncDataShareProxyTask>(dataShareCallLogHelper_, valuesBucket,
         predicates, proxyUri);
     if (g_asyncTaskQueue == nullptr) {
         HILOG_ERROR("NotifyCallLogChange g_asyncTaskQueue is null");
         return;
     }
-    g_asyncTaskQueue->Push(task);
+    if (!g_asyncTaskQueue->Push(task)) {
+        HILOG_ERROR("PushCallLogChangeTime push async task failed");
+        return;
+    }
     g_asyncTaskQueue->Start();
 }
 
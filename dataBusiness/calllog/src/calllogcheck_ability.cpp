@@ -90,8 +90,7 @@ std::shared_ptr<DataShare::DataShareResultSet> CallLogCheckAbility::Query(const
     Contacts::PredicatesConvert predicatesConvert;
     std::shared_ptr<OHOS::NativeRdb::ResultSet> result;
     OHOS::Uri uriTemp = uri;
-    Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uriTemp, uriValueMap_);
+    int parseCode = UriParse(uriTemp);
     DataShare::DataSharePredicates dataSharePredicates = predicates;
     OHOS::NativeRdb::RdbPredicates rdbPredicates("");
     std::vector<std::string> columnsTemp = columns;
@@ -137,9 +136,10 @@ void CallLogCheckAbility::OnStart(const Want &want)
 
 int CallLogCheckAbility::UriParse(Uri &uri)
 {
+    static const Contacts::UriRouteTable routeTable(uriValueMap_);
+    std::string uriString = uri.ToString();
     Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uri, uriValueMap_);
-    return parseCode;
+    return uriUtils.ParseUri(uriString, routeTable).code;
 }
 
 /**
@@ -151,10 +151,10 @@ void CallLogCheckAbility::AddQueryNotPrivacyCondition(OHOS::NativeRdb::RdbPredic
     std::string whereSql = rdbPredicates.GetWhereClause();
     if (whereSql.find(Contacts::CallLogColumns::PRIVACY_TAG) == std::string::npos) {
         HILOG_INFO("query calllog, not has privacy_tag conditoin, add condition");
-        // 不存在是否隐私记录条件，需要设置为非隐私
-        rdbPredicates.And();
-        rdbPredicates.NotEqualTo(
-            Contacts::CallLogColumns::PRIVACY_TAG, static_cast<int32_t>(Contacts::PrivacyTag::CALL_LOG_PRIVACY_TAG));
+        // 不存在是否隐私记录条件，需要设置为非隐私；原条件加括号，避免OR与追加的AND优先级错误
+        // 以字面量追加，与calllog_begin_time_not_privacy_index部分索引的条件一致
+        std::string notPrivacy = Contacts::CALL_LOG_NOT_PRIVACY_CONDITION;
+        rdbPredicates.SetWhereClause(whereSql.empty() ? notPrivacy : "(" + whereSql + ") AND " + notPrivacy);
     }
 }
 } // namespace AbilityRuntime
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLOUD_CHANGE_SET_H
+#define CLOUD_CHANGE_SET_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace Contacts {
+// 每个分片最多携带的uuid个数（插入、更新、删除合计）
+constexpr size_t CLOUD_CHANGE_CHUNK_MAX_ENTRIES = 1000;
+
+enum class CloudChangeType : size_t {
+    INSERT = 0,
+    UPDATE = 1,
+    DELETE = 2,
+};
+
+constexpr size_t CLOUD_CHANGE_TYPE_COUNT = 3;
+
+// 投递给js侧的一个分片，格式与原来一致："uuid;table,uuid;table"
+struct CloudChangeChunk {
+    std::string uuidToInsert;
+    std::string uuidToUpdate;
+    std::string uuidToDelete;
+    // 非空时为退账号等整体处理的通知，不携带uuid
+    std::string handleType;
+    size_t entryCount = 0;
+};
+
+/**
+ * 云同步变更集合，按表、按变更类型保存uuid
+ */
+class CloudChangeSet {
+public:
+    void Add(const std::string &table, CloudChangeType type, const std::string &uuid);
+    bool Empty() const
+    {
+        return totalCount_ == 0;
+    }
+    size_t Size() const
+    {
+        return totalCount_;
+    }
+    size_t Count(CloudChangeType type) const;
+
+    /**
+     * 按插入、更新、删除的顺序拆分为分片，每个分片最多maxEntries个uuid
+     * @param maxEntries
+     * @return
+     */
+    std::vector<CloudChangeChunk> Split(size_t maxEntries = CLOUD_CHANGE_CHUNK_MAX_ENTRIES) const;
+
+private:
+    using TableChanges = std::array<std::vector<std::string>, CLOUD_CHANGE_TYPE_COUNT>;
+    static std::string *ChunkField(CloudChangeChunk &chunk, CloudChangeType type);
+    void AppendType(CloudChangeType type, size_t maxEntries, std::vector<CloudChangeChunk> &chunks) const;
+
+    std::map<std::string, TableChanges> tables_;
+    size_t totalCount_ = 0;
+};
+
+/**
+ * 分片投递队列，一个投递线程按入队顺序逐个投递，相邻分片之间间隔intervalMs
+ * 积压达到maxPending时入队方等待；Stop或析构时唤醒等待方、join投递线程，丢弃还未投递的分片
+ */
+class CloudChangeDeliverQueue {
+public:
+    using DeliverFunc = std::function<void(const CloudChangeChunk &)>;
+
+    CloudChangeDeliverQueue(DeliverFunc deliver, size_t maxPending, int intervalMs);
+    ~CloudChangeDeliverQueue();
+    CloudChangeDeliverQueue(const CloudChangeDeliverQueue &) = delete;
+    CloudChangeDeliverQueue &operator=(const CloudChangeDeliverQueue &) = delete;
+
+    // 按顺序入队，第一次入队时启动投递线程；已停止时丢弃
+    void Push(std::vector<CloudChangeChunk> &chunks);
+    void Stop();
+
+private:
+    void Run();
+
+    DeliverFunc deliver_;
+    size_t maxPending_;
+    int intervalMs_;
+    std::mutex mutex_;
+    std::condition_variable notEmptyCV_;
+    std::condition_variable notFullCV_;
+    std::deque<CloudChangeChunk> pendingChunks_;
+    std::thread thread_;
+    bool stopped_ = false;
+};
+}  // namespace Contacts
+}  // namespace OHOS
+#endif  // CLOUD_CHANGE_SET_H
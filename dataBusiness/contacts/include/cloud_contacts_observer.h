@@ -16,18 +16,23 @@
 #ifndef CLOUD_CONTACTS_OBSERVER_H
 #define CLOUD_CONTACTS_OBSERVER_H
 
+#include "cloud_change_set.h"
 #include "contact_connect_ability.h"
 #include "rdb_predicates.h"
 
 namespace OHOS {
 namespace Contacts {
+// 待投递分片的上限，超过后通知线程等待投递线程消费
+constexpr size_t CLOUD_CHANGE_MAX_PENDING_CHUNKS = 8;
+// 相邻两个分片的投递间隔，避免短时间内大量拉起js服务
+constexpr int CLOUD_CHANGE_CHUNK_INTERVAL_MS = 50;
+
 class ContactsObserver : public OHOS::DistributedRdb::RdbStoreObserver {
 public:
     static std::shared_ptr<ContactsObserver> contactsObserver_;
     static std::shared_ptr<ContactConnectAbility> contactsConnectAbility_;
     static std::shared_ptr<ContactsObserver> GetInstance();
-    virtual ~ContactsObserver()
-    {}
+    virtual ~ContactsObserver();
     void OnChange(const std::vector<std::string> &devices) override;
     void OnChange(
         const OHOS::DistributedRdb::Origin &origin, const PrimaryFields &fields, ChangeInfo &&changeInfo) override;
@@ -37,6 +42,10 @@ public:
 
 private:
     ContactsObserver();
+    void DeliverCloudChange(const CloudChangeSet &changeSet);
+    void DeliverHandleType(const std::string &handleType);
+    void DeliverChunk(const CloudChangeChunk &chunk);
+    CloudChangeDeliverQueue deliverQueue_;
 };
 }  // namespace Contacts
 }  // namespace OHOS
@@ -17,6 +17,9 @@
 #define CONTACTSDATAABILITY_CONTACT_DATA_ABILITY_TEST_H
 
 #include <map>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "abs_shared_result_set.h"
 #include "datashare_ext_ability.h"
@@ -29,6 +32,7 @@
 #include "blocklist_database.h"
 #include "contacts_database.h"
 #include "contact_connect_ability.h"
+#include "uri_utils.h"
 
 namespace OHOS {
 namespace Contacts {
@@ -43,6 +47,17 @@ struct ExecuteBatchStatement {
     int32_t index;
     DataShare::OperationStatement statement;
     DataShare::ExecResult execResult;
+    // 已解析的uri code，OPERATION_ERROR表示需要重新解析
+    int uriCode = Contacts::OPERATION_ERROR;
+};
+// ExecuteBatch的分组状态：uri解析缓存，以及延后合并为一次批量插入的contact_data语句
+struct ExecuteBatchPlan {
+    std::map<std::string, int> uriCodes;
+    std::string lastUri;
+    int groupCode = Contacts::OPERATION_ERROR;
+    std::vector<int32_t> pendingIndexes;
+    std::vector<const DataShare::OperationStatement *> pendingStatements;
+    std::vector<OHOS::NativeRdb::ValuesBucket> pendingValues;
 };
 class ContactsDataAbility : public DataShare::DataShareExtAbility {
 public:
@@ -65,7 +80,14 @@ public:
         const std::vector<DataShare::OperationStatement> &statements, DataShare::ExecResultSet &result) override;
     int ExecuteBatchInner(const DataShare::OperationStatement &statements,
         DataShare::ExecResultSet &result,
-        int32_t index, std::map<int32_t, int32_t> &operationResultMap, std::set<std::string> &addFailedRawContacts);
+        int32_t index, std::map<int32_t, int32_t> &operationResultMap, std::set<std::string> &addFailedRawContacts,
+        int uriCode = Contacts::OPERATION_ERROR);
+    int PlanExecuteBatchStatement(const DataShare::OperationStatement &statement, DataShare::ExecResultSet &result,
+        int32_t index, std::map<int32_t, int32_t> &operationResultMap, std::set<std::string> &addFailedRawContacts,
+        ExecuteBatchPlan &plan);
+    int FlushContactDataGroup(DataShare::ExecResultSet &result, std::map<int32_t, int32_t> &operationResultMap,
+        std::set<std::string> &addFailedRawContacts, ExecuteBatchPlan &plan);
+    int ParseBatchUri(const std::string &uri, ExecuteBatchPlan &plan);
     int ProcessExecuteBatchInsert(ExecuteBatchStatement &executeBatchStatement,
         std::map<int32_t, int32_t> &operationResultMap, std::set<std::string> &addFailedRawContacts,
         DataShare::ExecResultSet &result);
@@ -84,7 +106,9 @@ public:
     static int getIntValueFromRdbBucket(const OHOS::NativeRdb::ValuesBucket &value,
         const std::string &colName);
     static int UriParseAndSwitch(Uri &uri);
+    static int UriParseAndSwitch(const Contacts::UriInfo &uriInfo);
     static void SwitchProfile(Uri &uri);
+    static void SwitchProfile(std::string_view path);
     void handleUpdateCalllogAfterBatchInsertData(int ret, int code,
         const std::vector<DataShare::DataShareValuesBucket> &values);
     void handleUpdateCalllogAfterInsertData(int code,
@@ -99,9 +123,8 @@ private:
     int InsertSyncContactsAlert(const OHOS::NativeRdb::ValuesBucket &value);
     int InsertSyncContactsConfirm(const OHOS::NativeRdb::ValuesBucket &value);
     int InsertRawContactData(const OHOS::NativeRdb::ValuesBucket &value);
-    std::string UriParseParam(Uri &uri);
-    std::string UriParseBatchParam(Uri &uri);
-    std::string UriParseHandleTypeParam(Uri &uri);
+    // 返回值引用uriString，使用期间uriString须保持有效
+    static Contacts::UriInfo ParseUri(const std::string &uriString);
     bool QueryExecute(std::shared_ptr<OHOS::NativeRdb::ResultSet> &result,
         DataShare::DataSharePredicates &dataSharePredicates, std::vector<std::string> &columnsTemp, int &parseCode,
         OHOS::Uri &uri);
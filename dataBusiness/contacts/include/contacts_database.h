@@ -77,6 +77,8 @@ public:
     void GetContactByValue(int &rawContactId, OHOS::NativeRdb::ValueObject &value);
     int64_t InsertRawContact(std::string table, OHOS::NativeRdb::ValuesBucket value);
     int64_t InsertContactData(std::string table, OHOS::NativeRdb::ValuesBucket value, std::string isSync);
+    int InsertContactDataGroup(std::vector<OHOS::NativeRdb::ValuesBucket> &values, const std::string &isSync,
+        std::vector<int64_t> &rowIds, bool &prepared);
     int64_t InsertPrivacyContactsBackup(std::string table, OHOS::NativeRdb::ValuesBucket contactDataValues);
     int64_t BatchInsertPrivacyContactsBackup(
         std::string table, std::vector<OHOS::NativeRdb::ValuesBucket> contactDataValues);
@@ -123,6 +125,8 @@ public:
     int BeginTransaction();
     int Commit();
     int RollBack();
+    int BeginBulkWrite();
+    int EndBulkWrite();
     static void DestroyInstanceAndRestore(std::string restorePath);
     std::shared_ptr<OHOS::NativeRdb::ResultSet> SelectCandidate();
     int Split(DataShare::DataSharePredicates predicates);
@@ -263,6 +267,7 @@ public:
     void CheckIncompleteTableForContact(std::shared_ptr<OHOS::NativeRdb::RdbStore> &rdbStore);
     void CheckIncompleteViewForContact(std::shared_ptr<OHOS::NativeRdb::RdbStore> &rdbStore);
     void CheckAndCompleteFieldsForContact(std::shared_ptr<OHOS::NativeRdb::RdbStore> &rdbStore);
+    int DeletePersonalRingtone(std::string ringtoneUri);
 
 private:
     ContactsDataBase();
@@ -300,7 +305,6 @@ private:
         std::vector<std::string> &contactIdArr);
     std::vector<OHOS::NativeRdb::ValuesBucket> DeleteRawContactQuery(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     int DeleteLocal(int rawContactId, std::string contactId, int isDeleteValue);
-    int DeletePersonalRingtone(std::string contactId);
     int DeleteLocalMerged(std::string contactId, std::string rawContactId);
     static bool Restore(std::string restorePath);
     int CompletelyDeleteCommit(int retCode);
@@ -358,6 +362,8 @@ private:
         std::function<int(int)> GetOldContactId);
     int64_t GetContactCount();
     void ReportOperationAuditLog(const std::vector<std::string> &rawContactIds);
+    int RecordHardDeleteSideEffects(const std::set<std::string> &contactIdSet, std::string calendarEventIds,
+        const std::vector<std::string> &ringtoneUris);
     std::string GetCallingBundleName();
     void QueryContactInfosByRawIds(
         const std::vector<std::string> &rawContactIds, std::vector<NativeRdb::ValuesBucket> &contactInfos);
@@ -406,6 +412,14 @@ public:
     int OnDowngrade(OHOS::NativeRdb::RdbStore &rdbStore, int currentVersion, int targetVersion) override;
 
 private:
+    using UpgradeStep = int (SqliteOpenHelperContactCallback::*)(OHOS::NativeRdb::RdbStore &, int, int);
+    using VoidUpgradeStep = void (SqliteOpenHelperContactCallback::*)(OHOS::NativeRdb::RdbStore &, int, int);
+    int CreateSchema(OHOS::NativeRdb::RdbStore &store);
+    void CreateSchemaIndexes(OHOS::NativeRdb::RdbStore &store);
+    int RunUpgradeStep(
+        OHOS::NativeRdb::RdbStore &store, int version, UpgradeStep step, int oldVersion, int newVersion);
+    void RunUpgradeStep(
+        OHOS::NativeRdb::RdbStore &store, int version, VoidUpgradeStep step, int oldVersion, int newVersion);
     void UpgradeToV2(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     void UpgradeToV3(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     void UpgradeToV4(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
@@ -450,6 +464,8 @@ private:
     int UpgradeToV41(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int UpgradeToV42(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int UpgradeToV43(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
+    int UpgradeToV44(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
+    int UpgradeToV45(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     void UpgradeUnderV10(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     void UpgradeUnderV20(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
     int UpgradeUnderV30(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion);
@@ -16,8 +16,11 @@
 #ifndef DATASHARE_STUB_IMPL_H
 #define DATASHARE_STUB_IMPL_H
 
+#include <chrono>
+
 #include "datashare_stub.h"
 #include "datashare_ext_ability.h"
+#include "datashare_metrics.h"
 
 namespace OHOS {
 namespace DataShare {
@@ -62,6 +65,11 @@ private:
     std::shared_ptr<DataShareExtAbility> GetVoiceMailAbility();
     int addFailedDeleteFile(const std::string &fileName);
     bool TryDeleteFile(const Uri &uri);
+    void RecordMetrics(Contacts::DataShareOperation operation, const Uri &uri,
+        std::chrono::steady_clock::time_point beginTime, int64_t rows, const DataSharePredicates *predicates);
+    std::string BuildSlowSql(Contacts::DataShareOperation operation, const std::string &uriPath,
+        const DataSharePredicates *predicates);
+    std::shared_ptr<DataShareResultSet> QueryMetrics();
 
 private:
     std::shared_ptr<DataShareExtAbility> contactsDataAbility_ = nullptr;
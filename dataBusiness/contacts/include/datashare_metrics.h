@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DATASHARE_METRICS_H
+#define DATASHARE_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "latency_histogram.h"
+
+namespace OHOS {
+namespace Contacts {
+// 只读的统计查询uri，返回一行一列(metrics)的json
+constexpr const char *DATASHARE_METRICS_URI = "datashare:///com.ohos.contactsdataability/metrics";
+constexpr const char *DATASHARE_METRICS_PATH = "/com.ohos.contactsdataability/metrics";
+constexpr const char *DATASHARE_METRICS_COLUMN = "metrics";
+// 超过该耗时的操作记录慢操作样本
+constexpr uint64_t DATASHARE_SLOW_OPERATION_US = 200 * 1000;
+// 按(操作, uri)统计的槽位个数，满了之后的记录计入dropped
+constexpr size_t DATASHARE_METRICS_MAX_URIS = 128;
+constexpr size_t DATASHARE_METRICS_MAX_PATH_LENGTH = 128;
+// 保留最近的慢操作样本个数
+constexpr size_t DATASHARE_METRICS_MAX_SLOW_SAMPLES = 32;
+// rows传该值表示不统计行数（如query）
+constexpr int64_t DATASHARE_METRICS_ROWS_UNKNOWN = -1;
+
+enum class DataShareOperation : int {
+    INSERT = 0,
+    UPDATE,
+    DELETE,
+    QUERY,
+    BATCH_INSERT,
+    EXECUTE_BATCH,
+    COUNT,
+};
+
+/**
+ * ContactsDataShareStubImpl各接口的耗时统计
+ * 每种操作一个总直方图，每个(操作, uri path)一个直方图和行数计数，记录路径全部是原子操作；
+ * 慢操作保留归一化后的sql（字面量替换为?），通过DATASHARE_METRICS_URI查询或Dump导出
+ */
+class DataShareMetrics {
+public:
+    static DataShareMetrics &GetInstance();
+    ~DataShareMetrics();
+
+    /**
+     * 记录一次操作
+     * @param operation
+     * @param uriPath uri的path部分，不含query
+     * @param costUs 耗时，微秒
+     * @param rows 影响的行数，DATASHARE_METRICS_ROWS_UNKNOWN表示不统计
+     */
+    void Record(DataShareOperation operation, const std::string &uriPath, uint64_t costUs, int64_t rows);
+    void RecordSlow(DataShareOperation operation, const std::string &uriPath, const std::string &sql,
+        uint64_t costUs);
+    static bool IsSlow(uint64_t costUs)
+    {
+        return costUs >= DATASHARE_SLOW_OPERATION_US;
+    }
+
+    // 导出当前统计，json格式
+    std::string Dump();
+    // 清零统计，已分配的槽位保留
+    void Reset();
+
+    /**
+     * 去掉sql中的字符串和数字字面量，连续的?列表合并为一个，便于按语句聚合
+     * @param sql
+     * @return
+     */
+    static std::string NormalizeSql(const std::string &sql);
+    static const char *OperationName(DataShareOperation operation);
+
+private:
+    static constexpr int SLOT_EMPTY = 0;
+    static constexpr int SLOT_READY = 1;
+
+    struct UriSlot {
+        std::atomic<uint64_t> key {0};
+        std::atomic<int> state {SLOT_EMPTY};
+        int operation = 0;
+        char path[DATASHARE_METRICS_MAX_PATH_LENGTH] = {0};
+        LatencyHistogram *histogram = nullptr;
+        std::atomic<int64_t> rows {0};
+    };
+
+    struct SlowSample {
+        DataShareOperation operation;
+        std::string uriPath;
+        std::string sql;
+        uint64_t costUs;
+        int64_t timestamp;
+    };
+
+    DataShareMetrics();
+    DataShareMetrics(const DataShareMetrics &) = delete;
+    DataShareMetrics &operator=(const DataShareMetrics &) = delete;
+    UriSlot *FindOrClaimSlot(DataShareOperation operation, const std::string &uriPath);
+    static uint64_t SlotKey(DataShareOperation operation, const std::string &uriPath);
+
+    std::array<LatencyHistogram, static_cast<size_t>(DataShareOperation::COUNT)> operationHistograms_;
+    std::array<UriSlot, DATASHARE_METRICS_MAX_URIS> uriSlots_;
+    std::atomic<uint64_t> dropped_ {0};
+    std::mutex slowMutex_;
+    std::deque<SlowSample> slowSamples_;
+};
+} // namespace Contacts
+} // namespace OHOS
+#endif // DATASHARE_METRICS_H
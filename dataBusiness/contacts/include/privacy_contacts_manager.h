@@ -16,6 +16,9 @@
 #ifndef PRIVACY_CONTACTS_MANAGER_H
 #define PRIVACY_CONTACTS_MANAGER_H
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <unordered_set>
 #include "datashare_helper.h"
 #include "datashare_values_bucket.h"
@@ -26,6 +29,31 @@ namespace OHOS {
 namespace Contacts {
 constexpr int PRIVACY_CONTACTS_MANAGER_RETRY_CREATE_DATASHARE_HELPER_SLEEP_TIME = 100;
 constexpr int PRIVACY_CONTACTS_MANAGER_RETRY_CREATE_DATASHARE_HELPER_RETRY_TIMES = 3;
+// 批量更新隐私标记时，每次Update携带的最大id个数
+constexpr size_t PRIVACY_CONTACTS_MANAGER_UPDATE_TAG_BATCH_SIZE = 500;
+
+// 隐私空间号码集合的快照，privacy_contacts_backup表变化后重新加载
+class PrivacyNumberSnapshot {
+public:
+    PrivacyNumberSnapshot(uint64_t generation, std::unordered_set<std::string> &&numbers);
+    bool Contains(const std::string &phoneNumber) const;
+    uint64_t GetGeneration() const
+    {
+        return generation_;
+    }
+    size_t Size() const
+    {
+        return numbers_.size();
+    }
+
+private:
+    // 布隆过滤器，绝大多数非隐私号码不需要查哈希表
+    bool MayContain(uint64_t hash) const;
+    uint64_t generation_;
+    std::unordered_set<std::string> numbers_;
+    std::vector<uint64_t> bloomBits_;
+    size_t bloomMask_ = 0;
+};
 
 class PrivacyContactsManager {
 public:
@@ -65,6 +93,8 @@ public:
     bool InsertPrivacyCallLog(const std::vector<DataShare::DataShareValuesBucket> &values);
     bool DeleteCallLogAfterMigrate(const std::vector<std::string> &deleteIds);
     bool ProcessDataAfterPrivacySpaceDeleted();
+    // privacy_contacts_backup表有变化，隐私号码缓存失效
+    void InvalidatePrivacyNumberCache();
 
     static bool ConvertResultSetToValuesBucket(const std::shared_ptr<DataShare::DataShareResultSet> &resultSet,
         std::vector<DataShare::DataShareValuesBucket> &valuesBuckets);
@@ -87,11 +117,25 @@ private:
     std::shared_ptr<DataShare::DataShareHelper> CreateDataShareHelper(std::string uri);
     int64_t GetIntFromDataShareValueObject(const DataShare::DataShareValueObject &object);
     bool GetPrivacySpacePhoneNumbers(std::unordered_set<std::string> &allPrivacyNums);
+    std::shared_ptr<const PrivacyNumberSnapshot> GetPrivacyNumberSnapshot();
+    bool GetPooledHelperAndUrl(const OHOS::AccountSA::OsAccountType &type, const std::string &datashareUri,
+        std::shared_ptr<DataShare::DataShareHelper> &helper, std::string &url);
+    std::shared_ptr<DataShare::DataShareHelper> GetPooledHelper(const std::string &url);
+    void DropPooledHelper(const std::string &url);
+    bool UpdatePrivacyTagByIds(const std::shared_ptr<DataShare::DataShareHelper> &helper, Uri &uri,
+        int64_t privacyTag, const std::vector<std::string> &ids);
     template <typename Func>
     std::shared_ptr<DataShare::DataShareHelper> RetryCreateDataShareHelper(Func &&func);
     std::mutex migrateContactMutex_;
     std::mutex migrateCallLogMutex_;
     std::mutex processCallLogMutex_;
+    // 隐私号码缓存
+    std::atomic<uint64_t> privacyBackupGeneration_{1};
+    std::mutex privacyNumberMutex_;
+    std::shared_ptr<const PrivacyNumberSnapshot> privacyNumberSnapshot_;
+    // 按uri复用的DataShareHelper，不在每次调用后Release
+    std::mutex helperPoolMutex_;
+    std::map<std::string, std::shared_ptr<DataShare::DataShareHelper>> helperPool_;
 };
 }  // namespace Contacts
 }  // namespace OHOS
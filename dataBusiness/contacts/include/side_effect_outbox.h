@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIDE_EFFECT_OUTBOX_H
+#define SIDE_EFFECT_OUTBOX_H
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rdb_store.h"
+
+namespace OHOS {
+namespace Contacts {
+// 删除联系人后需要执行的副作用类型，与side_effect_outbox表effect_type字段对应
+enum class SideEffectType : int {
+    // 删除日历生日，payload为逗号分隔的calendar_event_id
+    CALENDAR_DELETE = 1,
+    // 删除个性化铃声，payload为铃声uri
+    RINGTONE_DELETE = 2,
+    // 取消通话记录与联系人的关联，payload为逗号分隔的contact_id
+    CALLLOG_UNLINK = 3,
+    // 通知卡片刷新，payload为通知参数
+    FORM_CHANGE = 4,
+    // 触发端云同步
+    CLOUD_SYNC = 5,
+    // 触发js侧上云
+    CLOUD_UPLOAD = 6,
+};
+
+/**
+ * @brief Durable outbox for side effects of contact deletes.
+ *
+ * Delete paths only record rows here, inside the same transaction as the core row changes. A background
+ * task drains the table in batches and collapses each batch into one call per side effect type. Rows are
+ * removed only after their batch was executed, so a crash replays the batch; every side effect is idempotent.
+ */
+class SideEffectOutbox {
+public:
+    static std::shared_ptr<SideEffectOutbox> GetInstance();
+    SideEffectOutbox();
+    ~SideEffectOutbox();
+
+    /**
+     * @brief Record one side effect, should be called inside the caller's transaction
+     *
+     * @param store store of the caller's transaction, nothing is recorded for the profile store
+     * @param type side effect type
+     * @param payload side effect parameters
+     * @return int E_OK on success
+     */
+    int Record(std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, SideEffectType type, const std::string &payload);
+
+    /**
+     * @brief Schedule a drain on the async task queue, repeated calls before the drain runs are coalesced
+     */
+    void Schedule();
+
+    /**
+     * @brief Execute and remove all pending side effects, batch by batch
+     */
+    void Drain();
+
+    /**
+     * @brief Number of side effects still waiting in the outbox
+     *
+     * @return int64_t outbox depth, -1 if the store is unavailable
+     */
+    int64_t GetDepth();
+
+private:
+    struct OutboxBatch {
+        std::vector<std::string> ids;
+        std::set<std::string> calendarEventIds;
+        std::set<std::string> ringtoneUris;
+        std::set<std::string> unlinkContactIds;
+        std::set<std::string> formChangeParams;
+        bool needCloudSync = false;
+        bool needCloudUpload = false;
+    };
+    int TakeBatch(std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, OutboxBatch &batch);
+    void AddToBatch(OutboxBatch &batch, int type, const std::string &payload);
+    void ExecuteBatch(OutboxBatch &batch);
+    int RemoveBatch(std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, OutboxBatch &batch);
+
+    static std::shared_ptr<SideEffectOutbox> instance_;
+    static std::mutex instanceMutex_;
+    // 同一时刻只允许一个线程处理outbox
+    std::mutex drainMutex_;
+    std::atomic<bool> drainScheduled_{false};
+};
+} // namespace Contacts
+} // namespace OHOS
+#endif // SIDE_EFFECT_OUTBOX_H
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cloud_change_set.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace OHOS {
+namespace Contacts {
+namespace {
+// uuid与表名之间的分隔符';'，以及条目之间的分隔符','
+constexpr size_t CLOUD_CHANGE_SEPARATOR_LENGTH = 2;
+}
+
+void CloudChangeSet::Add(const std::string &table, CloudChangeType type, const std::string &uuid)
+{
+    tables_[table][static_cast<size_t>(type)].push_back(uuid);
+    totalCount_++;
+}
+
+size_t CloudChangeSet::Count(CloudChangeType type) const
+{
+    size_t count = 0;
+    for (const auto &item : tables_) {
+        count += item.second[static_cast<size_t>(type)].size();
+    }
+    return count;
+}
+
+std::vector<CloudChangeChunk> CloudChangeSet::Split(size_t maxEntries) const
+{
+    std::vector<CloudChangeChunk> chunks;
+    if (maxEntries == 0) {
+        maxEntries = CLOUD_CHANGE_CHUNK_MAX_ENTRIES;
+    }
+    AppendType(CloudChangeType::INSERT, maxEntries, chunks);
+    AppendType(CloudChangeType::UPDATE, maxEntries, chunks);
+    AppendType(CloudChangeType::DELETE, maxEntries, chunks);
+    return chunks;
+}
+
+std::string *CloudChangeSet::ChunkField(CloudChangeChunk &chunk, CloudChangeType type)
+{
+    switch (type) {
+        case CloudChangeType::INSERT:
+            return &chunk.uuidToInsert;
+        case CloudChangeType::UPDATE:
+            return &chunk.uuidToUpdate;
+        default:
+            return &chunk.uuidToDelete;
+    }
+}
+
+void CloudChangeSet::AppendType(CloudChangeType type, size_t maxEntries, std::vector<CloudChangeChunk> &chunks) const
+{
+    size_t typeIndex = static_cast<size_t>(type);
+    for (const auto &[table, changes] : tables_) {
+        const std::vector<std::string> &uuids = changes[typeIndex];
+        size_t index = 0;
+        while (index < uuids.size()) {
+            // 上一个分片未满时继续填充，不同类型可以放在同一个分片里
+            if (chunks.empty() || chunks.back().entryCount >= maxEntries) {
+                chunks.emplace_back();
+            }
+            CloudChangeChunk &chunk = chunks.back();
+            size_t count = std::min(maxEntries - chunk.entryCount, uuids.size() - index);
+            std::string *field = ChunkField(chunk, type);
+            size_t length = field->length();
+            for (size_t i = index; i < index + count; i++) {
+                length += uuids[i].length() + table.length() + CLOUD_CHANGE_SEPARATOR_LENGTH;
+            }
+            field->reserve(length);
+            for (size_t i = index; i < index + count; i++) {
+                if (!field->empty()) {
+                    field->push_back(',');
+                }
+                field->append(uuids[i]).append(";").append(table);
+            }
+            chunk.entryCount += count;
+            index += count;
+        }
+    }
+}
+
+CloudChangeDeliverQueue::CloudChangeDeliverQueue(DeliverFunc deliver, size_t maxPending, int intervalMs)
+    : deliver_(deliver), maxPending_(maxPending > 0 ? maxPending : 1), intervalMs_(intervalMs)
+{
+}
+
+CloudChangeDeliverQueue::~CloudChangeDeliverQueue()
+{
+    Stop();
+}
+
+void CloudChangeDeliverQueue::Push(std::vector<CloudChangeChunk> &chunks)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopped_) {
+        return;
+    }
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this]() { this->Run(); });
+    }
+    for (auto &chunk : chunks) {
+        // 投递线程积压过多时等待，避免全量同步时分片堆积占用内存
+        notFullCV_.wait(lock, [this] { return stopped_ || pendingChunks_.size() < maxPending_; });
+        if (stopped_) {
+            return;
+        }
+        pendingChunks_.push_back(std::move(chunk));
+        notEmptyCV_.notify_one();
+    }
+}
+
+void CloudChangeDeliverQueue::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        pendingChunks_.clear();
+    }
+    notEmptyCV_.notify_all();
+    notFullCV_.notify_all();
+    if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+        thread_.join();
+    }
+}
+
+void CloudChangeDeliverQueue::Run()
+{
+    while (true) {
+        CloudChangeChunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmptyCV_.wait(lock, [this] { return stopped_ || !pendingChunks_.empty(); });
+            if (stopped_) {
+                return;
+            }
+            chunk = std::move(pendingChunks_.front());
+            pendingChunks_.pop_front();
+            notFullCV_.notify_all();
+        }
+        deliver_(chunk);
+        // 投递间隔内等待停止信号，不用sleep，析构时不会被间隔阻塞
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (notEmptyCV_.wait_for(lock, std::chrono::milliseconds(intervalMs_), [this] { return stopped_; })) {
+            return;
+        }
+    }
+}
+}  // namespace Contacts
+}  // namespace OHOS
@@ -39,10 +39,18 @@ std::shared_ptr<ContactsObserver> ContactsObserver::GetInstance()
 }
 
 ContactsObserver::ContactsObserver()
+    : deliverQueue_([this](const CloudChangeChunk &chunk) { this->DeliverChunk(chunk); },
+        CLOUD_CHANGE_MAX_PENDING_CHUNKS, CLOUD_CHANGE_CHUNK_INTERVAL_MS)
 {
     contactsConnectAbility_ = OHOS::Contacts::ContactConnectAbility::GetInstance();
 }
 
+ContactsObserver::~ContactsObserver()
+{
+    // 先停止并join投递线程，投递回调不会在对象析构后访问this
+    deliverQueue_.Stop();
+}
+
 void ContactsObserver::OnChange(const std::vector<std::string> &devices)
 {}
 
@@ -64,10 +72,9 @@ bool ContactsObserver::handleCloudSyncChangeLogout(std::string *ptr, std::string
         HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact delete handle "
             "checkCursor data = %{public}s, ts = %{public}lld, return",
             (*ptr).c_str(), (long long) time(NULL));
-        // 调到js后，直接返回
-        contactsConnectAbility_->ConnectAbility("", "", "",
-            "", "logOutDelContact", "");
-        HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact delete handle start js success");
+        // 排在已投递的分片之后调到js，直接返回
+        DeliverHandleType("logOutDelContact");
+        HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact delete handle queued");
         return true;
     }
     // 退账号保留联系人
@@ -77,10 +84,9 @@ bool ContactsObserver::handleCloudSyncChangeLogout(std::string *ptr, std::string
         HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact reserve handle "
             "checkCursor data = %{public}s, ts = %{public}lld, return",
             (*ptr).c_str(), (long long) time(NULL));
-        // 调到js后，直接返回
-        contactsConnectAbility_->ConnectAbility("", "", "",
-            "", "logOutRetainContact", "");
-        HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact retain handle start js success");
+        // 排在已投递的分片之后调到js，直接返回
+        DeliverHandleType("logOutRetainContact");
+        HILOG_WARN("ContactsDataBase handleCloudSyncChange cloud logout contact retain handle queued");
         return true;
     }
     return false;
@@ -102,10 +108,7 @@ bool ContactsObserver::handleCloudSyncChangeLogoutGroup(std::string *ptr, std::s
 void ContactsObserver::handleCloudSyncChange(ChangeInfo *changeInfo)
 {
     HILOG_WARN("ContactsDataBase handleCloudSyncChange, ts = %{public}lld", (long long) time(NULL));
-    std::string uuidToInsert;
-    std::string uuidToUpdate;
-    std::string uuidToDelete;
-    int subLength = 1;
+    CloudChangeSet changeSet;
     bool isLogoutHandleFlag = false;
     for (auto &[table, value] : *changeInfo) {
         HILOG_INFO("ContactsDataBase handleCloudSyncChange table = %{public}s, ts = %{public}lld",
@@ -113,17 +116,15 @@ void ContactsObserver::handleCloudSyncChange(ChangeInfo *changeInfo)
         for (auto &uuid : value[CHG_TYPE_INSERT]) {
             auto ptr = std::get_if<std::string>(&uuid);
             if (ptr != nullptr) {
-                uuidToInsert.append((*ptr)).append(";").append(table.c_str()).append(",");
+                changeSet.Add(table, CloudChangeType::INSERT, *ptr);
             }
         }
-        uuidToInsert = uuidToInsert.substr(0, uuidToInsert.length() - subLength);
         for (auto &uuid : value[CHG_TYPE_UPDATE]) {
             auto ptr = std::get_if<std::string>(&uuid);
             if (ptr != nullptr) {
-                uuidToUpdate.append((*ptr)).append(";").append(table.c_str()).append(",");
+                changeSet.Add(table, CloudChangeType::UPDATE, *ptr);
             }
         }
-        uuidToUpdate = uuidToUpdate.substr(0, uuidToUpdate.length() - subLength);
 
         for (auto &uuid : value[CHG_TYPE_DELETE]) {
             auto ptr = std::get_if<std::string>(&uuid);
@@ -145,19 +146,45 @@ void ContactsObserver::handleCloudSyncChange(ChangeInfo *changeInfo)
             if (handleCloudSyncChangeLogoutGroup(ptr, table)) {
                 isLogoutHandleFlag = true;
             }
-
-            uuidToDelete.append((*ptr)).append(";").append(table.c_str()).append(",");
+            changeSet.Add(table, CloudChangeType::DELETE, *ptr);
         }
-        uuidToDelete = uuidToDelete.substr(0, uuidToDelete.length() - subLength);
     }
     if (!isLogoutHandleFlag) {
-        contactsConnectAbility_->ConnectAbility(uuidToInsert, uuidToUpdate, uuidToDelete,
-            "", "", "");
+        DeliverCloudChange(changeSet);
     } else {
         HILOG_INFO("ContactsDataBase handleCloudSyncChange cloud logout cloud_groups msg not handle cursor "
             " ts = %{public}lld, return",
             (long long) time(NULL));
     }
 }
+
+void ContactsObserver::DeliverCloudChange(const CloudChangeSet &changeSet)
+{
+    HILOG_INFO("handleCloudSyncChange insert: %{public}zu, update: %{public}zu, delete: %{public}zu",
+        changeSet.Count(CloudChangeType::INSERT), changeSet.Count(CloudChangeType::UPDATE),
+        changeSet.Count(CloudChangeType::DELETE));
+    std::vector<CloudChangeChunk> chunks = changeSet.Split(CLOUD_CHANGE_CHUNK_MAX_ENTRIES);
+    if (chunks.empty()) {
+        // 没有变更的uuid时保持原有行为，通知js侧按cursor处理
+        chunks.emplace_back();
+    }
+    deliverQueue_.Push(chunks);
+}
+
+// 退账号通知与变更分片走同一个队列，保证js侧先处理完之前的变更，每次退账号只拉起一次
+void ContactsObserver::DeliverHandleType(const std::string &handleType)
+{
+    std::vector<CloudChangeChunk> chunks(1);
+    chunks.front().handleType = handleType;
+    deliverQueue_.Push(chunks);
+}
+
+void ContactsObserver::DeliverChunk(const CloudChangeChunk &chunk)
+{
+    HILOG_INFO("handleCloudSyncChange deliver chunk, entries: %{public}zu, handleType: %{public}s",
+        chunk.entryCount, chunk.handleType.c_str());
+    contactsConnectAbility_->ConnectAbility(chunk.uuidToInsert, chunk.uuidToUpdate, chunk.uuidToDelete,
+        "", chunk.handleType, "");
+}
 }  // namespace Contacts
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "contacts_data_ability.h"
 
+#include <algorithm>
 #include <iostream>
 #include <mutex>
 #include <regex>
@@ -275,11 +276,12 @@ int ContactsDataAbility::Insert(const Uri &uri, const DataShare::DataShareValues
     g_mutex.lock();
     contactDataBase_ = Contacts::ContactsDataBase::GetInstance();
     profileDataBase_ = Contacts::ProfileDatabase::GetInstance();
-    OHOS::Uri uriTemp = uri;
     time_t ts = time(NULL);
     HILOG_INFO("getLockThen Insert ts = %{public}lld", (long long) ts);
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
-    int code = UriParseAndSwitch(uriTemp);
+    std::string uriString = uri.ToString();
+    Contacts::UriInfo uriInfo = ParseUri(uriString);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
+    int code = UriParseAndSwitch(uriInfo);
     int ret = contactDataBase_->BeginTransaction();
     if (!IsBeginTransactionOK(ret, g_mutex)) {
         HILOG_ERROR("ContactsDataAbility Insert IsBeginTransactionOK error");
@@ -623,11 +625,12 @@ int ContactsDataAbility::BatchInsert(const Uri &uri,
     profileDataBase_ = Contacts::ProfileDatabase::GetInstance();
     // 如果名称信息没有值，其他信息（如公司，职位，手机号码等有值），需要根据其他信息的值，设置到名称（如将公司名称设置到displayName）
     // 生成displayName情况，需要再bucket集合新增元素，但集合为const，不可修改，要使用一个新的集合
-    OHOS::Uri uriTemp = uri;
-    int code = UriParseAndSwitch(uriTemp);
+    std::string uriString = uri.ToString();
+    Contacts::UriInfo uriInfo = ParseUri(uriString);
+    int code = UriParseAndSwitch(uriInfo);
     std::vector<DataShare::DataShareValuesBucket> valuesHandle = values;
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
-    std::string isFromBatch = UriParseBatchParam(uriTemp);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
+    std::string isFromBatch(uriInfo.isFromBatch);
     HILOG_INFO("getLockThen BatchInsert,isSyncFromCloud = %{public}s,isFromBatch = %{public}s",
         isSyncFromCloud.c_str(), isFromBatch.c_str());
     // batchInsert onebyone会调用到单个插入，会发送大量消息
@@ -710,6 +713,10 @@ int ContactsDataAbility::batchInsertHandleOneByOne(const Uri &uri, std::string i
         return Contacts::RDB_EXECUTE_FAIL;
     }
 // LCOV_EXCL_START
+    if (contactDataBase_->BeginBulkWrite() != OHOS::NativeRdb::E_OK) {
+        contactDataBase_->RollBack();
+        return Contacts::RDB_EXECUTE_FAIL;
+    }
     bool isContainEvent = false;
     int rawContactId = -1;
     for (unsigned int i = 0; i < size; i++) {
@@ -719,6 +726,11 @@ int ContactsDataAbility::batchInsertHandleOneByOne(const Uri &uri, std::string i
             return result;
         }
     }
+    if (contactDataBase_->EndBulkWrite() != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("batchInsertHandleOneByOne EndBulkWrite error!");
+        contactDataBase_->RollBack();
+        return Contacts::RDB_EXECUTE_FAIL;
+    }
     int markRet = contactDataBase_->Commit();
     if (!IsCommitOK(markRet, g_mutex)) {
         HILOG_ERROR("batchInsertHandleOneByOne IsCommitOK error!");
@@ -811,23 +823,13 @@ int ContactsDataAbility::SavePortraitFileAndBlob(const std::string &srcFilePath,
     std::vector<uint8_t> &blob, int32_t &blobSource)
 {
     mode_t filePermissions = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP;
-    auto pixelMap = Contacts::PixelMapUtil::GetPixelMapFromFile(srcFilePath);
+    // 解码时直接输出缩略图尺寸
+    auto pixelMap = Contacts::PixelMapUtil::GetThumbnailPixelMapFromFile(srcFilePath);
     if (pixelMap == nullptr) {
-        HILOG_ERROR("SavePortraitFileAndBlob GetPixelMapFromFile failed");
+        HILOG_ERROR("SavePortraitFileAndBlob GetThumbnailPixelMapFromFile failed");
         return Contacts::OPERATION_ERROR;
     }
-    int srcFd = open(srcFilePath.c_str(), O_RDONLY, filePermissions);
-    if (srcFd == Contacts::OPEN_FILE_FAILED) {
-        HILOG_ERROR("SavePortraitFileAndBlob open srcFilePath failed");
-        return Contacts::OPERATION_ERROR;
-    }
-    Contacts::PixelMapUtil::GetThumbnailPixelMap(pixelMap, srcFd);
-    close(srcFd);
-    if (pixelMap == nullptr) {
-        HILOG_ERROR("SavePortraitFileAndBlob GetThumbnailPixelMap failed");
-        return Contacts::OPERATION_ERROR;
-    }
-    int fd = open(filePath.c_str(), O_CREAT | O_WRONLY, filePermissions);
+    int fd = open(filePath.c_str(), O_CREAT | O_WRONLY | O_TRUNC, filePermissions);
     if (fd == Contacts::OPEN_FILE_FAILED) {
         HILOG_ERROR("SavePortraitFileAndBlob open filePath failed");
         return Contacts::OPERATION_ERROR;
@@ -911,9 +913,9 @@ int ContactsDataAbility::BatchInsertByMigrate(
     int code, const Uri &uri, const std::vector<DataShare::DataShareValuesBucket> &values)
 {
     HILOG_INFO("BatchInsertByMigrate start");
-    OHOS::Uri uriTemp = uri;
+    std::string uriString = uri.ToString();
     // 是否云同步
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
+    std::string isSyncFromCloud(ParseUri(uriString).isSyncFromCloud);
     HILOG_INFO("ContactsDataAbility BatchInsertByMigrate isSyncFromCloud = %{public}s, code = %{public}d",
         isSyncFromCloud.c_str(), code);
     int ret = 0;
@@ -960,9 +962,11 @@ int ContactsDataAbility::Update(
     profileDataBase_ = Contacts::ProfileDatabase::GetInstance();
     int retCode = Contacts::RDB_EXECUTE_FAIL;
     OHOS::Uri uriTemp = uri;
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
+    std::string uriString = uri.ToString();
+    Contacts::UriInfo uriInfo = ParseUri(uriString);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
     HILOG_INFO("getLockThen Update,ts = %{public}lld", (long long) time(NULL));
-    int code = UriParseAndSwitch(uriTemp);
+    int code = UriParseAndSwitch(uriInfo);
     DataShare::DataSharePredicates dataSharePredicates = predicates;
 
     UpdateExecute(retCode, code, valuesBucket, dataSharePredicates, isSyncFromCloud);
@@ -1152,12 +1156,13 @@ int ContactsDataAbility::Delete(const Uri &uri, const DataShare::DataSharePredic
     contactDataBase_ = Contacts::ContactsDataBase::GetInstance();
     profileDataBase_ = Contacts::ProfileDatabase::GetInstance();
     int retCode = Contacts::RDB_EXECUTE_FAIL;
-    OHOS::Uri uriTemp = uri;
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
+    std::string uriString = uri.ToString();
+    Contacts::UriInfo uriInfo = ParseUri(uriString);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
     HILOG_INFO("getLockThen Delete, ts = %{public}lld",
         (long long) time(NULL));
-    int code = UriParseAndSwitch(uriTemp);
-    std::string handleType = UriParseHandleTypeParam(uriTemp);
+    int code = UriParseAndSwitch(uriInfo);
+    std::string handleType(uriInfo.handleType);
     DataShare::DataSharePredicates dataSharePredicates = predicates;
     DeleteExecute(retCode, code, dataSharePredicates, isSyncFromCloud, handleType);
     HILOG_INFO("Delete, size = %{public}d",
@@ -1449,14 +1454,20 @@ int ContactsDataAbility::ExecuteBatch(
         return Contacts::RDB_EXECUTE_FAIL;
     }
     int32_t index = -1;
+    ExecuteBatchPlan plan;
     for (const auto &statement: statements) {
         index++;
-        int executeResult = ExecuteBatchInner(statement, result, index, operationResultMap, addFailedRawContacts);
+        int executeResult =
+            PlanExecuteBatchStatement(statement, result, index, operationResultMap, addFailedRawContacts, plan);
         if (executeResult == Contacts::OPERATION_ERROR) {
             contactDataBase_->RollBack();
             return Contacts::RDB_EXECUTE_FAIL;
         }
     }
+    if (FlushContactDataGroup(result, operationResultMap, addFailedRawContacts, plan) == Contacts::OPERATION_ERROR) {
+        contactDataBase_->RollBack();
+        return Contacts::RDB_EXECUTE_FAIL;
+    }
     int commitRet = contactDataBase_->Commit();
     if (!IsCommitOK(commitRet, g_mutex)) {
         HILOG_ERROR("ExecuteBatch IsCommitOK error");
@@ -1471,14 +1482,136 @@ int ContactsDataAbility::ExecuteBatch(
     return Contacts::RDB_EXECUTE_OK;
 }
 
+/**
+ * 连续的raw_contact/contact_data插入合为一组：raw_contact逐条插入（后续语句需要它的id），
+ * contact_data延后到组结束时一次批量插入；遇到其他语句、切换联系人/个人名片库，
+ * 或引用了组内尚未落库的语句时，先把当前组落库
+ */
+int ContactsDataAbility::PlanExecuteBatchStatement(const DataShare::OperationStatement &statement,
+    DataShare::ExecResultSet &result, int32_t index, std::map<int32_t, int32_t> &operationResultMap,
+    std::set<std::string> &addFailedRawContacts, ExecuteBatchPlan &plan)
+{
+    int code = Contacts::OPERATION_ERROR;
+    if (statement.operationType == DataShare::Operation::INSERT) {
+        code = ParseBatchUri(statement.uri, plan);
+    }
+    bool isContactData = code == Contacts::CONTACTS_CONTACT_DATA || code == Contacts::PROFILE_CONTACT_DATA;
+    bool isRawContact = code == Contacts::CONTACTS_RAW_CONTACT || code == Contacts::PROFILE_RAW_CONTACT;
+    bool isProfile = code == Contacts::PROFILE_CONTACT_DATA || code == Contacts::PROFILE_RAW_CONTACT;
+    bool groupIsProfile = plan.groupCode == Contacts::PROFILE_CONTACT_DATA;
+    bool refersPending = statement.HasBackReference() &&
+        std::find(plan.pendingIndexes.begin(), plan.pendingIndexes.end(),
+            statement.backReference.GetFromIndex()) != plan.pendingIndexes.end();
+    if (!plan.pendingIndexes.empty() && (!(isContactData || isRawContact) || isProfile != groupIsProfile ||
+        refersPending)) {
+        if (FlushContactDataGroup(result, operationResultMap, addFailedRawContacts, plan) ==
+            Contacts::OPERATION_ERROR) {
+            return Contacts::OPERATION_ERROR;
+        }
+        // 落库过程中可能切换过store_，重新解析一次
+        plan.lastUri.clear();
+        if (code != Contacts::OPERATION_ERROR) {
+            code = ParseBatchUri(statement.uri, plan);
+        }
+    }
+    if (isContactData) {
+        OHOS::NativeRdb::ValuesBucket valuesBucket =
+            RdbDataShareAdapter::RdbUtils::ToValuesBucket(statement.valuesBucket);
+        // 引用解析失败时走逐条插入，保持原有的错误处理
+        if (ProcessBackReference(statement, operationResultMap, valuesBucket) !=
+            Contacts::ProcessBackReferenceResult::FAILED) {
+            plan.groupCode = code;
+            plan.pendingIndexes.push_back(index);
+            plan.pendingStatements.push_back(&statement);
+            plan.pendingValues.push_back(std::move(valuesBucket));
+            result.results.emplace_back(DataShare::ExecResult{
+                statement.operationType, DataShare::ExecErrorCode::EXEC_SUCCESS, std::to_string(-1)});
+            return Contacts::RDB_EXECUTE_OK;
+        }
+    }
+    return ExecuteBatchInner(statement, result, index, operationResultMap, addFailedRawContacts, code);
+}
+
+int ContactsDataAbility::FlushContactDataGroup(DataShare::ExecResultSet &result,
+    std::map<int32_t, int32_t> &operationResultMap, std::set<std::string> &addFailedRawContacts,
+    ExecuteBatchPlan &plan)
+{
+    if (plan.pendingIndexes.empty()) {
+        return Contacts::RDB_EXECUTE_OK;
+    }
+    std::vector<int32_t> indexes;
+    std::vector<const DataShare::OperationStatement *> statements;
+    std::vector<OHOS::NativeRdb::ValuesBucket> values;
+    indexes.swap(plan.pendingIndexes);
+    statements.swap(plan.pendingStatements);
+    values.swap(plan.pendingValues);
+    int groupCode = plan.groupCode;
+    plan.groupCode = Contacts::OPERATION_ERROR;
+    // 当前语句解析uri时可能已切换到另一个库，切回本组所在的库
+    OHOS::Uri groupUri(statements.front()->uri);
+    SwitchProfile(groupUri);
+    std::vector<int64_t> rowIds;
+    bool prepared = false;
+    int ret = contactDataBase_->InsertContactDataGroup(values, "false", rowIds, prepared);
+    if (ret == Contacts::RDB_EXECUTE_OK) {
+        for (size_t i = 0; i < indexes.size(); i++) {
+            result.results[indexes[i]].message = std::to_string(rowIds[i]);
+            operationResultMap.emplace(indexes[i], static_cast<int32_t>(rowIds[i]));
+        }
+        HILOG_INFO("ExecuteBatch insert contact_data group size: %{public}zu", indexes.size());
+        return Contacts::RDB_EXECUTE_OK;
+    }
+    if (prepared) {
+        HILOG_ERROR("ExecuteBatch InsertContactDataGroup error: %{public}d", ret);
+        for (int32_t index : indexes) {
+            result.results[index].code = DataShare::ExecErrorCode::EXEC_FAILED;
+        }
+        return Contacts::OPERATION_ERROR;
+    }
+    // 校验失败时尚未写库，退回逐条插入，由单条路径给出原有的错误结果
+    HILOG_WARN("ExecuteBatch contact_data group prepare failed, insert one by one");
+    for (size_t i = 0; i < indexes.size(); i++) {
+        ExecuteBatchStatement executeBatchStatement{indexes[i], *statements[i], result.results[indexes[i]]};
+        executeBatchStatement.uriCode = groupCode;
+        int executeResult =
+            ProcessExecuteBatchInsert(executeBatchStatement, operationResultMap, addFailedRawContacts, result);
+        result.results[indexes[i]] = executeBatchStatement.execResult;
+        if (executeResult == Contacts::OPERATION_ERROR) {
+            return Contacts::OPERATION_ERROR;
+        }
+    }
+    return Contacts::RDB_EXECUTE_OK;
+}
+
+int ContactsDataAbility::ParseBatchUri(const std::string &uri, ExecuteBatchPlan &plan)
+{
+    auto it = plan.uriCodes.find(uri);
+    if (it != plan.uriCodes.end() && uri == plan.lastUri) {
+        // 与上一条语句的uri相同，store_无需切换
+        return it->second;
+    }
+    plan.lastUri = uri;
+    Contacts::UriInfo uriInfo = ParseUri(uri);
+    if (it != plan.uriCodes.end()) {
+        if (it->second != Contacts::OPERATION_ERROR) {
+            SwitchProfile(uriInfo.path);
+        }
+        return it->second;
+    }
+    int code = UriParseAndSwitch(uriInfo);
+    plan.uriCodes.emplace(uri, code);
+    return code;
+}
+
 int ContactsDataAbility::ExecuteBatchInner(const DataShare::OperationStatement &statement,
     DataShare::ExecResultSet &result, int32_t index, std::map<int32_t, int32_t> &operationResultMap,
-    std::set<std::string> &addFailedRawContacts)
+    std::set<std::string> &addFailedRawContacts, int uriCode)
 {
     int executeResult = -1;
     DataShare::ExecResult execResult{
         statement.operationType, DataShare::ExecErrorCode::EXEC_SUCCESS, std::to_string(-1)};
     ExecuteBatchStatement executeBatchStatement{index, statement, execResult};
+    executeBatchStatement.uriCode = uriCode;
     if (statement.operationType == DataShare::Operation::INSERT) {
         executeResult = ProcessExecuteBatchInsert(executeBatchStatement, operationResultMap, addFailedRawContacts,
             result);
@@ -1498,8 +1631,10 @@ int ContactsDataAbility::ProcessExecuteBatchInsert(ExecuteBatchStatement &execut
     auto &index = executeBatchStatement.index;
     auto &statement = executeBatchStatement.statement;
     auto &execResult = executeBatchStatement.execResult;
-    OHOS::Uri uriTemp(statement.uri);
-    int code = UriParseAndSwitch(uriTemp);
+    int code = executeBatchStatement.uriCode;
+    if (code == Contacts::OPERATION_ERROR) {
+        code = UriParseAndSwitch(ParseUri(statement.uri));
+    }
     OHOS::NativeRdb::ValuesBucket valuesBucket =
         RdbDataShareAdapter::RdbUtils::ToValuesBucket(statement.valuesBucket);
     auto processBackReferenceResult = ProcessBackReference(statement, operationResultMap, valuesBucket);
@@ -1546,12 +1681,12 @@ int ContactsDataAbility::ProcessExecuteBatchUpdate(ExecuteBatchStatement &execut
 {
     auto &statement = executeBatchStatement.statement;
     auto &execResult = executeBatchStatement.execResult;
-    OHOS::Uri uriTemp(statement.uri);
-    int code = UriParseAndSwitch(uriTemp);
+    Contacts::UriInfo uriInfo = ParseUri(statement.uri);
+    int code = UriParseAndSwitch(uriInfo);
     OHOS::NativeRdb::ValuesBucket valuesBucket =
     RdbDataShareAdapter::RdbUtils::ToValuesBucket(statement.valuesBucket);
     int retCode = Contacts::OPERATION_OK;
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
     UpdateExecute(retCode, code, valuesBucket, statement.predicates, isSyncFromCloud);
     if (retCode >= 0) {
         execResult.message = std::to_string(retCode);
@@ -1567,11 +1702,11 @@ int ContactsDataAbility::ProcessExecuteBatchDelete(ExecuteBatchStatement &execut
 {
     auto &statement = executeBatchStatement.statement;
     auto &execResult = executeBatchStatement.execResult;
-    OHOS::Uri uriTemp(statement.uri);
-    int code = UriParseAndSwitch(uriTemp);
+    Contacts::UriInfo uriInfo = ParseUri(statement.uri);
+    int code = UriParseAndSwitch(uriInfo);
     int retCode = Contacts::OPERATION_OK;
     std::string handleType = "";
-    std::string isSyncFromCloud = UriParseParam(uriTemp);
+    std::string isSyncFromCloud(uriInfo.isSyncFromCloud);
     DeleteExecute(retCode, code, statement.predicates, isSyncFromCloud, handleType);
     if (retCode >= 0) {
         execResult.message = std::to_string(retCode);
@@ -1722,57 +1857,39 @@ bool ContactsDataAbility::QueryExecuteSwitchSplitOthers(std::shared_ptr<OHOS::Na
     return isUriMatch;
 }
 
-std::string ContactsDataAbility::UriParseParam(Uri &uri)
+Contacts::UriInfo ContactsDataAbility::ParseUri(const std::string &uriString)
 {
+    // 路由表由uriValueMap_生成一次，之后每次解析不再分配内存
+    static const Contacts::UriRouteTable routeTable(uriValueMap_);
     Contacts::UriUtils uriUtils;
-    std::string isSyncFromCloud;
-    std::map<std::string, std::string> mapParams;
-    mapParams = uriUtils.getQueryParameter(uri);
-    if (!mapParams.empty()) {
-        isSyncFromCloud = mapParams["isSyncFromCloud"];
-    }
-    return isSyncFromCloud;
+    return uriUtils.ParseUri(uriString, routeTable);
 }
 
-std::string ContactsDataAbility::UriParseBatchParam(Uri &uri)
+int ContactsDataAbility::UriParseAndSwitch(Uri &uri)
 {
-    Contacts::UriUtils uriUtils;
-    std::string isFromBatch;
-    std::map<std::string, std::string> mapParams;
-    mapParams = uriUtils.getQueryParameter(uri);
-    if (!mapParams.empty()) {
-        isFromBatch = mapParams["isFromBatch"];
-    }
-    return isFromBatch;
+    std::string uriString = uri.ToString();
+    return UriParseAndSwitch(ParseUri(uriString));
 }
 
-std::string ContactsDataAbility::UriParseHandleTypeParam(Uri &uri)
+int ContactsDataAbility::UriParseAndSwitch(const Contacts::UriInfo &uriInfo)
 {
-    Contacts::UriUtils uriUtils;
-    std::string handleType;
-    std::map<std::string, std::string> mapParams;
-    mapParams = uriUtils.getQueryParameter(uri);
-    if (!mapParams.empty()) {
-        handleType = mapParams["handleType"];
+    if (uriInfo.code != Contacts::OPERATION_ERROR) {
+        SwitchProfile(uriInfo.path);
     }
-    return handleType;
+    return uriInfo.code;
 }
 
-int ContactsDataAbility::UriParseAndSwitch(Uri &uri)
+void ContactsDataAbility::SwitchProfile(Uri &uri)
 {
-    Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uri, uriValueMap_);
-    if (parseCode != Contacts::OPERATION_ERROR) {
-        SwitchProfile(uri);
-    }
-    return parseCode;
+    std::string path = uri.GetPath();
+    SwitchProfile(std::string_view(path));
 }
 
-void ContactsDataAbility::SwitchProfile(Uri &uri)
+void ContactsDataAbility::SwitchProfile(std::string_view path)
 {
-    std::vector<std::string> pathVector;
-    uri.GetPathSegments(pathVector);
-    if (pathVector.size() > 1 && pathVector[1].find("profile") == std::string::npos) {
+    Contacts::UriUtils uriUtils;
+    std::string_view segment = uriUtils.GetPathSegment(path, 1);
+    if (!segment.empty() && segment.find("profile") == std::string_view::npos) {
         contactDataBase_ = Contacts::ContactsDataBase::GetInstance();
         contactDataBase_->store_ = contactDataBase_->contactStore_;
     } else {
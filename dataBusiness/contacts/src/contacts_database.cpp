@@ -64,6 +64,7 @@
 #include "construction_name.h"
 #include "datashare_helper.h"
 #include "sql_analyzer.h"
+#include "sql_statement_cache.h"
 #include "rdb_store_config.h"
 #include "spam_call_adapter.h"
 #include "security_label.h"
@@ -79,6 +80,7 @@
 #include "hi_audit.h"
 #include "poster_call_adapter.h"
 #include "contacts_search.h"
+#include "side_effect_outbox.h"
 
 #ifdef ABILITY_CUST_SUPPORT
 #include "dlfcn.h"
@@ -158,6 +160,68 @@ static constexpr int REFRESH_LOCATION_RETRY_NUMBER = 2;
 static constexpr int64_t SYNC_CONTACT_MILLISECOND = 3 * 60 * 60 * 1000;
 // 联系人数据库
 static const std::string CONTACTS_DB = "contacts.db";
+// 单个升级步骤超过该耗时上报
+static constexpr int64_t UPGRADE_STEP_SLOW_MILLISECOND = 1000;
+// 当前版本(DATABASE_CONTACTS_OPEN_VERSION)的完整表、视图、触发器及初始化数据，新装直接建到最新版本不走升级链
+static const std::vector<const char *> CONTACT_SCHEMA_STATEMENTS = {
+    CREATE_CONTACT,
+    CREATE_RAW_CONTACT,
+    CREATE_CONTACT_DATA,
+    CREATE_CONTACT_BLOCKLIST,
+    CREATE_LOCAL_LANG,
+    CREATE_ACCOUNT,
+    CREATE_PHOTO_FILES,
+    CREATE_CONTACT_TYPE,
+    CREATE_GROUPS,
+    CREATE_DELETED_RAW_CONTACT,
+    CREATE_SEARCH_CONTACT,
+    CREATE_SEARCH_CONTACT_VIEW,
+    MERGE_INFO,
+    CREATE_VIEW_CONTACT_DATA,
+    CREATE_VIEW_RAW_CONTACT,
+    CREATE_VIEW_CONTACT,
+    CREATE_VIEW_CONTACT_LOCATION,
+    CREATE_VIEW_GROUPS,
+    CREATE_VIEW_DELETED,
+    UPDATE_RAW_CONTACT_VERSION,
+    INSERT_CONTACT_QUICK_SEARCH,
+    CREATE_DATABASE_BACKUP_TASK,
+    CREATE_INSERT_BACKUP_TIME,
+    CREATE_BULK_WRITE_SESSION,
+    CREATE_BULK_WRITE_RAW_CONTACT,
+    BULK_AWARE_UPDATE_CONTACT_BY_INSERT_CONTACT_DATA,
+    BULK_AWARE_UPDATE_CONTACT_BY_DELETE_CONTACT_DATA,
+    BULK_AWARE_UPDATE_CONTACT_BY_UPDATE_CONTACT_DATA,
+    RECORD_BULK_WRITE_BY_UPDATE_CONTACT_DATA,
+    RECORD_BULK_WRITE_BY_DELETE_CONTACT_DATA,
+    CREATE_CLOUD_RAW_CONTACT,
+    CREATE_CLOUD_GROUPS,
+    CREATE_SETTINGS,
+    INIT_CHANGE_TIME,
+    CREATE_HW_ACCOUNT,
+    CREATE_CLOUD_CONTACT_BLOCKLIST,
+    CREATE_PRIVACY_CONTACTS_BACKUP,
+    CREATE_POSTER,
+    CREATE_SIDE_EFFECT_OUTBOX,
+    CREATE_KIT_CONTACTS_SYNC_INFO,
+    CREATE_ACCOUNT_PURGE_CURSOR,
+};
+// 当前版本的全部索引，建表和数据修复之后统一创建，避免批量更新时逐行维护索引
+static const std::vector<const char *> CONTACT_SCHEMA_INDEXES = {
+    CREATE_CONTACT_INDEX,
+    CREATE_RAW_CONTACT_INDEX,
+    CREATE_RAW_CONTACT_INDEX_UNIQUE_KEY,
+    CREATE_RAW_CONTACT_INDEX_SORT,
+    CREATE_CONTACT_INDEX_DATA1,
+    CREATE_CONTACT_INDEX_DATA2,
+    CREATE_SEARCH_CONTACT_INDEX1,
+    CREATE_SEARCH_CONTACT_INDEX2,
+    MERGE_INFO_INDEX,
+    CREATE_CONTACT_BLOCKLIST_INDEX_PHONE,
+    CREATE_RAW_INDEX,
+    CREATE_DATA_INDEX,
+    CREATE_LOCATION_INDEX,
+};
 
 #ifdef ABILITY_CUST_SUPPORT
 static const unsigned int ENHANCED_QUERY_LENGTH = 7;
@@ -303,6 +367,8 @@ ContactsDataBase::ContactsDataBase()
     // 初始化异步任务队列
     g_asyncTaskQueue = AsyncTaskQueue::Instance();
     MoveBlocklistDataAsyncTask();
+    // 上次进程退出前未执行完的删除副作用，开库后重放
+    SideEffectOutbox::GetInstance()->Schedule();
 }
 
 void ContactsDataBase::CheckIncompleteTableForContact(std::shared_ptr<OHOS::NativeRdb::RdbStore> &rdbStore)
@@ -417,7 +483,10 @@ void ContactsDataBase::CheckAndCompleteFieldsForContact(std::shared_ptr<OHOS::Na
 void ContactsDataBase::MoveBlocklistDataAsyncTask()
 {
     std::unique_ptr<AsyncItem> task = std::make_unique<AsyncBlocklistMigrateTask>();
-    g_asyncTaskQueue->Push(task);
+    if (!g_asyncTaskQueue->Push(task)) {
+        HILOG_ERROR("MoveBlocklistDataAsyncTask push async task failed");
+        return;
+    }
     g_asyncTaskQueue->Start();
 }
 // 联系人db内的黑名单数据需要移动到el1下的黑名单db内
@@ -1125,6 +1194,58 @@ int ContactsDataBase::RollBack()
     return ret;
 }
 
+/**
+ * @brief 开始批量写，需在事务内调用，与EndBulkWrite成对使用
+ *
+ * 批量写期间contact_data的触发器不再逐行刷新contact的has_*标记，只记录受影响的raw_contact_id，
+ * 事务回滚时批量写状态随之撤销
+ *
+ * @return The result returned by the ExecuteSql operation
+ */
+int ContactsDataBase::BeginBulkWrite()
+{
+    if (store_ == nullptr) {
+        HILOG_ERROR("ContactsDataBase BeginBulkWrite store_ is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    // 个人名片库沿用逐行刷新的触发器
+    if (store_ != contactStore_) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    int ret = store_->ExecuteSql(BEGIN_BULK_WRITE_SESSION);
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("ContactsDataBase BeginBulkWrite failed :%{public}d", ret);
+    }
+    return ret;
+}
+
+/**
+ * @brief 结束批量写，按受影响的raw_contact_id一次重算contact的has_*标记
+ *
+ * @return The result returned by the ExecuteSql operation
+ */
+int ContactsDataBase::EndBulkWrite()
+{
+    if (store_ == nullptr) {
+        HILOG_ERROR("ContactsDataBase EndBulkWrite store_ is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    // 个人名片库沿用逐行刷新的触发器
+    if (store_ != contactStore_) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    const std::vector<std::string> statements = {RECORD_BULK_WRITE_BY_INSERTED_CONTACT_DATA,
+        RECOMPUTE_CONTACT_FLAGS_BY_BULK_WRITE, CLEAR_BULK_WRITE_RAW_CONTACT, END_BULK_WRITE_SESSION};
+    for (const auto &sql : statements) {
+        int ret = store_->ExecuteSql(sql);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            HILOG_ERROR("ContactsDataBase EndBulkWrite failed :%{public}d", ret);
+            return ret;
+        }
+    }
+    return OHOS::NativeRdb::E_OK;
+}
+
 /**
  * @brief Insert contact data into the raw_contact table
  *
@@ -1599,6 +1720,138 @@ int64_t ContactsDataBase::InsertContactData(
     return outDataRowId;
 }
 
+/**
+ * @brief Insert a group of contact_data rows with one BatchInsert, used by ExecuteBatch
+ *
+ * 须在事务内调用。id按sqlite_sequence预分配后显式写入，便于回填每条语句的结果和后续引用；
+ * 类型查询按content_type/type_id缓存，显示名更新按(raw_contact_id, 类型)只执行最后一条
+ *
+ * @param values contact_data rows, raw_contact_id already resolved
+ * @param isSync whether the rows come from cloud sync
+ * @param rowIds output, ids of the inserted rows in the order of values
+ * @param prepared output, false means validation failed before anything was written
+ *
+ * @return RDB_EXECUTE_OK on success
+ */
+int ContactsDataBase::InsertContactDataGroup(std::vector<OHOS::NativeRdb::ValuesBucket> &values,
+    const std::string &isSync, std::vector<int64_t> &rowIds, bool &prepared)
+{
+    prepared = false;
+    if (store_ == nullptr) {
+        HILOG_ERROR("ContactsDataBase InsertContactDataGroup store_ is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    std::vector<int> rawContactIds;
+    std::vector<int> typeIds;
+    std::vector<std::string> typeTexts;
+    std::map<std::string, std::pair<int, std::string>> typeCache;
+    for (auto &contactDataValues : values) {
+        int rawContactId = 0;
+        if (!contactDataValues.HasColumn(ContactDataColumns::RAW_CONTACT_ID)) {
+            HILOG_ERROR("InsertContactDataGroup raw_contact_id is required");
+            return RDB_EXECUTE_FAIL;
+        }
+        OHOS::NativeRdb::ValueObject value;
+        contactDataValues.GetObject(ContactDataColumns::RAW_CONTACT_ID, value);
+        GetContactByValue(rawContactId, value);
+        if (rawContactId <= 0) {
+            HILOG_ERROR("InsertContactDataGroup raw_contact_id is required %{public}d", rawContactId);
+            return RDB_EXECUTE_FAIL;
+        }
+        std::string typeKey;
+        OHOS::NativeRdb::ValueObject typeValue;
+        if (contactDataValues.GetObject(ContentTypeColumns::CONTENT_TYPE, typeValue)) {
+            typeValue.GetString(typeKey);
+            typeKey = "content_type:" + typeKey;
+        } else if (contactDataValues.GetObject(ContactDataColumns::TYPE_ID, typeValue)) {
+            int typeIdValue = 0;
+            GetContactByValue(typeIdValue, typeValue);
+            typeKey = "type_id:" + std::to_string(typeIdValue);
+        }
+        auto it = typeCache.find(typeKey);
+        if (it == typeCache.end()) {
+            int typeId = RDB_EXECUTE_FAIL;
+            std::string typeText;
+            int retCode = GetTypeText(contactDataValues, typeId, rawContactId, typeText);
+            if (retCode != OHOS::NativeRdb::E_OK || typeId <= 0) {
+                HILOG_ERROR("InsertContactDataGroup getTypeText code:%{public}d, typeId:%{public}d", retCode, typeId);
+                return RDB_EXECUTE_FAIL;
+            }
+            it = typeCache.emplace(typeKey, std::make_pair(typeId, typeText)).first;
+        }
+        rawContactIds.push_back(rawContactId);
+        typeIds.push_back(it->second.first);
+        typeTexts.push_back(it->second.second);
+    }
+    int64_t lastId = 0;
+    auto resultSet = store_->QuerySql("SELECT seq FROM sqlite_sequence WHERE name = ?",
+        std::vector<std::string> {ContactTableName::CONTACT_DATA});
+    if (resultSet == nullptr) {
+        HILOG_ERROR("InsertContactDataGroup query sqlite_sequence failed");
+        return RDB_EXECUTE_FAIL;
+    }
+    if (resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+        resultSet->GetLong(0, lastId);
+    }
+    resultSet->Close();
+    prepared = true;
+    bool isPrivacySpace = PrivacyContactsManager::IsPrivacySpace();
+    for (size_t i = 0; i < values.size(); i++) {
+        OHOS::NativeRdb::ValuesBucket &contactDataValues = values[i];
+        contactDataValues.Delete(ContentTypeColumns::CONTENT_TYPE);
+        contactDataValues.PutInt(ContactDataColumns::TYPE_ID, typeIds[i]);
+        updateFormatPhoneNumber(typeIds[i], contactDataValues);
+        FillingNumberLocation(typeIds[i], contactDataValues);
+        contactDataValues.Delete(ContactDataColumns::ID);
+        contactDataValues.PutLong(ContactDataColumns::ID, lastId + static_cast<int64_t>(i) + 1);
+        ContactsDataBase::updateContactIdVector.production(rawContactIds[i]);
+        if (isSync != "true") {
+            mDirtyRawContacts.production(rawContactIds[i]);
+        }
+        if ((typeIds[i] == ContentTypeData::PHONE_INT_VALUE || typeIds[i] == ContentTypeData::NAME_INT_VALUE) &&
+            contactDataValues.HasColumn(ContactDataColumns::DETAIL_INFO)) {
+            mUpdateRawContacts.push_back(rawContactIds[i]);
+        }
+    }
+    int64_t outInsertNum = 0;
+    int ret = HandleRdbStoreRetry([&]() {
+        return store_->BatchInsert(outInsertNum, ContactTableName::CONTACT_DATA, values);
+    });
+    if (ret == OHOS::NativeRdb::E_SQLITE_CORRUPT) {
+        ret = store_->Restore("contacts.db.bak");
+        HILOG_ERROR("InsertContactDataGroup Insert Restore retCode= %{public}d", ret);
+    }
+    if (ret != OHOS::NativeRdb::E_OK || outInsertNum != static_cast<int64_t>(values.size())) {
+        HILOG_ERROR("InsertContactDataGroup failed:%{public}d, num:%{public}lld", ret, (long long) outInsertNum);
+        return RDB_EXECUTE_FAIL;
+    }
+    // 显示名/公司只取决于最后一条数据，同一联系人同类型只更新一次；
+    // 逐条插入时没有公司和职位的组织数据不更新raw_contact，这里同样取最后一条非空的组织数据
+    std::map<std::pair<int, std::string>, size_t> displayRows;
+    ContactsUpdateHelper contactsUpdateHelper;
+    for (size_t i = 0; i < values.size(); i++) {
+        rowIds.push_back(lastId + static_cast<int64_t>(i) + 1);
+        if (typeIds[i] == ContentTypeData::PHONE_INT_VALUE && isPrivacySpace) {
+            PrivacyContactsManager::GetInstance()->InsertContactDataToPrivacyBackup(values[i]);
+        }
+        if (typeTexts[i] == ContentTypeData::ORGANIZATION &&
+            contactsUpdateHelper.GetUpdateCompanyValuesBucket(values[i], false).Size() <= 0) {
+            continue;
+        }
+        displayRows[std::make_pair(rawContactIds[i], typeTexts[i])] = i;
+    }
+    for (const auto &row : displayRows) {
+        std::vector<int> rawContactIdVector {row.first.first};
+        std::string typeText = row.first.second;
+        int updateDisplayRet = GetUpdateDisplayRet(typeText, rawContactIdVector, values[row.second]);
+        if (updateDisplayRet != OHOS::NativeRdb::E_OK) {
+            HILOG_ERROR("InsertContactDataGroup UpdateDisplay failed:%{public}d", updateDisplayRet);
+            return RDB_EXECUTE_FAIL;
+        }
+    }
+    return RDB_EXECUTE_OK;
+}
+
 /**
  * @brief Insert data into table privacy_contacts_backup
  *
@@ -1626,6 +1879,7 @@ int64_t ContactsDataBase::InsertPrivacyContactsBackup(
         HILOG_ERROR("InsertPrivacyContactsBackup failed:%{public}d,ts = %{public}lld", ret, (long long) time(NULL));
         return RDB_EXECUTE_FAIL;
     }
+    PrivacyContactsManager::GetInstance()->InvalidatePrivacyNumberCache();
     return outDataRowId;
 }
 
@@ -1657,6 +1911,7 @@ int64_t ContactsDataBase::BatchInsertPrivacyContactsBackup(
         HILOG_ERROR("BatchInsertPrivacyContactsBackup failed:%{public}d,ts = %{public}lld", ret, (long long) time(NULL));
         return RDB_EXECUTE_FAIL;
     }
+    PrivacyContactsManager::GetInstance()->InvalidatePrivacyNumberCache();
     return outDataRowNum;
 }
 
@@ -1688,8 +1943,8 @@ int64_t ContactsDataBase::BatchInsert(
         this->RollBack();
         return ret;
     }
-
-    ret = this->Commit();
+    // 批量插入与预处理放在同一事务内，has_*标记在批量写结束时统一重算
+    ret = this->BeginBulkWrite();
     if (ret != OHOS::NativeRdb::E_OK) {
         this->RollBack();
         return ret;
@@ -1698,12 +1953,21 @@ int64_t ContactsDataBase::BatchInsert(
     ret = HandleRdbStoreRetry([&]() {
         return store_->BatchInsert(outDataRowId, table, batchInsertValues);
     });
+    if (ret == OHOS::NativeRdb::E_OK) {
+        ret = this->EndBulkWrite();
+    }
+    if (ret == OHOS::NativeRdb::E_OK) {
+        ret = this->Commit();
+    }
+    if (ret != OHOS::NativeRdb::E_OK) {
+        this->RollBack();
+    }
     if (ret == OHOS::NativeRdb::E_SQLITE_CORRUPT) {
         ret = store_->Restore("contacts.db.bak");
         HILOG_ERROR("BatchInsert Insert Restore retCode= %{public}d", ret);
     }
     if (ret != OHOS::NativeRdb::E_OK) {
-        HILOG_ERROR("CallLogDataBase InsertCallLog ret :%{public}d", ret);
+        HILOG_ERROR("ContactsDataBase BatchInsert ret :%{public}d", ret);
         return RDB_EXECUTE_FAIL;
     }
     SyncBirthToCalAfterBatchInsert(batchInsertValues, values, size);
@@ -2176,25 +2440,18 @@ std::map<std::string, int64_t> ContactsDataBase::QueryIsInBlockList(
         HILOG_INFO("QueryIsInBlockList end no need query.");
         return result;
     }
-    auto predicates = OHOS::NativeRdb::RdbPredicates(ContactTableName::CONTACT_BLOCKLIST);
-    std::string queryWheres;
-    std::string queryArg;
-    queryArg.append("(");
+    std::vector<std::string> phoneNumbers;
     for (auto iter = values.begin(); iter != values.end(); iter++) {
-        queryArg.append("'").append(iter->first).append("', ");
-    }
-    int subLength = 2;
-    queryArg = queryArg.substr(0, queryArg.length() - subLength);
-    queryArg.append(")");
-    queryWheres.append("format_phone_number").append(" in ").append(queryArg);
-    // 批量添加黑名单只会与白名单冲突
-    queryWheres.append(" and types = 1");
-    predicates.SetWhereClause(queryWheres);
-
-    std::vector<std::string> columns;
-    columns.push_back(ContactBlockListColumns::FORMAT_PHONE_NUMBER);
-    columns.push_back(ContactBlockListColumns::ID);
-    auto resultSet = BlocklistDataBase::store_->Query(predicates, columns);
+        phoneNumbers.push_back(iter->first);
+    }
+    // 号码集合作为一个JSON数组参数，SQL文本与号码个数无关；批量添加黑名单只会与白名单冲突
+    static const std::string querySql = std::string("SELECT ") + ContactBlockListColumns::FORMAT_PHONE_NUMBER +
+        ", " + ContactBlockListColumns::ID + " FROM " + ContactTableName::CONTACT_BLOCKLIST +
+        " WHERE format_phone_number IN (SELECT value FROM json_each(?)) and types = 1";
+    std::vector<std::string> args;
+    args.push_back(SqlStatementCache::ToJsonArray(phoneNumbers));
+    auto resultSet = SqlStatementCache::GetInstance()->QuerySql(
+        BlocklistDataBase::store_, SqlTemplateId::QUERY_IS_IN_BLOCK_LIST, querySql, args);
     if (resultSet == nullptr) {
         return result;
     }
@@ -2437,20 +2694,24 @@ int ContactsDataBase::QueryInterceptionCallCount(std::string phoneNumber)
 {
     int interceptionCallCount = 0;
     // 搜索统计通话被拦截（answer_state = 6）,拦截类型为全匹配（block_reason = 1）的次数
-    std::string queryInterceptionCallCount =
-        "select count(*) as interception_call_count, phone_number from calllog where answer_state = 6 ";
-    queryInterceptionCallCount.append("and block_reason = 1 ");
-    if (phoneNumber.length() >= ENHANCED_QUERY_LENGTH) {
+    bool isFuzzyMatch = phoneNumber.length() >= ENHANCED_QUERY_LENGTH;
+    std::vector<std::string> args;
+    if (isFuzzyMatch) {
         // 当号码长度大于7时模糊匹配后七位
-        queryInterceptionCallCount.append(
-            "and phone_number like '%" +
-            phoneNumber.substr(phoneNumber.length() - ENHANCED_QUERY_LENGTH, ENHANCED_QUERY_LENGTH) + "' ");
+        args.push_back("%" + phoneNumber.substr(phoneNumber.length() - ENHANCED_QUERY_LENGTH, ENHANCED_QUERY_LENGTH));
     } else {
         // 小于七位直接匹配
-        queryInterceptionCallCount.append("and phone_number = '" + phoneNumber + "' ");
-    }
-    queryInterceptionCallCount.append("group by phone_number");
-    auto resultSet = CallLogDataBase::store_->QuerySql(queryInterceptionCallCount);
+        args.push_back(phoneNumber);
+    }
+    static const std::string likeSql = "select count(*) as interception_call_count, phone_number from calllog "
+        "where answer_state = 6 and block_reason = 1 and phone_number like ? group by phone_number";
+    static const std::string equalSql = "select count(*) as interception_call_count, phone_number from calllog "
+        "where answer_state = 6 and block_reason = 1 and phone_number = ? group by phone_number";
+    auto resultSet = isFuzzyMatch ?
+        SqlStatementCache::GetInstance()->QuerySql(
+            CallLogDataBase::store_, SqlTemplateId::INTERCEPTION_CALL_COUNT_LIKE, likeSql, args) :
+        SqlStatementCache::GetInstance()->QuerySql(
+            CallLogDataBase::store_, SqlTemplateId::INTERCEPTION_CALL_COUNT_EQUAL, equalSql, args);
     if (resultSet == nullptr) {
         HILOG_ERROR("QueryInterceptionCallCount QuerySqlResult is null");
         return interceptionCallCount;
@@ -2617,6 +2878,7 @@ int ContactsDataBase::UpdatePrivacyContactsBackup(
         HILOG_ERROR("UpdatePrivacyContactsBackup failed:%{public}d", ret);
         return RDB_EXECUTE_FAIL;
     }
+    PrivacyContactsManager::GetInstance()->InvalidatePrivacyNumberCache();
     return changedRows;
 }
 
@@ -3421,8 +3683,11 @@ int ContactsDataBase::UpdateRawContact(
     // 畅连更新头像字段时，异步刷新通话记录
     if (values.HasColumn(RawContactColumns::EXTRA3)) {
         std::unique_ptr<AsyncItem> task = std::make_unique<AsyncMeetimeAvatarAddTask>(rawContactIdVector, store_);
-        g_asyncTaskQueue->Push(task);
-        g_asyncTaskQueue->Start();
+        if (g_asyncTaskQueue->Push(task)) {
+            g_asyncTaskQueue->Start();
+        } else {
+            HILOG_ERROR("UpdateRawContact push async task failed");
+        }
     }
 
     // Update dirty when the favorite or favoriteorder field is contained.
@@ -3879,6 +4144,7 @@ int ContactsDataBase::DeletePrivacyContactsBackup(OHOS::NativeRdb::RdbPredicates
         return RDB_EXECUTE_FAIL;
     }
     HILOG_WARN("DeletePrivacyContactsBackup deletedRows :%{public}d", deletedRows);
+    PrivacyContactsManager::GetInstance()->InvalidatePrivacyNumberCache();
     return RDB_EXECUTE_OK;
 }
 
@@ -3935,6 +4201,7 @@ int ContactsDataBase::DeleteContact(OHOS::NativeRdb::RdbPredicates &rdbPredicate
         RollBack();
         return RDB_EXECUTE_FAIL;
     }
+    SideEffectOutbox::GetInstance()->Schedule();
     // 删除 异步发送通知
     std::string paramStr = "delete;";
     std::string callingBundleName = getCallingBundleName();
@@ -4087,24 +4354,31 @@ int ContactsDataBase::DeleteExecute(
     // 更新raw表，包括is_deleted、dirty字段
     ret = DeleteExecuteUpdate(rawIdVector);
     deleteSize = rawIdVector.size();
+    if (ret != OHOS::NativeRdb::E_OK) {
+        return ret;
+    }
 
     if (PrivacyContactsManager::IsPrivacySpace()) {
         HILOG_WARN("deleteContact rawIdVector size :%{public}zu, ", rawIdVector.size());
         PrivacyContactsManager::GetInstance()->DeleteContactsFromPrivacyBackup(rawIdVector);
     }
-    // 删除联系人之后，清除日历中的生日信息
+    // 删除联系人之后，清除日历中的生日信息，记录到outbox中由后台任务批量执行
+    std::shared_ptr<SideEffectOutbox> outbox = SideEffectOutbox::GetInstance();
     std::string calendarEventIds;
     QueryCalendarIds(rawIdVector, calendarEventIds);
     if (calendarEventIds.length() > 0) {
         calendarEventIds = calendarEventIds.substr(0, calendarEventIds.length() - 1);
-        contactsConnectAbility_ = OHOS::Contacts::ContactConnectAbility::GetInstance();
-        contactsConnectAbility_->ConnectEventsHandleAbility(CONTACTS_BIRTHDAY_DELETE, calendarEventIds, "");
+        ret = outbox->Record(store_, SideEffectType::CALENDAR_DELETE, calendarEventIds);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
     }
 
     // 如果非云空间删除行为，则触发数据上云
     if (isSync != "true") {
-        contactsConnectAbility_->ConnectAbility("", "", "", "", "", "");
+        ret = outbox->Record(store_, SideEffectType::CLOUD_UPLOAD, "");
     }
+    // outbox在调用方提交事务后再调度，避免后台任务先于提交执行而读不到记录
     return ret;
 }
 
@@ -4209,7 +4483,10 @@ int ContactsDataBase::DeleteExecuteUpdate(std::vector<int> &rawIdVector)
 void ContactsDataBase::DeletedRelationAsyncTask(int rawContactId)
 {
     std::unique_ptr<AsyncItem> task = std::make_unique<AsyncDeleteRelationContactsTask>(rawContactId);
-    g_asyncTaskQueue->Push(task);
+    if (!g_asyncTaskQueue->Push(task)) {
+        HILOG_ERROR("DeletedRelationAsyncTask push async task failed");
+        return;
+    }
     g_asyncTaskQueue->Start();
 }
 
@@ -4583,48 +4860,70 @@ int ContactsDataBase::HardDelete(OHOS::NativeRdb::RdbPredicates &rdbPredicates)
         RollBack();
         return RDB_EXECUTE_FAIL;
     }
+    // 卡片刷新、通话记录、日历、铃声、云同步等副作用与删除在同一事务内写入outbox，提交后由后台任务批量执行
+    ret = RecordHardDeleteSideEffects(contactIdSet, calendarEventIds, ringtoneUris);
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("HardDelete RecordHardDeleteSideEffects error:%{public}d", ret);
+        RollBack();
+        return RDB_EXECUTE_FAIL;
+    }
     ret = Commit();
     if (ret != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR("HardDelete commit error:%{public}d", ret);
         RollBack();
         return RDB_EXECUTE_FAIL;
     }
-    // 有硬删除通知刷新卡片信息
-    int notifyFormIdChangeResCode = contactsConnectAbility_->ConnectAbility(
-        "", "", "", "", "notifyFormIdChange", "hardDelOperate");
-    if (notifyFormIdChangeResCode != OHOS::NativeRdb::E_OK) {
-        HILOG_ERROR("HardDelete notifyFormIdChange fail:%{public}d", notifyFormIdChangeResCode);
-    }
+    SideEffectOutbox::GetInstance()->Schedule();
     // 删除成功了，通知变更的id
     ContactsDataBase::deleteContactIdVector.productionMultiple(notifyDeleteRawIdVector);
-    // 更新通话记录
-    std::vector<std::string> deleteContactIdVector;
-    deleteContactIdVector.assign(contactIdSet.begin(), contactIdSet.end());
-    ContactsUpdateHelper contactsUpdateHelper;
-    contactsUpdateHelper.UpdateCallLogWhenBatchDelContact(deleteContactIdVector, store_);
     // 更新硬删除时间戳
     UpdateHardDeleteTimeStamp();
 
     // 看板上报，回收站彻底删除上报
     boardReportHardDelete(rawContactIds.size(), "");
+    HILOG_INFO("HardDelete end succeed, size: %{public}ld",
+        (long) contactIdSet.size());
+    return contactIdSet.size();
+}
 
+int ContactsDataBase::RecordHardDeleteSideEffects(const std::set<std::string> &contactIdSet,
+    std::string calendarEventIds, const std::vector<std::string> &ringtoneUris)
+{
+    std::shared_ptr<SideEffectOutbox> outbox = SideEffectOutbox::GetInstance();
+    // 有硬删除通知刷新卡片信息
+    int ret = outbox->Record(store_, SideEffectType::FORM_CHANGE, "hardDelOperate");
+    if (ret != OHOS::NativeRdb::E_OK) {
+        return ret;
+    }
+    // 更新通话记录
+    if (!contactIdSet.empty()) {
+        std::string contactIds;
+        for (auto &contactId : contactIdSet) {
+            contactIds.append(contactId).append(",");
+        }
+        contactIds = contactIds.substr(0, contactIds.length() - 1);
+        ret = outbox->Record(store_, SideEffectType::CALLLOG_UNLINK, contactIds);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
+    }
     // 删除日历信息
     if (calendarEventIds.length() > 0) {
         calendarEventIds = calendarEventIds.substr(0, calendarEventIds.length() - 1);
-        contactsConnectAbility_ = OHOS::Contacts::ContactConnectAbility::GetInstance();
-        contactsConnectAbility_->ConnectEventsHandleAbility(CONTACTS_BIRTHDAY_DELETE, calendarEventIds, "");
+        ret = outbox->Record(store_, SideEffectType::CALENDAR_DELETE, calendarEventIds);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
+        }
     }
     HILOG_INFO("HardDelete, ringtoneUris.size is: %{public}ld", (long) ringtoneUris.size());
-    if (ringtoneUris.size() > 0) {
-        for (unsigned long i = 0; i < ringtoneUris.size(); i++) {
-            DeletePersonalRingtone(ringtoneUris[i]);
+    for (auto &ringtoneUri : ringtoneUris) {
+        ret = outbox->Record(store_, SideEffectType::RINGTONE_DELETE, ringtoneUri);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            return ret;
         }
     }
     // 触发次云同步
-    SyncContacts();
-    HILOG_INFO("HardDelete end succeed, size: %{public}ld",
-        (long) contactIdSet.size());
-    return contactIdSet.size();
+    return outbox->Record(store_, SideEffectType::CLOUD_SYNC, "");
 }
 
 void ContactsDataBase::ReportOperationAuditLog(const std::vector<std::string> &rawContactIds)
@@ -5688,10 +5987,18 @@ std::shared_ptr<OHOS::NativeRdb::ResultSet> ContactsDataBase::QueryViewContact(s
         return nullptr;
     }
     auto predicates = OHOS::NativeRdb::RdbPredicates(ViewName::VIEW_CONTACT);
-    std::string queryWheres = "is_deleted <> 1 AND primary_contact <> 1 AND id IN (" 
-                              + queryArg + ") order by sort, sort_key asc";
+    // queryArg为逗号分隔的id，拼成JSON数组作为参数，相同列的查询SQL文本不变
+    std::string queryWheres = "is_deleted <> 1 AND primary_contact <> 1 AND id IN (SELECT value FROM json_each(?)) "
+                              "order by sort, sort_key asc";
     predicates.SetWhereClause(queryWheres);
+    std::vector<std::string> whereArgs;
+    whereArgs.push_back("[" + queryArg + "]");
+    predicates.SetWhereArgs(whereArgs);
+    auto start = std::chrono::steady_clock::now();
     auto resultSet = store_->QueryByStep(predicates, columns);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    SqlStatementCache::GetInstance()->RecordQuery(SqlTemplateId::QUERY_VIEW_CONTACT,
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
 
     if (resultSet == nullptr) {
         HILOG_ERROR("QueryViewContact error");
@@ -5937,66 +6244,63 @@ std::string ContactsDataBase::StructureDeleteContactJson(
 int SqliteOpenHelperContactCallback::OnCreate(OHOS::NativeRdb::RdbStore &store)
 {
     HILOG_INFO("ContactsDataBase OnCreate contacts db");
-    std::vector<int> judgeSuccess;
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_INDEX));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_RAW_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_RAW_CONTACT_INDEX));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_RAW_CONTACT_INDEX_UNIQUE_KEY));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_RAW_CONTACT_INDEX_SORT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_DATA));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_INDEX_DATA1));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_INDEX_DATA2));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_BLOCKLIST));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_LOCAL_LANG));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_ACCOUNT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_PHOTO_FILES));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_TYPE));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_GROUPS));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_DELETED_RAW_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_SEARCH_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_SEARCH_CONTACT_INDEX1));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_SEARCH_CONTACT_INDEX2));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_SEARCH_CONTACT_VIEW));
-    judgeSuccess.push_back(store.ExecuteSql(MERGE_INFO));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_CONTACT_DATA));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_RAW_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_CONTACT_LOCATION));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_GROUPS));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_VIEW_DELETED));
-    judgeSuccess.push_back(store.ExecuteSql(UPDATE_RAW_CONTACT_VERSION));
-    judgeSuccess.push_back(store.ExecuteSql(INSERT_CONTACT_QUICK_SEARCH));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_DATABASE_BACKUP_TASK));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_INSERT_BACKUP_TIME));
-    judgeSuccess.push_back(store.ExecuteSql(UPDATE_CONTACT_BY_INSERT_CONTACT_DATA));
-    judgeSuccess.push_back(store.ExecuteSql(UPDATE_CONTACT_BY_DELETE_CONTACT_DATA));
-    judgeSuccess.push_back(store.ExecuteSql(UPDATE_CONTACT_BY_UPDATE_CONTACT_DATA));
-    judgeSuccess.push_back(store.ExecuteSql(MERGE_INFO_INDEX));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CLOUD_RAW_CONTACT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CLOUD_GROUPS));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_SETTINGS));
-    judgeSuccess.push_back(store.ExecuteSql(INIT_CHANGE_TIME));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CONTACT_BLOCKLIST_INDEX_PHONE));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_HW_ACCOUNT));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_CLOUD_CONTACT_BLOCKLIST));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_PRIVACY_CONTACTS_BACKUP));
-    judgeSuccess.push_back(store.ExecuteSql(CREATE_POSTER));
-    unsigned int size = judgeSuccess.size();
-    unsigned int successCount = size;
-    for (unsigned int i = 0; i < size; i++) {
-        int ret = judgeSuccess[i];
+    auto start = std::chrono::steady_clock::now();
+    // 建库只提交一次，避免每条建表语句单独落盘
+    bool inTransaction = BeginTransaction(store) == OHOS::NativeRdb::E_OK;
+    int failCount = CreateSchema(store);
+    if (inTransaction && Commit(store) != OHOS::NativeRdb::E_OK) {
+        RollBack(store);
+        // 事务提交失败时不带事务重建一次，尽量建出能建的表，缺失的由开库检查补齐
+        failCount = CreateSchema(store);
+    }
+    if (failCount == 0) {
+        BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_CREATE, CONTACTS_DB, 0, "OnCreate success");
+    }
+    HILOG_WARN("ContactsDataBase OnCreate end, failCount = %{public}d, cost = %{public}lld ms", failCount,
+        (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    return OHOS::NativeRdb::E_OK;
+}
+
+int SqliteOpenHelperContactCallback::CreateSchema(OHOS::NativeRdb::RdbStore &store)
+{
+    int failCount = 0;
+    unsigned int index = 0;
+    auto execute = [&store, &failCount, &index](const char *sql) {
+        int ret = store.ExecuteSql(sql);
         if (ret != OHOS::NativeRdb::E_OK) {
-            successCount--;
-            HILOG_ERROR("SqliteOpenHelperCallLogCallback create table index %{public}d error: %{public}d", i, ret);
+            failCount++;
+            HILOG_ERROR("SqliteOpenHelperContactCallback create table index %{public}u error: %{public}d", index, ret);
             BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_CREATE, CONTACTS_DB, ret,
-                                                      "create table " + std::to_string(i) + " error");
+                                                      "create table " + std::to_string(index) + " error");
         }
+        index++;
+    };
+    for (const char *sql : CONTACT_SCHEMA_STATEMENTS) {
+        execute(sql);
     }
-    if (successCount == size) {
-        BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_CREATE, CONTACTS_DB, 0, "OnCreate success");
+    for (const char *sql : CONTACT_SCHEMA_INDEXES) {
+        execute(sql);
     }
-    return OHOS::NativeRdb::E_OK;
+    return failCount;
+}
+
+void SqliteOpenHelperContactCallback::CreateSchemaIndexes(OHOS::NativeRdb::RdbStore &store)
+{
+    auto start = std::chrono::steady_clock::now();
+    bool inTransaction = BeginTransaction(store) == OHOS::NativeRdb::E_OK;
+    for (const char *sql : CONTACT_SCHEMA_INDEXES) {
+        int ret = store.ExecuteSql(sql);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            HILOG_ERROR("ContactsDataBase CreateSchemaIndexes failed: %{public}s, ret = %{public}d", sql, ret);
+        }
+    }
+    if (inTransaction && Commit(store) != OHOS::NativeRdb::E_OK) {
+        RollBack(store);
+    }
+    HILOG_WARN("ContactsDataBase CreateSchemaIndexes cost = %{public}lld ms",
+        (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
 }
 
 int SqliteOpenHelperContactCallback::OnUpgrade(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
@@ -6009,6 +6313,7 @@ int SqliteOpenHelperContactCallback::OnUpgrade(OHOS::NativeRdb::RdbStore &store,
     int result = OHOS::NativeRdb::E_OK;
     std::string dbName = "contacts.db";
     BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_BEFORE, dbName, oldVersion);
+    auto start = std::chrono::steady_clock::now();
     UpgradeUnderV10(store, oldVersion, newVersion);
     UpgradeUnderV20(store, oldVersion, newVersion);
     result = UpgradeUnderV30(store, oldVersion, newVersion);
@@ -6035,71 +6340,87 @@ int SqliteOpenHelperContactCallback::OnUpgrade(OHOS::NativeRdb::RdbStore &store,
                                                   "UpgradeUnderV45 fail");
         return result;
     }
-    BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, dbName, newVersion);
-    HILOG_INFO("ContactsDataBase OnUpgrade result is %{public}d", result);
+    // 各步骤中的数据修复完成后再统一补建索引
+    CreateSchemaIndexes(store);
+    long long cost = (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, dbName, newVersion,
+                                              "OnUpgrade cost " + std::to_string(cost) + " ms");
+    HILOG_WARN("ContactsDataBase OnUpgrade result is %{public}d, cost = %{public}lld ms", result, cost);
     return result;
 }
 
-void SqliteOpenHelperContactCallback::UpgradeUnderV10(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+int SqliteOpenHelperContactCallback::RunUpgradeStep(
+    OHOS::NativeRdb::RdbStore &store, int version, UpgradeStep step, int oldVersion, int newVersion)
 {
-    if (oldVersion < DATABASE_VERSION_2 && newVersion >= DATABASE_VERSION_2) {
-        UpgradeToV2(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_3 && newVersion >= DATABASE_VERSION_3) {
-        UpgradeToV3(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_4 && newVersion >= DATABASE_VERSION_4) {
-        UpgradeToV4(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_5 && newVersion >= DATABASE_VERSION_5) {
-        UpgradeToV5(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_6 && newVersion >= DATABASE_VERSION_6) {
-        UpgradeToV6(store, oldVersion, newVersion);
+    if (oldVersion >= version || newVersion < version) {
+        return OHOS::NativeRdb::E_OK;
     }
-    if (oldVersion < DATABASE_VERSION_7 && newVersion >= DATABASE_VERSION_7) {
-        UpgradeToV7(store, oldVersion, newVersion);
+    // 返回int的步骤自行管理事务，这里只计时
+    auto start = std::chrono::steady_clock::now();
+    int result = (this->*step)(store, oldVersion, newVersion);
+    long long cost = (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    HILOG_WARN("ContactsDataBase UpgradeToV%{public}d result = %{public}d, cost = %{public}lld ms",
+        version, result, cost);
+    if (cost >= UPGRADE_STEP_SLOW_MILLISECOND) {
+        BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, CONTACTS_DB, result,
+            "UpgradeToV" + std::to_string(version) + " slow, cost " + std::to_string(cost) + " ms");
     }
-    if (oldVersion < DATABASE_VERSION_8 && newVersion >= DATABASE_VERSION_8) {
-        UpgradeToV8(store, oldVersion, newVersion);
+    return result;
+}
+
+void SqliteOpenHelperContactCallback::RunUpgradeStep(
+    OHOS::NativeRdb::RdbStore &store, int version, VoidUpgradeStep step, int oldVersion, int newVersion)
+{
+    if (oldVersion >= version || newVersion < version) {
+        return;
     }
-    if (oldVersion < DATABASE_VERSION_9 && newVersion >= DATABASE_VERSION_9) {
-        UpgradeToV9(store, oldVersion, newVersion);
+    // 老版本的步骤逐条执行不检查结果，整体放进一个事务，只提交一次
+    auto start = std::chrono::steady_clock::now();
+    bool inTransaction = BeginTransaction(store) == OHOS::NativeRdb::E_OK;
+    (this->*step)(store, oldVersion, newVersion);
+    int result = OHOS::NativeRdb::E_OK;
+    if (inTransaction) {
+        result = Commit(store);
+        if (result != OHOS::NativeRdb::E_OK) {
+            RollBack(store);
+        }
     }
-    if (oldVersion < DATABASE_VERSION_10 && newVersion >= DATABASE_VERSION_10) {
-        UpgradeToV10(store, oldVersion, newVersion);
+    long long cost = (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    HILOG_WARN("ContactsDataBase UpgradeToV%{public}d result = %{public}d, cost = %{public}lld ms",
+        version, result, cost);
+    if (cost >= UPGRADE_STEP_SLOW_MILLISECOND) {
+        BoardReportUtil::BoardReportContactDbInfo(ContactDbInfo::DB_UPGRADE_AFTER, CONTACTS_DB, result,
+            "UpgradeToV" + std::to_string(version) + " slow, cost " + std::to_string(cost) + " ms");
     }
 }
 
+void SqliteOpenHelperContactCallback::UpgradeUnderV10(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+{
+    RunUpgradeStep(store, DATABASE_VERSION_2, &SqliteOpenHelperContactCallback::UpgradeToV2, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_3, &SqliteOpenHelperContactCallback::UpgradeToV3, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_4, &SqliteOpenHelperContactCallback::UpgradeToV4, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_5, &SqliteOpenHelperContactCallback::UpgradeToV5, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_6, &SqliteOpenHelperContactCallback::UpgradeToV6, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_7, &SqliteOpenHelperContactCallback::UpgradeToV7, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_8, &SqliteOpenHelperContactCallback::UpgradeToV8, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_9, &SqliteOpenHelperContactCallback::UpgradeToV9, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_10, &SqliteOpenHelperContactCallback::UpgradeToV10, oldVersion, newVersion);
+}
+
 void SqliteOpenHelperContactCallback::UpgradeUnderV20(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
 {
-    if (oldVersion < DATABASE_VERSION_11 && newVersion >= DATABASE_VERSION_11) {
-        UpgradeToV11(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_12 && newVersion >= DATABASE_VERSION_12) {
-        UpgradeToV12(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_13 && newVersion >= DATABASE_VERSION_13) {
-        UpgradeToV13(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_14 && newVersion >= DATABASE_VERSION_14) {
-        UpgradeToV14(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_15 && newVersion >= DATABASE_VERSION_15) {
-        UpgradeToV15(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_16 && newVersion >= DATABASE_VERSION_16) {
-        UpgradeToV16(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_17 && newVersion >= DATABASE_VERSION_17) {
-        UpgradeToV17(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_18 && newVersion >= DATABASE_VERSION_18) {
-        UpgradeToV18(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_19 && newVersion >= DATABASE_VERSION_19) {
-        UpgradeToV19(store, oldVersion, newVersion);
-    }
+    RunUpgradeStep(store, DATABASE_VERSION_11, &SqliteOpenHelperContactCallback::UpgradeToV11, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_12, &SqliteOpenHelperContactCallback::UpgradeToV12, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_13, &SqliteOpenHelperContactCallback::UpgradeToV13, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_14, &SqliteOpenHelperContactCallback::UpgradeToV14, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_15, &SqliteOpenHelperContactCallback::UpgradeToV15, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_16, &SqliteOpenHelperContactCallback::UpgradeToV16, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_17, &SqliteOpenHelperContactCallback::UpgradeToV17, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_18, &SqliteOpenHelperContactCallback::UpgradeToV18, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_19, &SqliteOpenHelperContactCallback::UpgradeToV19, oldVersion, newVersion);
 }
 
 int SqliteOpenHelperContactCallback::Commit(OHOS::NativeRdb::RdbStore &store)
@@ -6136,59 +6457,41 @@ int SqliteOpenHelperContactCallback::BeginTransaction(OHOS::NativeRdb::RdbStore
 int SqliteOpenHelperContactCallback::UpgradeUnderV30(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
 {
     int result = OHOS::NativeRdb::E_OK;
-    if (oldVersion < DATABASE_VERSION_20 && newVersion >= DATABASE_VERSION_20) {
-        UpgradeToV20(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_21 && newVersion >= DATABASE_VERSION_21) {
-        UpgradeToV21(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_22 && newVersion >= DATABASE_VERSION_22) {
-        UpgradeToV22(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_23 && newVersion >= DATABASE_VERSION_23) {
-        UpgradeToV23(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_24 && newVersion >= DATABASE_VERSION_24) {
-        UpgradeToV24(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_25 && newVersion >= DATABASE_VERSION_25) {
-        UpgradeToV25(store, oldVersion, newVersion);
-    }
-    if (oldVersion < DATABASE_VERSION_26 && newVersion >= DATABASE_VERSION_26) {
-        result = UpgradeToV26(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    RunUpgradeStep(store, DATABASE_VERSION_20, &SqliteOpenHelperContactCallback::UpgradeToV20, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_21, &SqliteOpenHelperContactCallback::UpgradeToV21, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_22, &SqliteOpenHelperContactCallback::UpgradeToV22, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_23, &SqliteOpenHelperContactCallback::UpgradeToV23, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_24, &SqliteOpenHelperContactCallback::UpgradeToV24, oldVersion, newVersion);
+    RunUpgradeStep(store, DATABASE_VERSION_25, &SqliteOpenHelperContactCallback::UpgradeToV25, oldVersion, newVersion);
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_26, &SqliteOpenHelperContactCallback::UpgradeToV26, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_27 && newVersion >= DATABASE_VERSION_27) {
-        result = UpgradeToV27(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_27, &SqliteOpenHelperContactCallback::UpgradeToV27, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_28 && newVersion >= DATABASE_VERSION_28) {
-        result = UpgradeToV28(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_28, &SqliteOpenHelperContactCallback::UpgradeToV28, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_29 && newVersion >= DATABASE_VERSION_29) {
-        result = UpgradeToV29(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_29, &SqliteOpenHelperContactCallback::UpgradeToV29, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_30 && newVersion >= DATABASE_VERSION_30) {
-        result = UpgradeToV30(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_30, &SqliteOpenHelperContactCallback::UpgradeToV30, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_31 && newVersion >= DATABASE_VERSION_31) {
-        result = UpgradeToV31(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_31, &SqliteOpenHelperContactCallback::UpgradeToV31, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
     return result;
 }
@@ -6196,29 +6499,25 @@ int SqliteOpenHelperContactCallback::UpgradeUnderV30(OHOS::NativeRdb::RdbStore &
 int SqliteOpenHelperContactCallback::UpgradeUnderV35(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
 {
     int result = OHOS::NativeRdb::E_OK;
-    if (oldVersion < DATABASE_VERSION_32 && newVersion >= DATABASE_VERSION_32) {
-        result = UpgradeToV32(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_32, &SqliteOpenHelperContactCallback::UpgradeToV32, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_33 && newVersion >= DATABASE_VERSION_33) {
-        result = UpgradeToV33(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_33, &SqliteOpenHelperContactCallback::UpgradeToV33, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_34 && newVersion >= DATABASE_VERSION_34) {
-        result = UpgradeToV34(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_34, &SqliteOpenHelperContactCallback::UpgradeToV34, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_35 && newVersion >= DATABASE_VERSION_35) {
-        result = UpgradeToV35(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_35, &SqliteOpenHelperContactCallback::UpgradeToV35, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
     return result;
 }
@@ -6226,35 +6525,30 @@ int SqliteOpenHelperContactCallback::UpgradeUnderV35(OHOS::NativeRdb::RdbStore &
 int SqliteOpenHelperContactCallback::UpgradeUnderV40(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
 {
     int result = OHOS::NativeRdb::E_OK;
-    if (oldVersion < DATABASE_VERSION_36 && newVersion >= DATABASE_VERSION_36) {
-        result = UpgradeToV36(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_36, &SqliteOpenHelperContactCallback::UpgradeToV36, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_37 && newVersion >= DATABASE_VERSION_37) {
-        result = UpgradeToV37(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_37, &SqliteOpenHelperContactCallback::UpgradeToV37, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_38 && newVersion >= DATABASE_VERSION_38) {
-        result = UpgradeToV38(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_38, &SqliteOpenHelperContactCallback::UpgradeToV38, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_39 && newVersion >= DATABASE_VERSION_39) {
-        result = UpgradeToV39(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_39, &SqliteOpenHelperContactCallback::UpgradeToV39, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_40 && newVersion >= DATABASE_VERSION_40) {
-        result = UpgradeToV40(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_40, &SqliteOpenHelperContactCallback::UpgradeToV40, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
     return result;
 }
@@ -6262,23 +6556,30 @@ int SqliteOpenHelperContactCallback::UpgradeUnderV40(OHOS::NativeRdb::RdbStore &
 int SqliteOpenHelperContactCallback::UpgradeUnderV45(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
 {
     int result = OHOS::NativeRdb::E_OK;
-    if (oldVersion < DATABASE_VERSION_41 && newVersion >= DATABASE_VERSION_41) {
-        result = UpgradeToV41(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_41, &SqliteOpenHelperContactCallback::UpgradeToV41, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_42 && newVersion >= DATABASE_VERSION_42) {
-        result = UpgradeToV42(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_42, &SqliteOpenHelperContactCallback::UpgradeToV42, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
-    if (oldVersion < DATABASE_VERSION_43 && newVersion >= DATABASE_VERSION_43) {
-        result = UpgradeToV43(store, oldVersion, newVersion);
-        if (result != OHOS::NativeRdb::E_OK) {
-            return result;
-        }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_43, &SqliteOpenHelperContactCallback::UpgradeToV43, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
+    }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_44, &SqliteOpenHelperContactCallback::UpgradeToV44, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
+    }
+    result = RunUpgradeStep(
+        store, DATABASE_VERSION_45, &SqliteOpenHelperContactCallback::UpgradeToV45, oldVersion, newVersion);
+    if (result != OHOS::NativeRdb::E_OK) {
+        return result;
     }
     return result;
 }
@@ -6358,15 +6659,16 @@ void SqliteOpenHelperContactCallback::UpgradeToV6(OHOS::NativeRdb::RdbStore &sto
     HILOG_INFO("UpgradeToV6 start!");
     // 1, raw_contact add sort_key
     store.ExecuteSql(RAW_CONTACT_ADD_SORT_KEY);
-    // 2, 查询所有记录，更新sortKey，更新无名氏的sort数字和sort首字母
-    UpdateSrotInfoByDisplayName(store);
+    // 2, 查询所有记录，更新sortKey，更新无名氏的sort数字和sort首字母；升级到V10时会重算，这里跳过
+    if (newVersion < DATABASE_VERSION_10) {
+        UpdateSrotInfoByDisplayName(store);
+    }
     // 3，view操作，需要加个字段，删除重建
     store.ExecuteSql("drop view if exists view_contact;");
     store.ExecuteSql("drop view if exists view_raw_contact;");
     store.ExecuteSql(CREATE_VIEW_CONTACT);
     store.ExecuteSql(CREATE_VIEW_RAW_CONTACT);
-    // 4，索引操作
-    store.ExecuteSql(CREATE_RAW_CONTACT_INDEX_SORT);
+    // 4，索引在OnUpgrade最后统一创建
     HILOG_INFO("UpgradeToV6 end!");
 }
 
@@ -6399,7 +6701,10 @@ void SqliteOpenHelperContactCallback::UpgradeToV8(OHOS::NativeRdb::RdbStore &sto
 
     // create view
     store.ExecuteSql(CREATE_VIEW_CONTACT_DATA);
-    UpdateFormatPhoneNumber(store);
+    // 升级到V10时会重算，这里跳过
+    if (newVersion < DATABASE_VERSION_10) {
+        UpdateFormatPhoneNumber(store);
+    }
 }
 
 void SqliteOpenHelperContactCallback::UpgradeToV9(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
@@ -6449,20 +6754,10 @@ void SqliteOpenHelperContactCallback::UpgradeToV10(OHOS::NativeRdb::RdbStore &st
     store.ExecuteSql("drop view if exists view_raw_contact;");
     store.ExecuteSql(CREATE_VIEW_CONTACT);
     store.ExecuteSql(CREATE_VIEW_RAW_CONTACT);
-    // 4，索引操作
-    store.ExecuteSql(CREATE_RAW_CONTACT_INDEX_SORT);
-    // 2, 查询所有记录，更新sortKey，更新无名氏的sort数字和sort首字母
-    int ret = store.BeginTransaction();
-    if (ret != OHOS::NativeRdb::E_OK) {
-        HILOG_ERROR("DetialInfoTrimSpace BeginTransaction failed");
-    }
+    // 2, 查询所有记录，更新sortKey，更新无名氏的sort数字和sort首字母，事务由RunUpgradeStep开启
     UpdateFormatPhoneNumber(store);
     UpdateSrotInfoByDisplayName(store);
-    ret = store.Commit();
-    if (ret != OHOS::NativeRdb::E_OK) {
-        store.RollBack();
-        HILOG_ERROR("DetialInfoTrimSpace update failed and rollback");
-    }
+    // 4，索引在OnUpgrade最后统一创建，避免批量更新sort时逐行维护索引
     HILOG_INFO("UpgradeToV10 end");
 }
 
@@ -6785,10 +7080,14 @@ int SqliteOpenHelperContactCallback::UpgradeToV26(OHOS::NativeRdb::RdbStore &sto
         return OHOS::NativeRdb::E_OK;
     }
 
+    int result = BeginTransaction(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV26 BeginTransaction failed, ret:%{public}d", result);
+        return result;
+    }
     // update contact_data table
     SqlAnalyzer sqlAnalyzer;
     bool isExists = sqlAnalyzer.CheckColumnExists(store, "contact_data", "is_sync_birthday_to_calendar");
-    int result = OHOS::NativeRdb::E_OK;
     if (!isExists) {
         // 添加生日是否同步到日历标识字段，默认值为0，代表未同步， 1代表已同步
         result = store.ExecuteSql(CONTACT_DATA_ADD_IS_SYNC_BIRTHDAY_TO_CALENDAR);
@@ -6796,18 +7095,27 @@ int SqliteOpenHelperContactCallback::UpgradeToV26(OHOS::NativeRdb::RdbStore &sto
     if (result != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR(
             "ContactsDataBase UpgradeToV26 alter is_sync_birthday_to_calendar failed, result is %{public}d", result);
+        RollBack(store);
         return result;
     }
     // drop view
     result = store.ExecuteSql("drop view if exists view_contact_data;");
     if (result != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR("ContactsDataBase UpgradeToV26 drop view_contact_data failed, result is %{public}d", result);
+        RollBack(store);
         return result;
     }
     // create view
     result = store.ExecuteSql(CREATE_VIEW_CONTACT_DATA);
     if (result != OHOS::NativeRdb::E_OK) {
         HILOG_ERROR("ContactsDataBase UpgradeToV26 create view_contact_data failed, result is %{public}d", result);
+        RollBack(store);
+        return result;
+    }
+    result = Commit(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV26 Commit failed, ret:%{public}d", result);
+        RollBack(store);
     }
     return result;
 }
@@ -7485,6 +7793,64 @@ int SqliteOpenHelperContactCallback::UpgradeToV43(OHOS::NativeRdb::RdbStore &sto
     return result;
 }
 
+int SqliteOpenHelperContactCallback::UpgradeToV44(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+{
+    HILOG_WARN("UpgradeToV44 oldVersion is %{public}d , newVersion is %{public}d", oldVersion, newVersion);
+    if (oldVersion >= newVersion) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    int result = BeginTransaction(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV44 BeginTransaction failed, ret:%{public}d", result);
+        return result;
+    }
+    result = store.ExecuteSql(CREATE_SIDE_EFFECT_OUTBOX);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV44 create side_effect_outbox table failed, result is %{public}d", result);
+        RollBack(store);
+        return result;
+    }
+    result = Commit(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV44 Commit failed, ret:%{public}d", result);
+        RollBack(store);
+    }
+    return result;
+}
+
+// contact_data的has_*触发器支持批量写模式，批量写期间跳过逐行刷新，结束时一次重算
+int SqliteOpenHelperContactCallback::UpgradeToV45(OHOS::NativeRdb::RdbStore &store, int oldVersion, int newVersion)
+{
+    HILOG_WARN("UpgradeToV45 oldVersion is %{public}d , newVersion is %{public}d", oldVersion, newVersion);
+    if (oldVersion >= newVersion) {
+        return OHOS::NativeRdb::E_OK;
+    }
+    int result = BeginTransaction(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV45 BeginTransaction failed, ret:%{public}d", result);
+        return result;
+    }
+    const std::vector<std::string> statements = {CREATE_BULK_WRITE_SESSION, CREATE_BULK_WRITE_RAW_CONTACT,
+        "DROP TRIGGER IF EXISTS update_contact_by_insert_contact_data",
+        "DROP TRIGGER IF EXISTS update_contact_by_delete_contact_data",
+        "DROP TRIGGER IF EXISTS update_contact_by_update_contact_data",
+        BULK_AWARE_UPDATE_CONTACT_BY_INSERT_CONTACT_DATA, BULK_AWARE_UPDATE_CONTACT_BY_DELETE_CONTACT_DATA,
+        BULK_AWARE_UPDATE_CONTACT_BY_UPDATE_CONTACT_DATA, RECORD_BULK_WRITE_BY_UPDATE_CONTACT_DATA,
+        RECORD_BULK_WRITE_BY_DELETE_CONTACT_DATA};
+    for (const auto &sql : statements) {
+        if (!ExecuteAndCheck(store, sql)) {
+            HILOG_ERROR("UpgradeToV45 create bulk write triggers failed");
+            return OHOS::NativeRdb::E_ERROR;
+        }
+    }
+    result = Commit(store);
+    if (result != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("UpgradeToV45 Commit failed, ret:%{public}d", result);
+        RollBack(store);
+    }
+    return result;
+}
+
 bool SqliteOpenHelperContactCallback::ExecuteAndCheck(OHOS::NativeRdb::RdbStore &store, const std::string &sql)
 {
     int result = store.ExecuteSql(sql);
@@ -8019,7 +8385,10 @@ void ContactsDataBase::MergeUpdateTask(std::shared_ptr<OHOS::NativeRdb::RdbStore
         (long long) time(NULL));
     std::unique_ptr<AsyncItem> task =
         std::make_unique<AsyncTask>(store_, noRepeatRawContactIdVector, isDeleted);
-    g_asyncTaskQueue->Push(task);
+    if (!g_asyncTaskQueue->Push(task)) {
+        HILOG_ERROR("MergeUpdateTask push async task failed");
+        return;
+    }
     g_asyncTaskQueue->Start();
 }
 
@@ -8085,7 +8454,10 @@ void ContactsDataBase::NotifyContactChange()
     valuesBucket.Put("contact_change_time", time(NULL));
     std::unique_ptr<AsyncItem> task =
         std::make_unique<AsyncDataShareProxyTask>(dataShareHelper_, valuesBucket, predicates, proxyUri);
-    g_asyncTaskQueue->Push(task);
+    if (!g_asyncTaskQueue->Push(task)) {
+        HILOG_ERROR("NotifyContactChange push async task failed");
+        return;
+    }
     g_asyncTaskQueue->Start();
 }
 
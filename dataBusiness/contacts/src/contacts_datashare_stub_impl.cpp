@@ -28,6 +28,8 @@
 #include "system_ability_definition.h"
 #include "os_account_manager.h"
 #include "file_utils.h"
+#include "predicates_convert.h"
+#include "rdb_utils.h"
 #include "uri_permission_manager_client.h"
 #include "file_uri.h"
 #include <fcntl.h>
@@ -147,10 +149,12 @@ int ContactsDataShareStubImpl::Insert(const Uri &uri, const DataShareValuesBucke
         HILOG_ERROR("insert failed, extension is null.");
         return ret;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     ret = extension->Insert(uri, value);
     if (ret != Contacts::OPERATION_ERROR && uriTemp.ToString().find("noNotifyChange") == std::string::npos) {
         NotifyChangeExt(uri, {value}, Contacts::OPERATE_TYPE_INSERT);
     }
+    RecordMetrics(Contacts::DataShareOperation::INSERT, uri, metricsBeginTime, ret > 0 ? 1 : 0, nullptr);
     std::chrono::milliseconds endTime = std::chrono::duration_cast<std::chrono::milliseconds >(
         std::chrono::system_clock::now().time_since_epoch());
     if (endTime.count() - beginTime.count() > g_operateDataTime) {
@@ -183,11 +187,13 @@ int ContactsDataShareStubImpl::Update(const Uri &uri, const DataSharePredicates
         HILOG_ERROR("update failed, extension is null.");
         return ret;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     ret = extension->Update(uri, predicates, value);
     // 如果是畅连能力、设备相关相关变动，不需要发送联系人变更通知
     if (ret > 0 && uriTemp.ToString().find("noNotifyChange") == std::string::npos) {
         NotifyChangeExt(uri, {value}, Contacts::OPERATE_TYPE_UPDATE);
     }
+    RecordMetrics(Contacts::DataShareOperation::UPDATE, uri, metricsBeginTime, ret, &predicates);
     std::chrono::milliseconds endTime = std::chrono::duration_cast<std::chrono::milliseconds >(
         std::chrono::system_clock::now().time_since_epoch());
     if (endTime.count() - beginTime.count() > g_operateDataTime) {
@@ -219,6 +225,7 @@ int ContactsDataShareStubImpl::Delete(const Uri &uri, const DataSharePredicates
         HILOG_ERROR("delete failed, extension is null.");
         return ret;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     ret = extension->Delete(uri, predicates);
     if (ret != Contacts::OPERATION_ERROR && uriTemp.ToString().find("noNotifyChange") == std::string::npos) {
         if (uriTemp.ToString() == Contacts::ADD_CONTACT_INFO_BATCH_URI ||
@@ -229,6 +236,7 @@ int ContactsDataShareStubImpl::Delete(const Uri &uri, const DataSharePredicates
             NotifyChangeExt(uri, {}, Contacts::OPERATE_TYPE_DELETE);
         }
     }
+    RecordMetrics(Contacts::DataShareOperation::DELETE, uri, metricsBeginTime, ret, &predicates);
     std::chrono::milliseconds endTime = std::chrono::duration_cast<std::chrono::milliseconds >(
         std::chrono::system_clock::now().time_since_epoch());
     if (endTime.count() - beginTime.count() > g_operateDataTime) {
@@ -247,12 +255,18 @@ std::shared_ptr<DataShareResultSet> ContactsDataShareStubImpl::Query(const Uri &
     OHOS::Uri uriTemp = uri;
     HILOG_INFO("query begin. uri = %{public}s,beginTime = %{public}lld",
         Contacts::ContactsDataBase::getUriLogPrintByUri(uriTemp).c_str(), (long long) time(NULL));
+    if (uriTemp.GetPath() == Contacts::DATASHARE_METRICS_PATH) {
+        return QueryMetrics();
+    }
     auto extension = GetOwner(uri);
     if (extension == nullptr) {
         HILOG_ERROR("query failed, extension is null.");
         return nullptr;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     auto resultSet = extension->Query(uri, predicates, columns, businessError);
+    RecordMetrics(Contacts::DataShareOperation::QUERY, uri, metricsBeginTime,
+        Contacts::DATASHARE_METRICS_ROWS_UNKNOWN, &predicates);
     HILOG_INFO("query end successfully.uri = %{public}s,endTime = %{public}lld",
         Contacts::ContactsDataBase::getUriLogPrintByUri(uriTemp).c_str(), (long long) time(NULL));
 
@@ -279,6 +293,7 @@ int ContactsDataShareStubImpl::BatchInsert(const Uri &uri, const std::vector<Dat
         HILOG_ERROR("batch insert failed, extension is null.");
         return ret;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     ret = extension->BatchInsert(uri, values);
     if (ret != Contacts::OPERATION_ERROR && uriTemp.ToString().find("noNotifyChange") == std::string::npos) {
         if (uriTemp.GetQuery() == "isFromBatch=true") {
@@ -295,6 +310,8 @@ int ContactsDataShareStubImpl::BatchInsert(const Uri &uri, const std::vector<Dat
             NotifyChangeExt(uriTemp, values, Contacts::OPERATE_TYPE_INSERT);
         }
     }
+    RecordMetrics(Contacts::DataShareOperation::BATCH_INSERT, uri, metricsBeginTime,
+        ret == Contacts::OPERATION_ERROR ? 0 : static_cast<int64_t>(size), nullptr);
     std::chrono::milliseconds endTime = std::chrono::duration_cast<std::chrono::milliseconds >(
         std::chrono::system_clock::now().time_since_epoch());
     if (endTime.count() - beginTime.count() > g_operateDataTime) {
@@ -329,6 +346,7 @@ int ContactsDataShareStubImpl::ExecuteBatch(const std::vector<OperationStatement
         HILOG_ERROR("ContactsDataShareStubImpl ExecuteBatch faild, extension is null.");
         return ret;
     }
+    auto metricsBeginTime = std::chrono::steady_clock::now();
     ret = extension->ExecuteBatch(statements, result);
     if (ret != Contacts::OPERATION_ERROR) {
         std::map<std::string, std::vector<DataShare::DataShareValuesBucket>> values;
@@ -346,6 +364,8 @@ int ContactsDataShareStubImpl::ExecuteBatch(const std::vector<OperationStatement
     } else {
         HILOG_ERROR("ExecuteBatch faild");
     }
+    RecordMetrics(Contacts::DataShareOperation::EXECUTE_BATCH, Uri(Contacts::CONTACT_URI), metricsBeginTime,
+        ret == Contacts::OPERATION_ERROR ? 0 : static_cast<int64_t>(size), nullptr);
     std::chrono::milliseconds endTime = std::chrono::duration_cast<std::chrono::milliseconds >(
         std::chrono::system_clock::now().time_since_epoch());
     if (endTime.count() - beginTime.count() > g_operateDataTime) {
@@ -358,6 +378,80 @@ int ContactsDataShareStubImpl::ExecuteBatch(const std::vector<OperationStatement
     return ret;
 }
 
+void ContactsDataShareStubImpl::RecordMetrics(Contacts::DataShareOperation operation, const Uri &uri,
+    std::chrono::steady_clock::time_point beginTime, int64_t rows, const DataSharePredicates *predicates)
+{
+    uint64_t costUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - beginTime).count());
+    OHOS::Uri uriTemp = uri;
+    std::string uriPath = uriTemp.GetPath();
+    Contacts::DataShareMetrics &metrics = Contacts::DataShareMetrics::GetInstance();
+    metrics.Record(operation, uriPath, costUs, rows);
+    if (Contacts::DataShareMetrics::IsSlow(costUs)) {
+        metrics.RecordSlow(operation, uriPath, BuildSlowSql(operation, uriPath, predicates), costUs);
+    }
+}
+
+std::string ContactsDataShareStubImpl::BuildSlowSql(Contacts::DataShareOperation operation,
+    const std::string &uriPath, const DataSharePredicates *predicates)
+{
+    // uri最后一段即操作的表或视图
+    std::string table = uriPath.substr(uriPath.rfind('/') + 1);
+    std::string sql;
+    switch (operation) {
+        case Contacts::DataShareOperation::INSERT:
+        case Contacts::DataShareOperation::BATCH_INSERT:
+            return "INSERT INTO " + table;
+        case Contacts::DataShareOperation::UPDATE:
+            sql = "UPDATE " + table + " SET ?";
+            break;
+        case Contacts::DataShareOperation::DELETE:
+            sql = "DELETE FROM " + table;
+            break;
+        case Contacts::DataShareOperation::QUERY:
+            sql = "SELECT * FROM " + table;
+            break;
+        default:
+            return table;
+    }
+    if (predicates == nullptr) {
+        return sql;
+    }
+    Contacts::PredicatesConvert predicatesConvert;
+    DataSharePredicates dataSharePredicates = *predicates;
+    OHOS::NativeRdb::RdbPredicates rdbPredicates = predicatesConvert.ConvertPredicates(table, dataSharePredicates);
+    if (!rdbPredicates.GetWhereClause().empty()) {
+        sql += " WHERE " + rdbPredicates.GetWhereClause();
+    }
+    if (!rdbPredicates.GetOrder().empty()) {
+        sql += " ORDER BY " + rdbPredicates.GetOrder();
+    }
+    return sql;
+}
+
+std::shared_ptr<DataShareResultSet> ContactsDataShareStubImpl::QueryMetrics()
+{
+    if (!Telephony::TelephonyPermission::CheckPermission(Telephony::Permission::READ_CONTACTS)) {
+        HILOG_ERROR("QueryMetrics Permission denied!");
+        return nullptr;
+    }
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = Contacts::ContactsDataBase::GetInstance()->contactStore_;
+    if (store == nullptr) {
+        HILOG_ERROR("QueryMetrics contactStore_ is nullptr");
+        return nullptr;
+    }
+    // 统计结果不落库，借用只读的SELECT把json作为一行一列返回
+    std::vector<std::string> selectionArgs = {Contacts::DataShareMetrics::GetInstance().Dump()};
+    std::string sql = std::string("SELECT ? AS ") + Contacts::DATASHARE_METRICS_COLUMN;
+    auto result = store->QuerySql(sql, selectionArgs);
+    if (result == nullptr) {
+        HILOG_ERROR("QueryMetrics QuerySql result is nullptr");
+        return nullptr;
+    }
+    auto queryResultSet = RdbDataShareAdapter::RdbUtils::ToResultSetBridge(result);
+    return std::make_shared<DataShareResultSet>(queryResultSet);
+}
+
 Uri ContactsDataShareStubImpl::getUriPrintByUri(const Uri &uriTemp)
 {
     std::string uriStr = uriTemp.ToString();
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "datashare_metrics.h"
+
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+#include "hilog_wrapper.h"
+#include "json/json.h"
+
+namespace OHOS {
+namespace Contacts {
+namespace {
+constexpr double PERCENTILE_50 = 50.0;
+constexpr double PERCENTILE_99 = 99.0;
+// 操作类型混入hash，避免不同操作的同一uri落在同一槽位
+constexpr uint64_t OPERATION_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+bool IsIdentifierChar(char ch)
+{
+    return std::isalnum(static_cast<unsigned char>(ch)) != 0 || ch == '_' || ch == '.';
+}
+
+void AppendPlaceholder(std::string &out)
+{
+    // "?, ?"、"?,?"合并为一个?
+    size_t length = out.length();
+    if (length >= 2 && out[length - 1] == ',' && out[length - 2] == '?') {
+        out.pop_back();
+        return;
+    }
+    if (length >= 3 && out[length - 1] == ' ' && out[length - 2] == ',' && out[length - 3] == '?') {
+        out.resize(length - 2);
+        return;
+    }
+    out.push_back('?');
+}
+
+Json::Value HistogramToJson(const LatencyHistogram &histogram)
+{
+    Json::Value value;
+    value["count"] = Json::UInt64(histogram.Count());
+    value["p50_us"] = Json::UInt64(histogram.Percentile(PERCENTILE_50));
+    value["p99_us"] = Json::UInt64(histogram.Percentile(PERCENTILE_99));
+    value["max_us"] = Json::UInt64(histogram.Max());
+    value["mean_us"] = Json::UInt64(histogram.Mean());
+    return value;
+}
+}
+
+DataShareMetrics &DataShareMetrics::GetInstance()
+{
+    static DataShareMetrics instance;
+    return instance;
+}
+
+DataShareMetrics::DataShareMetrics()
+{
+}
+
+DataShareMetrics::~DataShareMetrics()
+{
+    for (auto &slot : uriSlots_) {
+        delete slot.histogram;
+        slot.histogram = nullptr;
+    }
+}
+
+const char *DataShareMetrics::OperationName(DataShareOperation operation)
+{
+    switch (operation) {
+        case DataShareOperation::INSERT:
+            return "insert";
+        case DataShareOperation::UPDATE:
+            return "update";
+        case DataShareOperation::DELETE:
+            return "delete";
+        case DataShareOperation::QUERY:
+            return "query";
+        case DataShareOperation::BATCH_INSERT:
+            return "batchInsert";
+        case DataShareOperation::EXECUTE_BATCH:
+            return "executeBatch";
+        default:
+            return "unknown";
+    }
+}
+
+uint64_t DataShareMetrics::SlotKey(DataShareOperation operation, const std::string &uriPath)
+{
+    std::string path = uriPath.substr(0, DATASHARE_METRICS_MAX_PATH_LENGTH - 1);
+    uint64_t key = static_cast<uint64_t>(std::hash<std::string>()(path));
+    key ^= (static_cast<uint64_t>(operation) + 1) * OPERATION_HASH_MULTIPLIER;
+    // 0表示空槽位
+    return key == 0 ? 1 : key;
+}
+
+DataShareMetrics::UriSlot *DataShareMetrics::FindOrClaimSlot(DataShareOperation operation, const std::string &uriPath)
+{
+    uint64_t key = SlotKey(operation, uriPath);
+    size_t start = static_cast<size_t>(key % DATASHARE_METRICS_MAX_URIS);
+    for (size_t probe = 0; probe < DATASHARE_METRICS_MAX_URIS; probe++) {
+        UriSlot &slot = uriSlots_[(start + probe) % DATASHARE_METRICS_MAX_URIS];
+        uint64_t slotKey = slot.key.load(std::memory_order_acquire);
+        if (slotKey == 0) {
+            uint64_t expected = 0;
+            if (slot.key.compare_exchange_strong(expected, key, std::memory_order_acq_rel)) {
+                // 抢到槽位的线程负责初始化，初始化完成前其他线程的同key记录直接丢弃
+                slot.operation = static_cast<int>(operation);
+                strncpy(slot.path, uriPath.c_str(), DATASHARE_METRICS_MAX_PATH_LENGTH - 1);
+                slot.histogram = new (std::nothrow) LatencyHistogram();
+                if (slot.histogram == nullptr) {
+                    return nullptr;
+                }
+                slot.state.store(SLOT_READY, std::memory_order_release);
+                return &slot;
+            }
+            slotKey = expected;
+        }
+        if (slotKey != key) {
+            continue;
+        }
+        if (slot.state.load(std::memory_order_acquire) != SLOT_READY) {
+            return nullptr;
+        }
+        if (slot.operation == static_cast<int>(operation) &&
+            strncmp(slot.path, uriPath.c_str(), DATASHARE_METRICS_MAX_PATH_LENGTH - 1) == 0) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void DataShareMetrics::Record(DataShareOperation operation, const std::string &uriPath, uint64_t costUs, int64_t rows)
+{
+    if (operation >= DataShareOperation::COUNT) {
+        return;
+    }
+    operationHistograms_[static_cast<size_t>(operation)].Record(costUs);
+    UriSlot *slot = FindOrClaimSlot(operation, uriPath);
+    if (slot == nullptr) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    slot->histogram->Record(costUs);
+    if (rows > 0) {
+        slot->rows.fetch_add(rows, std::memory_order_relaxed);
+    }
+}
+
+void DataShareMetrics::RecordSlow(DataShareOperation operation, const std::string &uriPath, const std::string &sql,
+    uint64_t costUs)
+{
+    int64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    SlowSample sample {operation, uriPath, NormalizeSql(sql), costUs, timestamp};
+    HILOG_WARN("DataShareMetrics slow %{public}s, uri = %{public}s, cost = %{public}llu us, sql = %{public}s",
+        OperationName(operation), uriPath.c_str(), static_cast<unsigned long long>(costUs), sample.sql.c_str());
+    std::lock_guard<std::mutex> lock(slowMutex_);
+    slowSamples_.push_back(std::move(sample));
+    if (slowSamples_.size() > DATASHARE_METRICS_MAX_SLOW_SAMPLES) {
+        slowSamples_.pop_front();
+    }
+}
+
+std::string DataShareMetrics::Dump()
+{
+    Json::Value root;
+    Json::Value operations(Json::arrayValue);
+    for (size_t i = 0; i < operationHistograms_.size(); i++) {
+        if (operationHistograms_[i].Count() == 0) {
+            continue;
+        }
+        Json::Value item = HistogramToJson(operationHistograms_[i]);
+        item["operation"] = OperationName(static_cast<DataShareOperation>(i));
+        operations.append(item);
+    }
+    root["operations"] = operations;
+    Json::Value uris(Json::arrayValue);
+    for (const auto &slot : uriSlots_) {
+        if (slot.state.load(std::memory_order_acquire) != SLOT_READY || slot.histogram->Count() == 0) {
+            continue;
+        }
+        Json::Value item = HistogramToJson(*slot.histogram);
+        item["operation"] = OperationName(static_cast<DataShareOperation>(slot.operation));
+        item["uri"] = slot.path;
+        item["rows"] = Json::Int64(slot.rows.load(std::memory_order_relaxed));
+        uris.append(item);
+    }
+    root["uris"] = uris;
+    Json::Value slow(Json::arrayValue);
+    {
+        std::lock_guard<std::mutex> lock(slowMutex_);
+        for (const auto &sample : slowSamples_) {
+            Json::Value item;
+            item["operation"] = OperationName(sample.operation);
+            item["uri"] = sample.uriPath;
+            item["sql"] = sample.sql;
+            item["cost_us"] = Json::UInt64(sample.costUs);
+            item["timestamp"] = Json::Int64(sample.timestamp);
+            slow.append(item);
+        }
+    }
+    root["slow"] = slow;
+    root["dropped"] = Json::UInt64(dropped_.load(std::memory_order_relaxed));
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return Json::writeString(builder, root);
+}
+
+void DataShareMetrics::Reset()
+{
+    for (auto &histogram : operationHistograms_) {
+        histogram.Reset();
+    }
+    for (auto &slot : uriSlots_) {
+        if (slot.state.load(std::memory_order_acquire) == SLOT_READY) {
+            slot.histogram->Reset();
+            slot.rows.store(0, std::memory_order_relaxed);
+        }
+    }
+    dropped_.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(slowMutex_);
+    slowSamples_.clear();
+}
+
+std::string DataShareMetrics::NormalizeSql(const std::string &sql)
+{
+    std::string out;
+    out.reserve(sql.length());
+    size_t pos = 0;
+    const size_t length = sql.length();
+    while (pos < length) {
+        char ch = sql[pos];
+        if (std::isspace(static_cast<unsigned char>(ch)) != 0) {
+            while (pos < length && std::isspace(static_cast<unsigned char>(sql[pos])) != 0) {
+                pos++;
+            }
+            if (!out.empty() && out.back() != ' ') {
+                out.push_back(' ');
+            }
+            continue;
+        }
+        if (ch == '\'') {
+            // 字符串字面量，''为转义的单引号
+            pos++;
+            while (pos < length) {
+                if (sql[pos] == '\'' && pos + 1 < length && sql[pos + 1] == '\'') {
+                    pos += 2;
+                    continue;
+                }
+                if (sql[pos] == '\'') {
+                    pos++;
+                    break;
+                }
+                pos++;
+            }
+            AppendPlaceholder(out);
+            continue;
+        }
+        if (std::isdigit(static_cast<unsigned char>(ch)) != 0 && (out.empty() || !IsIdentifierChar(out.back()))) {
+            while (pos < length && IsIdentifierChar(sql[pos])) {
+                pos++;
+            }
+            AppendPlaceholder(out);
+            continue;
+        }
+        if (ch == '?') {
+            pos++;
+            AppendPlaceholder(out);
+            continue;
+        }
+        out.push_back(ch);
+        pos++;
+    }
+    if (!out.empty() && out.back() == ' ') {
+        out.pop_back();
+    }
+    return out;
+}
+} // namespace Contacts
+} // namespace OHOS
@@ -135,6 +135,7 @@ int SqliteOpenHelperProfileCallback::OnCreate(OHOS::NativeRdb::RdbStore &store)
     store.ExecuteSql(UPDATE_CONTACT_BY_DELETE_CONTACT_DATA);
     store.ExecuteSql(UPDATE_CONTACT_BY_UPDATE_CONTACT_DATA);
     store.ExecuteSql(MERGE_INFO_INDEX);
+    store.ExecuteSql(CREATE_ACCOUNT_PURGE_CURSOR);
     return OHOS::NativeRdb::E_OK;
 }
 
@@ -147,6 +148,10 @@ int SqliteOpenHelperProfileCallback::OnUpgrade(OHOS::NativeRdb::RdbStore &store,
     if (oldVersion < newVersion && newVersion == DATABASE_VERSION_2) {
         UpgradeToV2(store, oldVersion, newVersion);
     }
+    // v45新增账号清理游标表，profile库与联系人库使用同一个版本号
+    if (oldVersion < DATABASE_VERSION_45 && newVersion >= DATABASE_VERSION_45) {
+        store.ExecuteSql(CREATE_ACCOUNT_PURGE_CURSOR);
+    }
     store.SetVersion(newVersion);
     return OHOS::NativeRdb::E_OK;
 }
@@ -15,6 +15,10 @@
 
 #include "privacy_contacts_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
 #include "os_account_manager.h"
 #include "common.h"
 #include "hilog_wrapper.h"
@@ -27,6 +31,55 @@
 
 namespace OHOS {
 namespace Contacts {
+namespace {
+// 每个号码占用的布隆过滤器位数，两个哈希函数下误判率约5%
+constexpr size_t BLOOM_BITS_PER_NUMBER = 8;
+constexpr size_t BLOOM_MIN_BITS = 64;
+constexpr size_t BLOOM_WORD_BITS = 64;
+constexpr uint64_t BLOOM_SECOND_HASH_SHIFT = 32;
+constexpr uint64_t BLOOM_SECOND_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+}
+
+PrivacyNumberSnapshot::PrivacyNumberSnapshot(uint64_t generation, std::unordered_set<std::string> &&numbers)
+    : generation_(generation), numbers_(std::move(numbers))
+{
+    size_t bitCount = BLOOM_MIN_BITS;
+    while (bitCount < numbers_.size() * BLOOM_BITS_PER_NUMBER) {
+        bitCount <<= 1;
+    }
+    bloomMask_ = bitCount - 1;
+    bloomBits_.assign(bitCount / BLOOM_WORD_BITS, 0);
+    std::hash<std::string> hasher;
+    for (const auto &number : numbers_) {
+        uint64_t hash = hasher(number);
+        size_t first = static_cast<size_t>(hash) & bloomMask_;
+        size_t second = static_cast<size_t>((hash >> BLOOM_SECOND_HASH_SHIFT) ^ (hash * BLOOM_SECOND_HASH_MULTIPLIER)) &
+            bloomMask_;
+        bloomBits_[first / BLOOM_WORD_BITS] |= 1ULL << (first % BLOOM_WORD_BITS);
+        bloomBits_[second / BLOOM_WORD_BITS] |= 1ULL << (second % BLOOM_WORD_BITS);
+    }
+}
+
+bool PrivacyNumberSnapshot::MayContain(uint64_t hash) const
+{
+    size_t first = static_cast<size_t>(hash) & bloomMask_;
+    size_t second = static_cast<size_t>((hash >> BLOOM_SECOND_HASH_SHIFT) ^ (hash * BLOOM_SECOND_HASH_MULTIPLIER)) &
+        bloomMask_;
+    return (bloomBits_[first / BLOOM_WORD_BITS] & (1ULL << (first % BLOOM_WORD_BITS))) != 0 &&
+        (bloomBits_[second / BLOOM_WORD_BITS] & (1ULL << (second % BLOOM_WORD_BITS))) != 0;
+}
+
+bool PrivacyNumberSnapshot::Contains(const std::string &phoneNumber) const
+{
+    if (numbers_.empty() || phoneNumber.empty()) {
+        return false;
+    }
+    if (!MayContain(std::hash<std::string>()(phoneNumber))) {
+        return false;
+    }
+    return numbers_.find(phoneNumber) != numbers_.end();
+}
+
 std::shared_ptr<PrivacyContactsManager> instance_ = nullptr;
 std::shared_ptr<PrivacyContactsManager> PrivacyContactsManager::GetInstance()
 {
@@ -42,8 +95,8 @@ std::shared_ptr<PrivacyContactsManager> PrivacyContactsManager::GetInstance()
 bool PrivacyContactsManager::isMigratePrivacyCallLogEnbale()
 {
     std::string datashareUri = SETTING_DB_URI;
-    std::shared_ptr<DataShare::DataShareHelper> helper =
-        RetryCreateDataShareHelper([&]() { return CreateDataShareHelper(datashareUri); });
+    // 每条通话记录写入都会查询开关，复用helper，避免每次都查询SA并新建连接
+    std::shared_ptr<DataShare::DataShareHelper> helper = GetPooledHelper(datashareUri);
     if (helper == nullptr) {
         HILOG_ERROR("helper is null");
         return false;
@@ -56,18 +109,16 @@ bool PrivacyContactsManager::isMigratePrivacyCallLogEnbale()
     auto resultSet = helper->Query(uri, predicates, columns);
     if (resultSet == nullptr) {
         HILOG_ERROR("helper: query error, result is null");
-        helper->Release();
+        DropPooledHelper(datashareUri);
         return false;
     }
     auto opearateResult = resultSet->GoToFirstRow();
     if (opearateResult != DataShare::E_OK) {
         HILOG_ERROR("helper: query error, go to first row error");
         resultSet->Close();
-        helper->Release();
         return false;
     }
     resultSet->Close();
-    helper->Release();
     return true;
 }
 
@@ -367,7 +418,7 @@ bool PrivacyContactsManager::QueryCallLogWithPhoneNumber(
 {
     std::shared_ptr<DataShare::DataShareHelper> helper = nullptr;
     std::string url;
-    if (!GetHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CALL_LOG_URI, helper, url)) {
+    if (!GetPooledHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CALL_LOG_URI, helper, url)) {
         return false;
     }
 // LCOV_EXCL_START
@@ -377,12 +428,11 @@ bool PrivacyContactsManager::QueryCallLogWithPhoneNumber(
     auto resultSet = helper->Query(uri, predicates, columns);
     if (resultSet == nullptr) {
         HILOG_ERROR("resultSet is nullptr!");
-        helper->Release();
+        DropPooledHelper(url);
         return false;
     }
     ConvertResultSetToValuesBucket(resultSet, values);
     resultSet->Close();
-    helper->Release();
     return true;
 // LCOV_EXCL_STOP
 }
@@ -432,35 +482,15 @@ bool PrivacyContactsManager::ProcessPrivacyCallLog(std::vector<DataShare::DataSh
 bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(const std::string &phoneNum, bool &result)
 {
     result = false;
-    std::shared_ptr<DataShare::DataShareHelper> helper;
-    std::string url;
-    if (!GetHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CONTACT_URI, helper, url)) {
+    std::shared_ptr<const PrivacyNumberSnapshot> snapshot = GetPrivacyNumberSnapshot();
+    if (snapshot == nullptr) {
         return false;
     }
-// LCOV_EXCL_START
-    DataShare::DataSharePredicates predicates;
-    predicates.EqualTo(PrivacyContactsBackupColumns::PHONE_NUMBER, phoneNum);
-    predicates.Or();
-    predicates.EqualTo(PrivacyContactsBackupColumns::FORMAT_PHONE_NUMBER, phoneNum);
-    std::vector<std::string> columns = {PrivacyContactsBackupColumns::PHONE_NUMBER};
-    auto uriObj = Uri(url);
-    auto resultSet = helper->Query(uriObj, predicates, columns);
-    if (resultSet == nullptr) {
-        HILOG_ERROR("query error, result is null");
-        helper->Release();
-        return false;
-    }
-    if (resultSet->GoToFirstRow() != DataShare::E_OK) {
+    result = snapshot->Contains(phoneNum);
+    if (!result) {
         HILOG_WARN("%{private}s: it is not private space number", phoneNum.c_str());
-        resultSet->Close();
-        helper->Release();
-        return true;
     }
-    resultSet->Close();
-    helper->Release();
-    result = true;
     return true;
-// LCOV_EXCL_STOP
 }
 
 bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(
@@ -468,8 +498,7 @@ bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(
     std::vector<DataShare::DataShareValuesBucket> &privacyNums,
     std::vector<DataShare::DataShareValuesBucket> &normalNums)
 {
-    std::unordered_set<std::string> allPrivacyNums;
-    GetPrivacySpacePhoneNumbers(allPrivacyNums);
+    std::shared_ptr<const PrivacyNumberSnapshot> snapshot = GetPrivacyNumberSnapshot();
     for (const auto &value : phoneNums) {
         bool isValid = false;
         std::string phoneNumber = value.Get(CallLogColumns::PHONE_NUMBER, isValid);
@@ -478,7 +507,7 @@ bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(
             normalNums.emplace_back(value);
             continue;
         }
-        if (allPrivacyNums.find(phoneNumber) != allPrivacyNums.end()) {
+        if (snapshot != nullptr && snapshot->Contains(phoneNumber)) {
             privacyNums.emplace_back(value);
             continue;
         }
@@ -490,14 +519,13 @@ bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(
 bool PrivacyContactsManager::QueryIsPrivacySpacePhoneNumber(const std::vector<OHOS::NativeRdb::ValuesBucket> &phoneNums,
     std::vector<DataShare::DataShareValuesBucket> &privacyNums, std::vector<OHOS::NativeRdb::ValuesBucket> &normalNums)
 {
-    std::unordered_set<std::string> allPrivacyNums;
-    GetPrivacySpacePhoneNumbers(allPrivacyNums);
+    std::shared_ptr<const PrivacyNumberSnapshot> snapshot = GetPrivacyNumberSnapshot();
     for (const auto &value : phoneNums) {
         OHOS::NativeRdb::ValueObject phoneNumObj;
         value.GetObject(CallLogColumns::PHONE_NUMBER, phoneNumObj);
         std::string phoneNumber;
         phoneNumObj.GetString(phoneNumber);
-        if (allPrivacyNums.find(phoneNumber) != allPrivacyNums.end()) {
+        if (snapshot != nullptr && snapshot->Contains(phoneNumber)) {
             privacyNums.emplace_back(ToDataShareValuesBucket(value));
             continue;
         }
@@ -558,15 +586,17 @@ bool PrivacyContactsManager::UpdatePrivacyTag(std::vector<DataShare::DataShareVa
     }
     std::shared_ptr<DataShare::DataShareHelper> helper = nullptr;
     std::string url;
-    if (!GetHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CALL_LOG_URI, helper, url)) {
+    if (!GetPooledHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CALL_LOG_URI, helper, url)) {
         HILOG_ERROR("UpdatePrivacyTag, helper is nullptr");
         return false;
     }
 // LCOV_EXCL_START
+    std::string poolUrl = url;
     url += "&isPrivacy=true&isFromBatch=true";
     Uri uri(url);
     std::vector<DataShare::DataShareValuesBucket> insertValues;
-    auto result = OPERATION_ERROR;
+    // 已存在的通话记录只需要修改隐私标记，按标记值分组后用id列表批量更新
+    std::map<int64_t, std::vector<std::string>> updateIds;
     for (auto &value : values) {
         bool isValid = UpdatePrivacyTagOfValueBucket(value);
         auto id = static_cast<int32_t>(value.Get(CallLogColumns::ID, isValid));
@@ -574,28 +604,47 @@ bool PrivacyContactsManager::UpdatePrivacyTag(std::vector<DataShare::DataShareVa
             insertValues.emplace_back(value);
             continue;
         }
-        DataShare::DataSharePredicates predicates;
-        predicates.EqualTo(CallLogColumns::ID, id);
-        result = helper->Update(uri, predicates, value);
-        if (result == OPERATION_ERROR) {
-            HILOG_ERROR("UpdatePrivacyTag Update error, result: %{public}d", result);
-            continue;
-        }
+        bool tagValid = false;
+        int64_t privacyTag = GetIntFromDataShareValueObject(value.Get(CallLogColumns::PRIVACY_TAG, tagValid));
+        updateIds[privacyTag].emplace_back(std::to_string(id));
+    }
+    for (const auto &item : updateIds) {
+        UpdatePrivacyTagByIds(helper, uri, item.first, item.second);
     }
     if (!insertValues.empty()) {
-        result = helper->BatchInsert(uri, insertValues);
+        auto result = helper->BatchInsert(uri, insertValues);
         if (result == OPERATION_ERROR) {
             HILOG_ERROR("UpdatePrivacyTag BatchInsert error, result: %{public}d", result);
-            helper->Release();
+            DropPooledHelper(poolUrl);
             return false;
         }
     }
-    helper->Release();
     HILOG_INFO("UpdatePrivacyTag finish, rowCount: %{public}lu", (unsigned long) values.size());
     return true;
 // LCOV_EXCL_STOP
 }
 
+bool PrivacyContactsManager::UpdatePrivacyTagByIds(const std::shared_ptr<DataShare::DataShareHelper> &helper,
+    Uri &uri, int64_t privacyTag, const std::vector<std::string> &ids)
+{
+    DataShare::DataShareValuesBucket tagValue;
+    tagValue.Put(CallLogColumns::PRIVACY_TAG, privacyTag);
+    bool success = true;
+    for (size_t start = 0; start < ids.size(); start += PRIVACY_CONTACTS_MANAGER_UPDATE_TAG_BATCH_SIZE) {
+        size_t end = std::min(ids.size(), start + PRIVACY_CONTACTS_MANAGER_UPDATE_TAG_BATCH_SIZE);
+        std::vector<std::string> batchIds(ids.begin() + start, ids.begin() + end);
+        DataShare::DataSharePredicates predicates;
+        predicates.In(CallLogColumns::ID, batchIds);
+        auto result = helper->Update(uri, predicates, tagValue);
+        if (result == OPERATION_ERROR) {
+            HILOG_ERROR("UpdatePrivacyTagByIds Update error, tag: %{public}lld, count: %{public}zu",
+                (long long) privacyTag, batchIds.size());
+            success = false;
+        }
+    }
+    return success;
+}
+
 // LCOV_EXCL_START
 bool PrivacyContactsManager::MigratePrivacyCallLog()
 {
@@ -973,7 +1022,7 @@ bool PrivacyContactsManager::GetPrivacySpacePhoneNumbers(std::unordered_set<std:
 {
     std::shared_ptr<DataShare::DataShareHelper> helper;
     std::string url;
-    if (!GetHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CONTACT_URI, helper, url)) {
+    if (!GetPooledHelperAndUrl(OHOS::AccountSA::OsAccountType::ADMIN, CONTACT_URI, helper, url)) {
         HILOG_ERROR("GetPrivacySpacePhoneNumbers, helper is nullptr");
         return false;
     }
@@ -985,7 +1034,7 @@ bool PrivacyContactsManager::GetPrivacySpacePhoneNumbers(std::unordered_set<std:
     auto resultSet = helper->Query(uriObj, predicates, columns);
     if (resultSet == nullptr) {
         HILOG_ERROR("query error, result is null");
-        helper->Release();
+        DropPooledHelper(url);
         return false;
     }
     int32_t operationResult = resultSet->GoToFirstRow();
@@ -1000,11 +1049,94 @@ bool PrivacyContactsManager::GetPrivacySpacePhoneNumbers(std::unordered_set<std:
         operationResult = resultSet->GoToNextRow();
     }
     resultSet->Close();
-    helper->Release();
     return true;
 // LCOV_EXCL_STOP
 }
 
+void PrivacyContactsManager::InvalidatePrivacyNumberCache()
+{
+    privacyBackupGeneration_.fetch_add(1);
+}
+
+std::shared_ptr<const PrivacyNumberSnapshot> PrivacyContactsManager::GetPrivacyNumberSnapshot()
+{
+    std::lock_guard<std::mutex> lock(privacyNumberMutex_);
+    // 查询前记录版本号，查询期间表有变化时下次调用会重新加载
+    uint64_t generation = privacyBackupGeneration_.load();
+    if (privacyNumberSnapshot_ != nullptr && privacyNumberSnapshot_->GetGeneration() == generation) {
+        return privacyNumberSnapshot_;
+    }
+    std::unordered_set<std::string> allPrivacyNums;
+    if (!GetPrivacySpacePhoneNumbers(allPrivacyNums)) {
+        HILOG_ERROR("GetPrivacyNumberSnapshot load failed");
+        return nullptr;
+    }
+    privacyNumberSnapshot_ = std::make_shared<const PrivacyNumberSnapshot>(generation, std::move(allPrivacyNums));
+    HILOG_INFO("GetPrivacyNumberSnapshot reload, generation: %{public}llu, size: %{public}zu",
+        (unsigned long long) generation, privacyNumberSnapshot_->Size());
+    return privacyNumberSnapshot_;
+}
+
+bool PrivacyContactsManager::GetPooledHelperAndUrl(const OHOS::AccountSA::OsAccountType &type,
+    const std::string &datashareUri, std::shared_ptr<DataShare::DataShareHelper> &helper, std::string &url)
+{
+    int userId = -1;
+    if (GetSpecialTypeUserId(type, userId) != OPERATION_OK) {
+        HILOG_ERROR("GetPooledHelperAndUrl get userId faield!");
+        return false;
+    }
+    std::string tableName;
+    if (datashareUri == CALL_LOG_URI) {
+        tableName = "/calls/calllog";
+    } else if (type == OHOS::AccountSA::OsAccountType::ADMIN) {
+        tableName = "/contacts/privacy_contacts_backup";
+    } else if (type == OHOS::AccountSA::OsAccountType::PRIVATE) {
+        tableName = "/contacts/contact_data";
+    } else {
+        HILOG_ERROR("GetPooledHelperAndUrl type error!");
+        return false;
+    }
+    url = datashareUri + tableName + "?user=" + std::to_string(userId);
+    helper = GetPooledHelper(url);
+    return helper != nullptr;
+}
+
+std::shared_ptr<DataShare::DataShareHelper> PrivacyContactsManager::GetPooledHelper(const std::string &url)
+{
+    std::lock_guard<std::mutex> lock(helperPoolMutex_);
+    auto it = helperPool_.find(url);
+    if (it != helperPool_.end() && it->second != nullptr) {
+        return it->second;
+    }
+    std::shared_ptr<DataShare::DataShareHelper> helper =
+        RetryCreateDataShareHelper([&]() { return CreateDataShareHelper(url); });
+    if (helper == nullptr) {
+        HILOG_ERROR("GetPooledHelper create helper failed");
+        return nullptr;
+    }
+    HILOG_INFO("GetPooledHelper create helper, uri: %{public}s", url.c_str());
+    helperPool_[url] = helper;
+    return helper;
+}
+
+void PrivacyContactsManager::DropPooledHelper(const std::string &url)
+{
+    std::shared_ptr<DataShare::DataShareHelper> helper;
+    {
+        std::lock_guard<std::mutex> lock(helperPoolMutex_);
+        auto it = helperPool_.find(url);
+        if (it == helperPool_.end()) {
+            return;
+        }
+        helper = it->second;
+        helperPool_.erase(it);
+    }
+    // 操作失败时连接可能已经失效，释放后下次重新创建
+    if (helper != nullptr) {
+        helper->Release();
+    }
+}
+
 template <typename Func>
 std::shared_ptr<DataShare::DataShareHelper> PrivacyContactsManager::RetryCreateDataShareHelper(Func &&func)
 {
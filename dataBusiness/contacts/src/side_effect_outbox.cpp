@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "side_effect_outbox.h"
+
+#include <chrono>
+
+#include "async_task.h"
+#include "common.h"
+#include "contact_connect_ability.h"
+#include "contacts_columns.h"
+#include "contacts_database.h"
+#include "contacts_string_utils.h"
+#include "contacts_update_helper.h"
+#include "hilog_wrapper.h"
+#include "rdb_errno.h"
+#include "rdb_predicates.h"
+
+namespace OHOS {
+namespace Contacts {
+namespace {
+// 每批次处理的副作用条数
+constexpr int OUTBOX_BATCH_SIZE = 200;
+constexpr int COLUMN_INDEX_ID = 0;
+constexpr int COLUMN_INDEX_TYPE = 1;
+constexpr int COLUMN_INDEX_PAYLOAD = 2;
+}
+
+std::shared_ptr<SideEffectOutbox> SideEffectOutbox::instance_ = nullptr;
+std::mutex SideEffectOutbox::instanceMutex_;
+
+std::shared_ptr<SideEffectOutbox> SideEffectOutbox::GetInstance()
+{
+    if (instance_ == nullptr) {
+        std::lock_guard<std::mutex> lock(instanceMutex_);
+        if (instance_ == nullptr) {
+            instance_ = std::make_shared<SideEffectOutbox>();
+        }
+    }
+    return instance_;
+}
+
+SideEffectOutbox::SideEffectOutbox()
+{
+}
+
+SideEffectOutbox::~SideEffectOutbox()
+{
+}
+
+int SideEffectOutbox::Record(
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, SideEffectType type, const std::string &payload)
+{
+    if (store == nullptr) {
+        HILOG_ERROR("SideEffectOutbox Record store is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    // 只有联系人库有outbox表；删除个人名片时store_指向profile库，不记录副作用
+    if (store != ContactsDataBase::contactStore_) {
+        HILOG_INFO("SideEffectOutbox Record skip type:%{public}d, not contacts store", static_cast<int>(type));
+        return OHOS::NativeRdb::E_OK;
+    }
+    int64_t createTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    OHOS::NativeRdb::ValuesBucket values;
+    values.PutInt(SideEffectOutboxColumns::EFFECT_TYPE, static_cast<int>(type));
+    values.PutString(SideEffectOutboxColumns::PAYLOAD, payload);
+    values.PutLong(SideEffectOutboxColumns::CREATE_TIME, createTime);
+    int64_t rowId = 0;
+    int ret = store->Insert(rowId, ContactTableName::SIDE_EFFECT_OUTBOX, values);
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("SideEffectOutbox Record type:%{public}d failed:%{public}d", static_cast<int>(type), ret);
+    }
+    return ret;
+}
+
+void SideEffectOutbox::Schedule()
+{
+    // 队列中已有待执行的drain任务，不再重复添加
+    bool expected = false;
+    if (!drainScheduled_.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    std::unique_ptr<AsyncItem> task = std::make_unique<AsyncSideEffectOutboxTask>();
+    AsyncTaskQueue *asyncTaskQueue = AsyncTaskQueue::Instance();
+    if (!asyncTaskQueue->Push(task)) {
+        drainScheduled_ = false;
+        HILOG_ERROR("SideEffectOutbox Schedule push task failed");
+        return;
+    }
+    asyncTaskQueue->Start();
+}
+
+void SideEffectOutbox::Drain()
+{
+    // 先清标记，drain期间新记录的副作用会再次调度
+    drainScheduled_ = false;
+    std::lock_guard<std::mutex> lock(drainMutex_);
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = ContactsDataBase::contactStore_;
+    if (store == nullptr) {
+        HILOG_ERROR("SideEffectOutbox Drain store is nullptr");
+        return;
+    }
+    int batchCount = 0;
+    while (true) {
+        OutboxBatch batch;
+        if (TakeBatch(store, batch) != OHOS::NativeRdb::E_OK || batch.ids.empty()) {
+            break;
+        }
+        ExecuteBatch(batch);
+        // 副作用执行完成后才删除记录，中途崩溃会在下次开库时重放
+        if (RemoveBatch(store, batch) != OHOS::NativeRdb::E_OK) {
+            break;
+        }
+        batchCount++;
+    }
+    HILOG_INFO("SideEffectOutbox Drain end, batchCount:%{public}d, depth:%{public}lld, ts = %{public}lld",
+        batchCount, (long long) GetDepth(), (long long) time(NULL));
+}
+
+int64_t SideEffectOutbox::GetDepth()
+{
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = ContactsDataBase::contactStore_;
+    if (store == nullptr) {
+        return RDB_EXECUTE_FAIL;
+    }
+    auto resultSet = store->QuerySql("SELECT COUNT(*) FROM side_effect_outbox");
+    if (resultSet == nullptr) {
+        return RDB_EXECUTE_FAIL;
+    }
+    int64_t depth = 0;
+    if (resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+        resultSet->GetLong(0, depth);
+    }
+    resultSet->Close();
+    return depth;
+}
+
+int SideEffectOutbox::TakeBatch(std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, OutboxBatch &batch)
+{
+    std::string querySql = "SELECT id, effect_type, payload FROM side_effect_outbox ORDER BY id LIMIT " +
+        std::to_string(OUTBOX_BATCH_SIZE);
+    auto resultSet = store->QuerySql(querySql);
+    if (resultSet == nullptr) {
+        HILOG_ERROR("SideEffectOutbox TakeBatch resultSet is nullptr");
+        return RDB_EXECUTE_FAIL;
+    }
+    int resultSetNum = resultSet->GoToFirstRow();
+    while (resultSetNum == OHOS::NativeRdb::E_OK) {
+        std::string id;
+        int type = 0;
+        std::string payload;
+        resultSet->GetString(COLUMN_INDEX_ID, id);
+        resultSet->GetInt(COLUMN_INDEX_TYPE, type);
+        resultSet->GetString(COLUMN_INDEX_PAYLOAD, payload);
+        batch.ids.push_back(id);
+        AddToBatch(batch, type, payload);
+        resultSetNum = resultSet->GoToNextRow();
+    }
+    resultSet->Close();
+    return OHOS::NativeRdb::E_OK;
+}
+
+void SideEffectOutbox::AddToBatch(OutboxBatch &batch, int type, const std::string &payload)
+{
+    switch (static_cast<SideEffectType>(type)) {
+        case SideEffectType::CALENDAR_DELETE:
+            for (auto &eventId : ContactsStringUtils::SplitStr(payload, ",")) {
+                batch.calendarEventIds.insert(eventId);
+            }
+            break;
+        case SideEffectType::RINGTONE_DELETE:
+            batch.ringtoneUris.insert(payload);
+            break;
+        case SideEffectType::CALLLOG_UNLINK:
+            for (auto &contactId : ContactsStringUtils::SplitStr(payload, ",")) {
+                batch.unlinkContactIds.insert(contactId);
+            }
+            break;
+        case SideEffectType::FORM_CHANGE:
+            batch.formChangeParams.insert(payload);
+            break;
+        case SideEffectType::CLOUD_SYNC:
+            batch.needCloudSync = true;
+            break;
+        case SideEffectType::CLOUD_UPLOAD:
+            batch.needCloudUpload = true;
+            break;
+        default:
+            HILOG_WARN("SideEffectOutbox unknown effect type:%{public}d", type);
+            break;
+    }
+}
+
+void SideEffectOutbox::ExecuteBatch(OutboxBatch &batch)
+{
+    HILOG_INFO("SideEffectOutbox ExecuteBatch size:%{public}zu, calendar:%{public}zu, ringtone:%{public}zu, "
+        "calllog:%{public}zu", batch.ids.size(), batch.calendarEventIds.size(), batch.ringtoneUris.size(),
+        batch.unlinkContactIds.size());
+    std::shared_ptr<ContactConnectAbility> connectAbility = ContactConnectAbility::GetInstance();
+    std::shared_ptr<ContactsDataBase> contactsDataBase = ContactsDataBase::GetInstance();
+    for (auto &param : batch.formChangeParams) {
+        connectAbility->ConnectAbility("", "", "", "", "notifyFormIdChange", param);
+    }
+    if (!batch.unlinkContactIds.empty()) {
+        std::vector<std::string> contactIdVector(batch.unlinkContactIds.begin(), batch.unlinkContactIds.end());
+        ContactsUpdateHelper contactsUpdateHelper;
+        contactsUpdateHelper.UpdateCallLogWhenBatchDelContact(contactIdVector, ContactsDataBase::contactStore_);
+    }
+    // 一个批次的日历生日只通知一次
+    if (!batch.calendarEventIds.empty()) {
+        std::string calendarEventIds;
+        for (auto &eventId : batch.calendarEventIds) {
+            calendarEventIds.append(eventId).append(",");
+        }
+        calendarEventIds = calendarEventIds.substr(0, calendarEventIds.length() - 1);
+        connectAbility->ConnectEventsHandleAbility(CONTACTS_BIRTHDAY_DELETE, calendarEventIds, "");
+    }
+    for (auto &ringtoneUri : batch.ringtoneUris) {
+        contactsDataBase->DeletePersonalRingtone(ringtoneUri);
+    }
+    if (batch.needCloudUpload) {
+        connectAbility->ConnectAbility("", "", "", "", "", "");
+    }
+    if (batch.needCloudSync) {
+        contactsDataBase->SyncContacts();
+    }
+}
+
+int SideEffectOutbox::RemoveBatch(std::shared_ptr<OHOS::NativeRdb::RdbStore> &store, OutboxBatch &batch)
+{
+    OHOS::NativeRdb::RdbPredicates predicates(ContactTableName::SIDE_EFFECT_OUTBOX);
+    predicates.In(SideEffectOutboxColumns::ID, batch.ids);
+    int deletedRows = 0;
+    int ret = store->Delete(deletedRows, predicates);
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("SideEffectOutbox RemoveBatch failed:%{public}d", ret);
+    }
+    return ret;
+}
+} // namespace Contacts
+} // namespace OHOS
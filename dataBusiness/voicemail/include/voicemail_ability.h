@@ -44,6 +44,9 @@ public:
 private:
     static std::shared_ptr<Contacts::VoiceMailDataBase> voiceMailDataBase_;
     static std::map<std::string, int> uriValueMap_;
+    // 语音信箱写操作专用的锁，不与其他ability共用
+    static std::mutex voiceMailMutex_;
+    static std::string GetTableName(int uriCode);
     int InsertExecute(const OHOS::Uri &uri, const OHOS::NativeRdb::ValuesBucket &value);
     void DataBaseNotifyChange(int code, Uri uri);
     bool IsBeginTransactionOK(int code, std::mutex &mutex);
@@ -36,6 +36,7 @@ public:
     static std::shared_ptr<VoiceMailDataBase> GetInstance();
     static std::shared_ptr<OHOS::NativeRdb::RdbStore> store_;
     int64_t InsertVoiceMail(std::string tableName, OHOS::NativeRdb::ValuesBucket insertValues);
+    int64_t BatchInsertVoiceMail(const std::string &tableName, std::vector<OHOS::NativeRdb::ValuesBucket> &values);
     int UpdateVoiceMail(OHOS::NativeRdb::ValuesBucket values, OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     int DeleteVoiceMail(OHOS::NativeRdb::RdbPredicates &rdbPredicates);
     std::shared_ptr<OHOS::NativeRdb::ResultSet> Query(
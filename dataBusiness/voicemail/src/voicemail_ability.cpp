@@ -15,6 +15,8 @@
 
 #include "voicemail_ability.h"
 
+#include <algorithm>
+#include <iterator>
 #include <mutex>
 
 #include "common.h"
@@ -32,9 +34,7 @@
 
 namespace OHOS {
 namespace AbilityRuntime {
-namespace {
-std::mutex g_mutex;
-}
+std::mutex VoiceMailAbility::voiceMailMutex_;
 std::shared_ptr<Contacts::VoiceMailDataBase> VoiceMailAbility::voiceMailDataBase_ = nullptr;
 std::map<std::string, int> VoiceMailAbility::uriValueMap_ = {
     {"/com.ohos.voicemailability/calls/voicemail", Contacts::VOICEMAIL},
@@ -144,54 +144,59 @@ int VoiceMailAbility::Insert(const Uri &uri, const DataShare::DataShareValuesBuc
         HILOG_ERROR("VoiceMailAbility CheckValuesBucket is error");
         return Contacts::RDB_EXECUTE_FAIL;
     }
-    g_mutex.lock();
+    voiceMailMutex_.lock();
     voiceMailDataBase_ = Contacts::VoiceMailDataBase::GetInstance();
     int ret = voiceMailDataBase_->BeginTransaction();
-    if (!IsBeginTransactionOK(ret, g_mutex)) {
-        g_mutex.unlock();
+    if (!IsBeginTransactionOK(ret, voiceMailMutex_)) {
+        voiceMailMutex_.unlock();
         return Contacts::RDB_EXECUTE_FAIL;
     }
     int rowRet = InsertExecute(uri, valuesBucket);
     if (rowRet == Contacts::OPERATION_ERROR) {
         voiceMailDataBase_->RollBack();
-        g_mutex.unlock();
+        voiceMailMutex_.unlock();
         return Contacts::OPERATION_ERROR;
     }
     ret = voiceMailDataBase_->Commit();
-    if (!IsCommitOK(ret, g_mutex)) {
+    if (!IsCommitOK(ret, voiceMailMutex_)) {
         voiceMailDataBase_->RollBack();
-        g_mutex.unlock();
+        voiceMailMutex_.unlock();
         return Contacts::RDB_EXECUTE_FAIL;
     }
-    g_mutex.unlock();
+    voiceMailMutex_.unlock();
     DataBaseNotifyChange(Contacts::CONTACT_INSERT, uri);
     return rowRet;
 }
 
 int VoiceMailAbility::UriParse(Uri &uri)
 {
+    static const Contacts::UriRouteTable routeTable(uriValueMap_);
+    std::string uriString = uri.ToString();
     Contacts::UriUtils uriUtils;
-    int parseCode = uriUtils.UriParse(uri, uriValueMap_);
-    return parseCode;
+    return uriUtils.ParseUri(uriString, routeTable).code;
 }
 
-int VoiceMailAbility::InsertExecute(const OHOS::Uri &uri, const OHOS::NativeRdb::ValuesBucket &initialValues)
+std::string VoiceMailAbility::GetTableName(int uriCode)
 {
-    int rowId = Contacts::RDB_EXECUTE_FAIL;
-    OHOS::Uri uriTemp = uri;
-    int code = UriParse(uriTemp);
-    switch (code) {
+    switch (uriCode) {
         case Contacts::VOICEMAIL:
-            rowId = voiceMailDataBase_->InsertVoiceMail(Contacts::CallsTableName::VOICEMAIL, initialValues);
-            break;
+            return Contacts::CallsTableName::VOICEMAIL;
         case Contacts::REPLAYING:
-            rowId = voiceMailDataBase_->InsertVoiceMail(Contacts::CallsTableName::REPLYING, initialValues);
-            break;
+            return Contacts::CallsTableName::REPLYING;
         default:
-            HILOG_ERROR("VoiceMailAbility ====>no match uri action");
-            break;
+            return "";
+    }
+}
+
+int VoiceMailAbility::InsertExecute(const OHOS::Uri &uri, const OHOS::NativeRdb::ValuesBucket &initialValues)
+{
+    OHOS::Uri uriTemp = uri;
+    std::string tableName = GetTableName(UriParse(uriTemp));
+    if (tableName.empty()) {
+        HILOG_ERROR("VoiceMailAbility ====>no match uri action");
+        return Contacts::RDB_EXECUTE_FAIL;
     }
-    return rowId;
+    return voiceMailDataBase_->InsertVoiceMail(tableName, initialValues);
 }
 
 /**
@@ -212,41 +217,40 @@ int VoiceMailAbility::BatchInsert(const Uri &uri, const std::vector<DataShare::D
     if (size < 1) {
         return Contacts::RDB_EXECUTE_FAIL;
     }
-    g_mutex.lock();
-    voiceMailDataBase_ = Contacts::VoiceMailDataBase::GetInstance();
-    int ret = voiceMailDataBase_->BeginTransaction();
-    if (!IsBeginTransactionOK(ret, g_mutex)) {
-        g_mutex.unlock();
+    // 整批只解析一次uri，同一张表的数据按BATCH_INSERT_COUNT分段，每段一个事务一次BatchInsert
+    OHOS::Uri uriTemp = uri;
+    std::string tableName = GetTableName(UriParse(uriTemp));
+    if (tableName.empty()) {
+        HILOG_ERROR("VoiceMailAbility ====>no match uri action");
         return Contacts::RDB_EXECUTE_FAIL;
     }
-    int count = 0;
-    for (unsigned int i = 0; i < size; i++) {
-        ++count;
-        DataShare::DataShareValuesBucket rawContactValues = values[i];
-        OHOS::NativeRdb::ValuesBucket value = RdbDataShareAdapter::RdbUtils::ToValuesBucket(rawContactValues);
-        int code = InsertExecute(uri, value);
-        if (code == Contacts::OPERATION_ERROR) {
+    std::vector<OHOS::NativeRdb::ValuesBucket> rows;
+    rows.reserve(size);
+    for (const auto &value : values) {
+        rows.push_back(RdbDataShareAdapter::RdbUtils::ToValuesBucket(value));
+    }
+    std::lock_guard<std::mutex> lock(voiceMailMutex_);
+    voiceMailDataBase_ = Contacts::VoiceMailDataBase::GetInstance();
+    size_t batchSize = static_cast<size_t>(Contacts::BATCH_INSERT_COUNT);
+    for (size_t start = 0; start < rows.size(); start += batchSize) {
+        size_t end = std::min(start + batchSize, rows.size());
+        std::vector<OHOS::NativeRdb::ValuesBucket> batch(
+            std::make_move_iterator(rows.begin() + start), std::make_move_iterator(rows.begin() + end));
+        if (voiceMailDataBase_->BeginTransaction() != Contacts::RDB_EXECUTE_OK) {
+            HILOG_ERROR("VoiceMailAbility BatchInsert BeginTransaction failed");
+            return Contacts::RDB_EXECUTE_FAIL;
+        }
+        int64_t insertCount = voiceMailDataBase_->BatchInsertVoiceMail(tableName, batch);
+        if (insertCount < 0) {
             voiceMailDataBase_->RollBack();
-            g_mutex.unlock();
-            return code;
+            return Contacts::OPERATION_ERROR;
         }
-        if (count % Contacts::BATCH_INSERT_COUNT == 0) {
-            int markRet = voiceMailDataBase_->Commit();
-            int beginRet = voiceMailDataBase_->BeginTransaction();
-            if (!IsCommitOK(markRet, g_mutex) || !IsBeginTransactionOK(beginRet, g_mutex)) {
-                voiceMailDataBase_->RollBack();
-                g_mutex.unlock();
-                return Contacts::RDB_EXECUTE_FAIL;
-            }
+        if (voiceMailDataBase_->Commit() != Contacts::RDB_EXECUTE_OK) {
+            HILOG_ERROR("VoiceMailAbility BatchInsert Commit failed");
+            voiceMailDataBase_->RollBack();
+            return Contacts::RDB_EXECUTE_FAIL;
         }
     }
-    int markRet = voiceMailDataBase_->Commit();
-    if (!IsCommitOK(markRet, g_mutex)) {
-        voiceMailDataBase_->RollBack();
-        g_mutex.unlock();
-        return Contacts::RDB_EXECUTE_FAIL;
-    }
-    g_mutex.unlock();
     DataBaseNotifyChange(Contacts::CONTACT_INSERT, uri);
     return Contacts::RDB_EXECUTE_OK;
 }
@@ -273,7 +277,7 @@ int VoiceMailAbility::Update(
         HILOG_ERROR("VoiceMailAbility CheckValuesBucket is error");
         return Contacts::RDB_EXECUTE_FAIL;
     }
-    g_mutex.lock();
+    voiceMailMutex_.lock();
     voiceMailDataBase_ = Contacts::VoiceMailDataBase::GetInstance();
     Contacts::PredicatesConvert predicatesConvert;
     int ret = Contacts::RDB_EXECUTE_FAIL;
@@ -296,7 +300,7 @@ int VoiceMailAbility::Update(
             HILOG_ERROR("VoiceMailAbility ====>no match uri action");
             break;
     }
-    g_mutex.unlock();
+    voiceMailMutex_.unlock();
     if (ret > 0) {
         DataBaseNotifyChange(Contacts::CONTACT_UPDATE, uri);
     } else {
@@ -320,7 +324,7 @@ int VoiceMailAbility::Delete(const Uri &uri, const DataShare::DataSharePredicate
         HILOG_ERROR("Permission denied!");
         return Contacts::RDB_PERMISSION_ERROR;
     }
-    g_mutex.lock();
+    voiceMailMutex_.lock();
     voiceMailDataBase_ = Contacts::VoiceMailDataBase::GetInstance();
     Contacts::PredicatesConvert predicatesConvert;
     int ret = Contacts::RDB_EXECUTE_FAIL;
@@ -343,7 +347,7 @@ int VoiceMailAbility::Delete(const Uri &uri, const DataShare::DataSharePredicate
             HILOG_ERROR("VoiceMailAbility ====>no match uri action");
             break;
     }
-    g_mutex.unlock();
+    voiceMailMutex_.unlock();
     DataBaseNotifyChange(Contacts::CONTACT_DELETE, uri);
     return ret;
 }
@@ -59,6 +59,34 @@ int64_t VoiceMailDataBase::InsertVoiceMail(std::string tableName, OHOS::NativeRd
     return outRowId;
 }
 
+/**
+ * @brief 同一张表的多行一次写入，调用方负责事务
+ *
+ * @param tableName 表名
+ * @param values 待插入的数据，会补充联系人信息
+ *
+ * @return 插入的行数，失败返回RDB_EXECUTE_FAIL
+ */
+int64_t VoiceMailDataBase::BatchInsertVoiceMail(
+    const std::string &tableName, std::vector<OHOS::NativeRdb::ValuesBucket> &values)
+{
+    if (store_ == nullptr) {
+        HILOG_ERROR("VoiceMailDataBase BatchInsert store_ is nullptr");
+        return RDB_OBJECT_EMPTY;
+    }
+    std::shared_ptr<CallLogDataBase> callLogDataBase = CallLogDataBase::GetInstance();
+    for (auto &value : values) {
+        callLogDataBase->QueryContactsByInsertCalls(value, tableName);
+    }
+    int64_t outInsertNum = 0;
+    int ret = store_->BatchInsert(outInsertNum, tableName, values);
+    if (ret != OHOS::NativeRdb::E_OK) {
+        HILOG_ERROR("VoiceMailDataBase BatchInsertVoiceMail ret :%{public}d", ret);
+        return RDB_EXECUTE_FAIL;
+    }
+    return outInsertNum;
+}
+
 int VoiceMailDataBase::UpdateVoiceMail(
     OHOS::NativeRdb::ValuesBucket values, OHOS::NativeRdb::RdbPredicates &rdbPredicates)
 {
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLOUD_CHANGE_SET_TEST_H
+#define CLOUD_CHANGE_SET_TEST_H
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cloud_change_set.h"
+
+namespace Contacts {
+namespace Test {
+class CloudChangeSetTest : public testing::Test {
+public:
+    // 向table添加count个类型为type的uuid，uuid为prefix加序号
+    void AddUuids(OHOS::Contacts::CloudChangeSet &changeSet, const std::string &table,
+        OHOS::Contacts::CloudChangeType type, const std::string &prefix, size_t count);
+    // 按分隔符','拆分分片字段，空字符串返回空列表
+    std::vector<std::string> SplitEntries(const std::string &field);
+};
+} // namespace Test
+} // namespace Contacts
+#endif // CLOUD_CHANGE_SET_TEST_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TIMER_WHEEL_TEST_H
+#define TIMER_WHEEL_TEST_H
+
+#include <gtest/gtest.h>
+
+#include "change_notify_coalescer.h"
+#include "delay_async_task.h"
+#include "timer_wheel.h"
+
+namespace Contacts {
+namespace Test {
+// 手动推进的时钟
+class ManualTimerClock : public OHOS::Contacts::TimerClock {
+public:
+    int64_t NowMs() override
+    {
+        return nowMs_;
+    }
+
+    void AdvanceMs(int64_t ms)
+    {
+        nowMs_ += ms;
+    }
+
+private:
+    int64_t nowMs_ = 0;
+};
+
+// 记录执行次数和执行时刻的任务
+class RecordTask : public OHOS::Contacts::AsyncItem {
+public:
+    RecordTask(std::shared_ptr<ManualTimerClock> clock, std::vector<int64_t> &runTimes, int tag = 0)
+        : clock_(clock), runTimes_(runTimes), tag_(tag)
+    {
+    }
+
+    void Run() override
+    {
+        runTimes_.push_back(clock_->NowMs());
+        lastTag_ = tag_;
+    }
+
+    static int lastTag_;
+
+private:
+    std::shared_ptr<ManualTimerClock> clock_;
+    std::vector<int64_t> &runTimes_;
+    int tag_;
+};
+
+class TimerWheelTest : public testing::Test {
+public:
+    void SetUp() override;
+    void AdvanceAndRun(OHOS::Contacts::TimerWheel &timerWheel, int64_t ms, int64_t stepMs);
+    std::shared_ptr<ManualTimerClock> clock_;
+    std::vector<int64_t> runTimes_;
+};
+} // namespace Test
+} // namespace Contacts
+#endif // TIMER_WHEEL_TEST_H
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef URI_UTILS_TEST_H
+#define URI_UTILS_TEST_H
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "uri_utils.h"
+
+namespace Contacts {
+namespace Test {
+class UriUtilsTest : public testing::Test {
+public:
+    UriUtilsTest();
+    OHOS::Contacts::UriInfo Parse(const std::string &uri);
+
+    std::map<std::string, int> routes_;
+    OHOS::Contacts::UriRouteTable routeTable_;
+    OHOS::Contacts::UriUtils uriUtils_;
+};
+} // namespace Test
+} // namespace Contacts
+#endif // URI_UTILS_TEST_H
@@ -15,7 +15,12 @@
 
 #include "calllogability_test.h"
 
+#include <tuple>
+
+#include "calllog_common.h"
+#include "calllogcheck_ability.h"
 #include "data_ability_operation_builder.h"
+#include "predicates_convert.h"
 #include "random_number_utils.h"
 
 using namespace OHOS::Contacts;
@@ -1385,5 +1390,130 @@ HWTEST_F(CalllogAbilityTest, calllog_async_delete_test_3100, testing::ext::TestS
     }
     ClearCallLog();
 }
+
+/*
+ * @tc.number  calllog_query_plan_test_3200
+ * @tc.name    canonical calllog queries use the calllog indexes
+ * @tc.desc    Call history paging, per-number history and missed call count never scan calllog or sort in a
+ *             temp b-tree
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CalllogAbilityTest, calllog_query_plan_test_3200, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- calllog_query_plan_test_3200 is starting! ---");
+    ASSERT_NE(OHOS::Contacts::CallLogDataBase::GetInstance(), nullptr);
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = OHOS::Contacts::CallLogDataBase::store_;
+    ASSERT_NE(store, nullptr);
+    OHOS::DataShare::DataSharePredicates pagePredicates;
+    pagePredicates.OrderByDesc("begin_time");
+    pagePredicates.Limit(50, 100);
+    OHOS::DataShare::DataSharePredicates numberPredicates;
+    numberPredicates.EqualTo("format_phone_number", "13800000000");
+    numberPredicates.OrderByDesc("begin_time");
+    OHOS::DataShare::DataSharePredicates missedPredicates;
+    missedPredicates.EqualTo("call_direction", "0");
+    missedPredicates.And();
+    missedPredicates.EqualTo("answer_state", "0");
+    missedPredicates.And();
+    missedPredicates.EqualTo("is_read", "0");
+    const std::vector<std::tuple<OHOS::DataShare::DataSharePredicates, std::string, std::string>> queries = {
+        {pagePredicates, "*", "calllog_begin_time_not_privacy_index"},
+        {numberPredicates, "*", "calllog_format_phone_number_begin_time_index"},
+        {missedPredicates, "count(*)", "calllog_missed_unread_index"},
+    };
+    for (const auto &query : queries) {
+        // 与CallLogCheckAbility::Query一致：转换谓词并追加非隐私条件，再按谓词拼出查询语句
+        OHOS::DataShare::DataSharePredicates dataSharePredicates = std::get<0>(query);
+        PredicatesConvert predicatesConvert;
+        OHOS::NativeRdb::RdbPredicates rdbPredicates =
+            predicatesConvert.ConvertPredicates(CallsTableName::CALLLOG, dataSharePredicates);
+        OHOS::AbilityRuntime::CallLogCheckAbility::AddQueryNotPrivacyCondition(rdbPredicates);
+        std::string sql = "SELECT " + std::get<1>(query) + " FROM " + rdbPredicates.GetTableName() + " WHERE " +
+            rdbPredicates.GetWhereClause();
+        if (!rdbPredicates.GetOrder().empty()) {
+            sql += " ORDER BY " + rdbPredicates.GetOrder();
+        }
+        if (rdbPredicates.GetLimit() > 0) {
+            sql += " LIMIT " + std::to_string(rdbPredicates.GetLimit());
+        }
+        if (rdbPredicates.GetOffset() > 0) {
+            sql += " OFFSET " + std::to_string(rdbPredicates.GetOffset());
+        }
+        auto resultSet = store->QuerySql("EXPLAIN QUERY PLAN " + sql, rdbPredicates.GetWhereArgs());
+        ASSERT_NE(resultSet, nullptr);
+        int detailIndex = 0;
+        resultSet->GetColumnIndex("detail", detailIndex);
+        std::string plan;
+        while (resultSet->GoToNextRow() == OHOS::NativeRdb::E_OK) {
+            std::string detail;
+            resultSet->GetString(detailIndex, detail);
+            plan += detail + "; ";
+        }
+        resultSet->Close();
+        HILOG_INFO("calllog_query_plan_test_3200 plan: %{public}s", plan.c_str());
+        EXPECT_NE(plan.find(std::get<2>(query)), std::string::npos) << sql << " => " << plan;
+        EXPECT_EQ(plan.find("TEMP B-TREE"), std::string::npos) << sql << " => " << plan;
+    }
+}
+
+/*
+ * @tc.number  calllog_number_avatar_test_3300
+ * @tc.name    number_avatar follows the remaining call logs of the number
+ * @tc.desc    Deleting the call log holding the avatar, or clearing its extra4, falls back to the latest remaining
+ *             avatar of the number; the entry is removed once no call log of the number has an avatar
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CalllogAbilityTest, calllog_number_avatar_test_3300, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- calllog_number_avatar_test_3300 is starting! ---");
+    ASSERT_NE(OHOS::Contacts::CallLogDataBase::GetInstance(), nullptr);
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = OHOS::Contacts::CallLogDataBase::store_;
+    ASSERT_NE(store, nullptr);
+    const std::string number = "13833003300";
+    auto insertCall = [&store, &number](const std::string &avatar, int64_t beginTime) {
+        OHOS::NativeRdb::ValuesBucket values;
+        values.PutString("phone_number", number);
+        values.PutString("format_phone_number", number);
+        values.PutString("quicksearch_key", "1");
+        values.PutString("extra4", avatar);
+        values.PutLong("begin_time", beginTime);
+        int64_t rowId = 0;
+        store->Insert(rowId, "calllog", values);
+        return rowId;
+    };
+    auto queryAvatar = [&store, &number]() {
+        auto resultSet = store->QuerySql("SELECT extra4 FROM number_avatar WHERE format_phone_number = ?", {number});
+        std::string avatar;
+        if (resultSet != nullptr && resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+            resultSet->GetString(0, avatar);
+        }
+        if (resultSet != nullptr) {
+            resultSet->Close();
+        }
+        return avatar;
+    };
+    int64_t olderId = insertCall("avatar_older", 1000);
+    int64_t latestId = insertCall("avatar_latest", 3000);
+    int64_t lastInsertedId = insertCall("avatar_last_inserted", 2000);
+    ASSERT_GT(olderId, 0);
+    ASSERT_GT(latestId, 0);
+    ASSERT_GT(lastInsertedId, 0);
+    EXPECT_EQ(queryAvatar(), "avatar_last_inserted");
+
+    int deletedRows = 0;
+    store->Delete(deletedRows, "calllog", "id = ?", {std::to_string(lastInsertedId)});
+    EXPECT_EQ(queryAvatar(), "avatar_latest");
+    OHOS::NativeRdb::ValuesBucket clearValues;
+    clearValues.PutNull("extra4");
+    int changedRows = 0;
+    store->Update(changedRows, "calllog", clearValues, "id = ?", {std::to_string(latestId)});
+    EXPECT_EQ(queryAvatar(), "avatar_older");
+    store->Delete(deletedRows, "calllog", "format_phone_number = ?", {number});
+    EXPECT_EQ(queryAvatar(), "");
+}
 } // namespace Test
 } // namespace Contacts
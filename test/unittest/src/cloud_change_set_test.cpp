@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cloud_change_set_test.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace Contacts {
+namespace Test {
+namespace {
+constexpr size_t MAX_ENTRIES = 4;
+constexpr int DELIVER_TIMEOUT_MS = 5000;
+}
+
+void CloudChangeSetTest::AddUuids(OHOS::Contacts::CloudChangeSet &changeSet, const std::string &table,
+    OHOS::Contacts::CloudChangeType type, const std::string &prefix, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        changeSet.Add(table, type, prefix + std::to_string(i));
+    }
+}
+
+std::vector<std::string> CloudChangeSetTest::SplitEntries(const std::string &field)
+{
+    std::vector<std::string> entries;
+    if (field.empty()) {
+        return entries;
+    }
+    size_t start = 0;
+    while (true) {
+        size_t end = field.find(',', start);
+        entries.push_back(field.substr(start, end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return entries;
+}
+
+/*
+ * @tc.number  cloud_change_set_test_100
+ * @tc.name    Entries of different tables in one field are joined by a single separator
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CloudChangeSetTest, cloud_change_set_test_100, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::CloudChangeSet changeSet;
+    changeSet.Add("raw_contact", OHOS::Contacts::CloudChangeType::INSERT, "a");
+    changeSet.Add("groups", OHOS::Contacts::CloudChangeType::INSERT, "b");
+    changeSet.Add("raw_contact", OHOS::Contacts::CloudChangeType::DELETE, "c");
+    std::vector<OHOS::Contacts::CloudChangeChunk> chunks = changeSet.Split(MAX_ENTRIES);
+    ASSERT_EQ(1, (int) chunks.size());
+    EXPECT_EQ("b;groups,a;raw_contact", chunks[0].uuidToInsert);
+    EXPECT_EQ("", chunks[0].uuidToUpdate);
+    EXPECT_EQ("c;raw_contact", chunks[0].uuidToDelete);
+    EXPECT_EQ(3, (int) chunks[0].entryCount);
+    EXPECT_TRUE(chunks[0].handleType.empty());
+}
+
+/*
+ * @tc.number  cloud_change_set_test_200
+ * @tc.name    Exactly maxEntries uuids fit in one chunk, one more starts a second chunk
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CloudChangeSetTest, cloud_change_set_test_200, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::CloudChangeSet exact;
+    AddUuids(exact, "raw_contact", OHOS::Contacts::CloudChangeType::UPDATE, "u", MAX_ENTRIES);
+    std::vector<OHOS::Contacts::CloudChangeChunk> chunks = exact.Split(MAX_ENTRIES);
+    ASSERT_EQ(1, (int) chunks.size());
+    EXPECT_EQ(MAX_ENTRIES, chunks[0].entryCount);
+    EXPECT_EQ(MAX_ENTRIES, SplitEntries(chunks[0].uuidToUpdate).size());
+
+    OHOS::Contacts::CloudChangeSet overflow;
+    AddUuids(overflow, "raw_contact", OHOS::Contacts::CloudChangeType::UPDATE, "u", MAX_ENTRIES + 1);
+    chunks = overflow.Split(MAX_ENTRIES);
+    ASSERT_EQ(2, (int) chunks.size());
+    EXPECT_EQ(MAX_ENTRIES, chunks[0].entryCount);
+    EXPECT_EQ(1, (int) chunks[1].entryCount);
+    EXPECT_EQ("u4;raw_contact", chunks[1].uuidToUpdate);
+
+    OHOS::Contacts::CloudChangeSet underflow;
+    AddUuids(underflow, "raw_contact", OHOS::Contacts::CloudChangeType::UPDATE, "u", MAX_ENTRIES - 1);
+    chunks = underflow.Split(MAX_ENTRIES);
+    ASSERT_EQ(1, (int) chunks.size());
+    EXPECT_EQ(MAX_ENTRIES - 1, chunks[0].entryCount);
+}
+
+/*
+ * @tc.number  cloud_change_set_test_300
+ * @tc.name    Different types share a chunk until it is full, inserts come before updates and deletes
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CloudChangeSetTest, cloud_change_set_test_300, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::CloudChangeSet changeSet;
+    AddUuids(changeSet, "raw_contact", OHOS::Contacts::CloudChangeType::DELETE, "d", 2);
+    AddUuids(changeSet, "raw_contact", OHOS::Contacts::CloudChangeType::INSERT, "i", MAX_ENTRIES - 1);
+    std::vector<OHOS::Contacts::CloudChangeChunk> chunks = changeSet.Split(MAX_ENTRIES);
+    ASSERT_EQ(2, (int) chunks.size());
+    EXPECT_EQ(MAX_ENTRIES - 1, SplitEntries(chunks[0].uuidToInsert).size());
+    EXPECT_EQ("d0;raw_contact", chunks[0].uuidToDelete);
+    EXPECT_EQ(MAX_ENTRIES, chunks[0].entryCount);
+    EXPECT_TRUE(chunks[1].uuidToInsert.empty());
+    EXPECT_EQ("d1;raw_contact", chunks[1].uuidToDelete);
+    size_t total = 0;
+    for (const auto &chunk : chunks) {
+        EXPECT_LE(chunk.entryCount, MAX_ENTRIES);
+        total += chunk.entryCount;
+    }
+    EXPECT_EQ(changeSet.Size(), total);
+}
+
+/*
+ * @tc.number  cloud_change_set_test_400
+ * @tc.name    A logout pushed after the chunks of a change is delivered after all of them
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CloudChangeSetTest, cloud_change_set_test_400, testing::ext::TestSize.Level1)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<OHOS::Contacts::CloudChangeChunk> delivered;
+    // 队列上限小于分片数，入队方会等待投递线程
+    OHOS::Contacts::CloudChangeDeliverQueue deliverQueue([&](const OHOS::Contacts::CloudChangeChunk &chunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        delivered.push_back(chunk);
+        cv.notify_all();
+    }, 2, 0);
+    OHOS::Contacts::CloudChangeSet changeSet;
+    AddUuids(changeSet, "raw_contact", OHOS::Contacts::CloudChangeType::INSERT, "i", MAX_ENTRIES * 3 + 1);
+    std::vector<OHOS::Contacts::CloudChangeChunk> chunks = changeSet.Split(MAX_ENTRIES);
+    size_t chunkCount = chunks.size();
+    deliverQueue.Push(chunks);
+    std::vector<OHOS::Contacts::CloudChangeChunk> logout(1);
+    logout.front().handleType = "logOutDelContact";
+    deliverQueue.Push(logout);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::milliseconds(DELIVER_TIMEOUT_MS),
+        [&] { return delivered.size() == chunkCount + 1; }));
+    for (size_t i = 0; i < chunkCount; i++) {
+        EXPECT_TRUE(delivered[i].handleType.empty());
+        EXPECT_FALSE(delivered[i].uuidToInsert.empty());
+    }
+    EXPECT_EQ("logOutDelContact", delivered.back().handleType);
+    EXPECT_TRUE(delivered.back().uuidToInsert.empty());
+}
+
+/*
+ * @tc.number  cloud_change_set_test_500
+ * @tc.name    Stopping the deliver queue joins the thread and drops chunks pushed afterwards
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(CloudChangeSetTest, cloud_change_set_test_500, testing::ext::TestSize.Level1)
+{
+    int deliveredCount = 0;
+    OHOS::Contacts::CloudChangeDeliverQueue deliverQueue(
+        [&deliveredCount](const OHOS::Contacts::CloudChangeChunk &chunk) { deliveredCount++; }, 2, 0);
+    deliverQueue.Stop();
+    std::vector<OHOS::Contacts::CloudChangeChunk> chunks(1);
+    deliverQueue.Push(chunks);
+    deliverQueue.Stop();
+    EXPECT_EQ(0, deliveredCount);
+}
+} // namespace Test
+} // namespace Contacts
@@ -14,6 +14,11 @@
  */
 
 #include "contactability_test.h"
+
+#include <algorithm>
+#include <map>
+
+#include "contact_data_changes.h"
 #include "random_number_utils.h"
 
 #include "data_ability_operation_builder.h"
@@ -28,6 +33,36 @@ ContactAbilityTest::~ContactAbilityTest()
 {
 }
 
+static OHOS::DataShare::OperationStatement BuildContactDataStatement(const std::string &uri,
+    const OHOS::DataShare::DataShareValuesBucket &values, const std::string &backColumn = "", int32_t fromIndex = -1)
+{
+    OHOS::DataShare::DataSharePredicates predicates;
+    OHOS::DataShare::BackReference backReference;
+    if (!backColumn.empty()) {
+        backReference = OHOS::DataShare::BackReference(backColumn, fromIndex);
+    }
+    return OHOS::DataShare::OperationStatement {
+        OHOS::DataShare::Operation::INSERT, uri, predicates, values, backReference};
+}
+
+static std::string QueryContactDataString(OHOS::AbilityRuntime::ContactsDataAbility &ability, const std::string &uri,
+    const std::string &id, const std::string &column)
+{
+    OHOS::Uri queryUri(uri);
+    OHOS::DataShare::DataSharePredicates predicates;
+    predicates.EqualTo("id", id);
+    std::vector<std::string> columns = {column};
+    std::shared_ptr<OHOS::DataShare::DataShareResultSet> resultSet = ability.Query(queryUri, predicates, columns);
+    std::string value;
+    if (resultSet != nullptr && resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+        resultSet->GetString(0, value);
+    }
+    if (resultSet != nullptr) {
+        resultSet->Close();
+    }
+    return value;
+}
+
 int64_t ContactAbilityTest::RawContactInsert(std::string displayName,
     OHOS::DataShare::DataShareValuesBucket &rawContactValues)
 {
@@ -3669,5 +3704,272 @@ HWTEST_F(ContactAbilityTest, contact_Delete_Recover_test_7500, testing::ext::Tes
     resultSet->Close();
     ClearContacts();
 }
+
+/*
+ * @tc.number  contact_UpdateChangedRows_test_7600
+ * @tc.name    update only the changed contact data rows
+ * @tc.desc    The update diff keeps the unchanged row, deletes the changed and the removed rows by id and
+ *             inserts only the new data
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactAbilityTest, contact_UpdateChangedRows_test_7600, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contact_UpdateChangedRows_test_7600 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("xiaoliuUpdate", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket keepValues;
+    int64_t keepId = ContactDataInsert(rawContactId, "email", "xiaoliu@163.com", "", keepValues);
+    EXPECT_GT(keepId, 0);
+    OHOS::DataShare::DataShareValuesBucket changeValues;
+    int64_t changeId = ContactDataInsert(rawContactId, "phone", "13800000000", "", changeValues);
+    EXPECT_GT(changeId, 0);
+    OHOS::DataShare::DataShareValuesBucket removeValues;
+    int64_t removeId = ContactDataInsert(rawContactId, "nickname", "xiaoliu", "", removeValues);
+    EXPECT_GT(removeId, 0);
+
+    // 与updateContact一致：读取已存数据，与联系人对象生成的新数据比较，只提交变化的行
+    OHOS::DataShare::DataSharePredicates scopePredicates;
+    scopePredicates.EqualTo("raw_contact_id", std::to_string(rawContactId));
+    std::vector<std::string> storedColumns = OHOS::ContactsApi::ContactDataChanges::QueryColumns();
+    std::shared_ptr<OHOS::DataShare::DataShareResultSet> storedSet =
+        ContactQuery(ContactTabName::CONTACT_DATA, storedColumns, scopePredicates);
+    std::map<std::string, std::vector<int>> storedRows;
+    OHOS::ContactsApi::ContactDataChanges::ReadStoredRows(storedSet, storedRows);
+    storedSet->Close();
+    OHOS::DataShare::DataShareValuesBucket emailBucket;
+    emailBucket.Put("raw_contact_id", rawContactId);
+    emailBucket.Put("content_type", "email");
+    emailBucket.Put("detail_info", "xiaoliu@163.com");
+    OHOS::DataShare::DataShareValuesBucket phoneBucket;
+    phoneBucket.Put("raw_contact_id", rawContactId);
+    phoneBucket.Put("content_type", "phone");
+    phoneBucket.Put("detail_info", "13900000000");
+    std::vector<OHOS::DataShare::DataShareValuesBucket> buckets = {emailBucket, phoneBucket};
+    std::vector<std::string> deleteIds;
+    std::vector<OHOS::DataShare::DataShareValuesBucket> insertValues;
+    OHOS::ContactsApi::ContactDataChanges::Split(buckets, storedRows, deleteIds, insertValues);
+    std::sort(deleteIds.begin(), deleteIds.end());
+    std::vector<std::string> expectDeleteIds = {std::to_string(changeId), std::to_string(removeId)};
+    std::sort(expectDeleteIds.begin(), expectDeleteIds.end());
+    EXPECT_EQ(expectDeleteIds, deleteIds);
+    EXPECT_EQ(1u, insertValues.size());
+
+    OHOS::DataShare::DataSharePredicates deletePredicates;
+    deletePredicates.In("id", deleteIds);
+    int deleteCode = ContactDelete(ContactTabName::CONTACT_DATA, deletePredicates);
+    EXPECT_EQ(deleteCode, 0);
+    OHOS::Uri uriContactData(ContactsUri::CONTACT_DATA);
+    int insertCode = contactsDataAbility.BatchInsert(uriContactData, insertValues);
+    EXPECT_EQ(insertCode, 0);
+
+    std::vector<std::string> dataColumns = {"id", "content_type", "detail_info"};
+    OHOS::DataShare::DataSharePredicates dataPredicates;
+    dataPredicates.EqualTo("raw_contact_id", std::to_string(rawContactId));
+    dataPredicates.OrderByAsc("id");
+    std::shared_ptr<OHOS::DataShare::DataShareResultSet> resultSet =
+        ContactQuery(ContactTabName::CONTACT_DATA, dataColumns, dataPredicates);
+    int rowCount = 0;
+    resultSet->GetRowCount(rowCount);
+    EXPECT_EQ(2, rowCount);
+    int keptId = 0;
+    std::string keptDetail;
+    resultSet->GoToFirstRow();
+    resultSet->GetInt(0, keptId);
+    resultSet->GetString(2, keptDetail);
+    EXPECT_EQ(keepId, keptId);
+    EXPECT_EQ("xiaoliu@163.com", keptDetail);
+    int insertedId = 0;
+    std::string insertedType;
+    std::string insertedDetail;
+    resultSet->GoToNextRow();
+    resultSet->GetInt(0, insertedId);
+    resultSet->GetString(1, insertedType);
+    resultSet->GetString(2, insertedDetail);
+    EXPECT_GT(insertedId, removeId);
+    EXPECT_EQ("phone", insertedType);
+    EXPECT_EQ("13900000000", insertedDetail);
+    resultSet->Close();
+    ClearContacts();
+}
+
+/*
+ * @tc.number  contact_ExecuteBatch_test_7700
+ * @tc.name    ExecuteBatch back reference into the pending contact_data group
+ * @tc.desc    A statement referring to a contact_data insert that is still pending gets that row's id
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactAbilityTest, contact_ExecuteBatch_test_7700, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contact_ExecuteBatch_test_7700 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("executeBatchBackRef", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket phoneValues;
+    phoneValues.Put("raw_contact_id", rawContactId);
+    phoneValues.Put("content_type", "phone");
+    phoneValues.Put("detail_info", "13877007700");
+    OHOS::DataShare::DataShareValuesBucket emailValues;
+    emailValues.Put("raw_contact_id", rawContactId);
+    emailValues.Put("content_type", "email");
+    emailValues.Put("detail_info", "7700@test.com");
+    std::vector<OHOS::DataShare::OperationStatement> statements = {
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, phoneValues),
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, emailValues, "extend7", 0)};
+    OHOS::DataShare::ExecResultSet result;
+    int ret = contactsDataAbility.ExecuteBatch(statements, result);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(result.errorCode, OHOS::DataShare::ExecErrorCode::EXEC_SUCCESS);
+    ASSERT_EQ(result.results.size(), statements.size());
+    std::string phoneId = result.results[0].message;
+    EXPECT_GT(std::atoi(phoneId.c_str()), 0);
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::CONTACT_DATA, phoneId, "detail_info"),
+        "13877007700");
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::CONTACT_DATA, result.results[1].message,
+        "extend7"), phoneId);
+    ClearContacts();
+}
+
+/*
+ * @tc.number  contact_ExecuteBatch_test_7800
+ * @tc.name    ExecuteBatch with contact_data inserts switching between contacts and profile
+ * @tc.desc    Each contact_data group is written to the database of its own uri
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactAbilityTest, contact_ExecuteBatch_test_7800, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contact_ExecuteBatch_test_7800 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("executeBatchContacts", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::Uri uriProfileRawContact(ProfileUri::RAW_CONTACT);
+    OHOS::DataShare::DataShareValuesBucket profileRawValues;
+    profileRawValues.Put("display_name", "executeBatchProfile");
+    int64_t profileRawContactId = contactsDataAbility.Insert(uriProfileRawContact, profileRawValues);
+    EXPECT_GT(profileRawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket contactValuesOne;
+    contactValuesOne.Put("raw_contact_id", rawContactId);
+    contactValuesOne.Put("content_type", "phone");
+    contactValuesOne.Put("detail_info", "13878007800");
+    OHOS::DataShare::DataShareValuesBucket profileValues;
+    profileValues.Put("raw_contact_id", profileRawContactId);
+    profileValues.Put("content_type", "phone");
+    profileValues.Put("detail_info", "13878007801");
+    OHOS::DataShare::DataShareValuesBucket contactValuesTwo;
+    contactValuesTwo.Put("raw_contact_id", rawContactId);
+    contactValuesTwo.Put("content_type", "email");
+    contactValuesTwo.Put("detail_info", "7800@test.com");
+    std::vector<OHOS::DataShare::OperationStatement> statements = {
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, contactValuesOne),
+        BuildContactDataStatement(ProfileUri::CONTACT_DATA, profileValues),
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, contactValuesTwo)};
+    OHOS::DataShare::ExecResultSet result;
+    int ret = contactsDataAbility.ExecuteBatch(statements, result);
+    EXPECT_EQ(ret, 0);
+    ASSERT_EQ(result.results.size(), statements.size());
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::CONTACT_DATA, result.results[0].message,
+        "detail_info"), "13878007800");
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ProfileUri::CONTACT_DATA, result.results[1].message,
+        "detail_info"), "13878007801");
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::CONTACT_DATA, result.results[2].message,
+        "detail_info"), "7800@test.com");
+    OHOS::Uri uriProfileContactData(ProfileUri::CONTACT_DATA);
+    OHOS::DataShare::DataSharePredicates profilePredicates;
+    profilePredicates.EqualTo("raw_contact_id", std::to_string(profileRawContactId));
+    contactsDataAbility.Delete(uriProfileContactData, profilePredicates);
+    OHOS::DataShare::DataSharePredicates profileRawPredicates;
+    profileRawPredicates.EqualTo("id", std::to_string(profileRawContactId));
+    contactsDataAbility.Delete(uriProfileRawContact, profileRawPredicates);
+    ClearContacts();
+}
+
+/*
+ * @tc.number  contact_ExecuteBatch_test_7900
+ * @tc.name    ExecuteBatch back reference that cannot be resolved
+ * @tc.desc    The statement falls back to the single insert path, which fails it and rolls back the whole batch
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactAbilityTest, contact_ExecuteBatch_test_7900, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contact_ExecuteBatch_test_7900 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("executeBatchFallback", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket phoneValues;
+    phoneValues.Put("raw_contact_id", rawContactId);
+    phoneValues.Put("content_type", "phone");
+    phoneValues.Put("detail_info", "13879007900");
+    OHOS::DataShare::DataShareValuesBucket emailValues;
+    emailValues.Put("content_type", "email");
+    emailValues.Put("detail_info", "7900@test.com");
+    int32_t missingIndex = 9;
+    std::vector<OHOS::DataShare::OperationStatement> statements = {
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, phoneValues),
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, emailValues, "raw_contact_id", missingIndex)};
+    OHOS::DataShare::ExecResultSet result;
+    int ret = contactsDataAbility.ExecuteBatch(statements, result);
+    EXPECT_NE(ret, 0);
+    ASSERT_EQ(result.results.size(), statements.size());
+    EXPECT_EQ(result.results[1].code, OHOS::DataShare::ExecErrorCode::EXEC_FAILED);
+    OHOS::DataShare::DataSharePredicates predicates;
+    predicates.EqualTo("raw_contact_id", std::to_string(rawContactId));
+    std::vector<std::string> columns = {"id"};
+    std::shared_ptr<OHOS::DataShare::DataShareResultSet> resultSet =
+        ContactQuery(ContactTabName::CONTACT_DATA, columns, predicates);
+    int rowCount = 0;
+    resultSet->GetRowCount(rowCount);
+    resultSet->Close();
+    EXPECT_EQ(rowCount, 0);
+    ClearContacts();
+}
+
+/*
+ * @tc.number  contact_ExecuteBatch_test_8000
+ * @tc.name    ExecuteBatch organization rows of one contact in one group
+ * @tc.desc    The raw contact takes company and position from the last organization row that has them
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactAbilityTest, contact_ExecuteBatch_test_8000, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contact_ExecuteBatch_test_8000 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("executeBatchOrganization", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket firstValues;
+    firstValues.Put("raw_contact_id", rawContactId);
+    firstValues.Put("content_type", "organization");
+    firstValues.Put("detail_info", "firstCompany");
+    firstValues.Put("position", "firstPosition");
+    OHOS::DataShare::DataShareValuesBucket lastValues;
+    lastValues.Put("raw_contact_id", rawContactId);
+    lastValues.Put("content_type", "organization");
+    lastValues.Put("detail_info", "lastCompany");
+    lastValues.Put("position", "lastPosition");
+    OHOS::DataShare::DataShareValuesBucket emptyValues;
+    emptyValues.Put("raw_contact_id", rawContactId);
+    emptyValues.Put("content_type", "organization");
+    std::vector<OHOS::DataShare::OperationStatement> statements = {
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, firstValues),
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, lastValues),
+        BuildContactDataStatement(ContactsUri::CONTACT_DATA, emptyValues)};
+    OHOS::DataShare::ExecResultSet result;
+    int ret = contactsDataAbility.ExecuteBatch(statements, result);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::RAW_CONTACT, std::to_string(rawContactId),
+        "company"), "lastCompany");
+    EXPECT_EQ(QueryContactDataString(contactsDataAbility, ContactsUri::RAW_CONTACT, std::to_string(rawContactId),
+        "position"), "lastPosition");
+    ClearContacts();
+}
 } // namespace Test
 } // namespace Contacts
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 #include "contactgroup_test.h"
 
+#include "account_purge.h"
+#include "contacts_database.h"
 #include "test_common.h"
 
 namespace Contacts {
@@ -700,5 +702,64 @@ HWTEST_F(ContactGroupTest, abnormal_groups_Update_test_1400, testing::ext::TestS
     EXPECT_EQ(updateCode, 0);
     ClearData();
 }
+
+/*
+ * @tc.number  account_Purge_test_1500
+ * @tc.name    Purging an account with more raw contacts than one chunk leaves no orphaned rows
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactGroupTest, account_Purge_test_1500, testing::ext::TestSize.Level1)
+{
+    std::shared_ptr<OHOS::Contacts::ContactsDataBase> contactsDataBase =
+        OHOS::Contacts::ContactsDataBase::GetInstance();
+    ASSERT_NE(contactsDataBase, nullptr);
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = contactsDataBase->contactStore_;
+    ASSERT_NE(store, nullptr);
+    const int accountId = 990100;
+    const int firstRawId = 990101;
+    // 两个完整的批次加一个不完整的批次
+    const int rawContactCount = OHOS::Contacts::ACCOUNT_PURGE_CHUNK_SIZE * 2 + 50;
+    const int lastRawId = firstRawId + rawContactCount - 1;
+    auto countRows = [&store](const std::string &sql, const std::vector<std::string> &args) {
+        auto resultSet = store->QuerySql(sql, args);
+        int count = -1;
+        if (resultSet != nullptr && resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+            resultSet->GetInt(0, count);
+        }
+        if (resultSet != nullptr) {
+            resultSet->Close();
+        }
+        return count;
+    };
+    store->ExecuteSql("INSERT OR REPLACE INTO account (id, account_name, account_type) VALUES (?, 'purge', 'purge')",
+        {accountId});
+    store->ExecuteSql("INSERT INTO groups (account_id, group_name) VALUES (?, 'purge')", {accountId});
+    store->BeginTransaction();
+    for (int rawId = firstRawId; rawId <= lastRawId; rawId++) {
+        store->ExecuteSql("INSERT INTO contact (id) VALUES (?)", {rawId});
+        store->ExecuteSql("INSERT INTO raw_contact (id, contact_id, account_id) VALUES (?, ?, ?)",
+            {rawId, rawId, accountId});
+        store->ExecuteSql("INSERT INTO contact_data (raw_contact_id, type_id, detail_info) VALUES (?, 5, ?)",
+            {rawId, std::to_string(rawId)});
+    }
+    store->Commit();
+    ASSERT_EQ(countRows("SELECT count(*) FROM raw_contact WHERE account_id = ?", {std::to_string(accountId)}),
+        rawContactCount);
+
+    OHOS::Contacts::AccountPurge accountPurge(store);
+    EXPECT_EQ(accountPurge.Purge(accountId), OHOS::Contacts::RDB_EXECUTE_OK);
+
+    std::vector<std::string> accountArgs = {std::to_string(accountId)};
+    std::vector<std::string> idArgs = {std::to_string(firstRawId), std::to_string(lastRawId)};
+    EXPECT_EQ(countRows("SELECT count(*) FROM raw_contact WHERE account_id = ?", accountArgs), 0);
+    EXPECT_EQ(countRows("SELECT count(*) FROM contact_data WHERE raw_contact_id BETWEEN ? AND ?", idArgs), 0);
+    EXPECT_EQ(countRows("SELECT count(*) FROM contact WHERE id BETWEEN ? AND ?", idArgs), 0);
+    EXPECT_EQ(countRows("SELECT count(*) FROM groups WHERE account_id = ?", accountArgs), 0);
+    EXPECT_EQ(countRows("SELECT count(*) FROM account WHERE id = ?", accountArgs), 0);
+    EXPECT_EQ(countRows("SELECT count(*) FROM account_purge_cursor WHERE account_id = ?", accountArgs), 0);
+}
 } // namespace Test
 } // namespace Contacts
\ No newline at end of file
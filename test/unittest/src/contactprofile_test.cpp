@@ -3375,5 +3375,45 @@ HWTEST_F(ContactProfileTest, abnormal_contactProfile_BatchInsert_test_6900, test
     predicates2.NotEqualTo("id", "0");
     contactsDataAbility.Delete(uriRawContactComplete, predicates2);
 }
+
+/*
+ * @tc.number  contactProfile_Delete_test_7000
+ * @tc.name    Delete a profile contact with a birthday
+ * @tc.desc    The delete succeeds although profile.db has no side effect outbox
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(ContactProfileTest, contactProfile_Delete_test_7000, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- contactProfile_Delete_test_7000 is starting! ---");
+    OHOS::DataShare::DataShareValuesBucket rawContactValues;
+    int64_t rawContactId = RawContactInsert("profileOutbox", rawContactValues);
+    EXPECT_GT(rawContactId, 0);
+    OHOS::DataShare::DataShareValuesBucket contactDataValues;
+    int64_t contactDataId = ContactDataInsert(rawContactId, "contact_event", "2000-01-01", "", contactDataValues);
+    EXPECT_GT(contactDataId, 0);
+
+    OHOS::DataShare::DataSharePredicates predicates;
+    predicates.EqualTo("name_raw_contact_id", std::to_string(rawContactId));
+    std::string contact = ContactTabName::CONTACT;
+    int deleteCode = ContactDelete(contact, predicates);
+    EXPECT_EQ(deleteCode, 0);
+
+    std::vector<std::string> columns;
+    columns.push_back("is_deleted");
+    OHOS::DataShare::DataSharePredicates rawPredicates;
+    rawPredicates.EqualTo("id", std::to_string(rawContactId));
+    std::string rawContact = ContactTabName::RAW_CONTACT;
+    std::shared_ptr<OHOS::DataShare::DataShareResultSet> resultSet =
+        ContactQuery(rawContact, columns, rawPredicates);
+    int isDeleted = 0;
+    if (resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+        resultSet->GetInt(0, isDeleted);
+    }
+    resultSet->Close();
+    EXPECT_EQ(1, isDeleted);
+    ClearContacts();
+}
 } // namespace Test
 } // namespace Contacts
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "datashare_metrics_test.h"
+
+#include <thread>
+#include <vector>
+
+#include "json/json.h"
+
+namespace Contacts {
+namespace Test {
+namespace {
+const std::string RAW_CONTACT_PATH = "/com.ohos.contactsdataability/contacts/raw_contact";
+const std::string CONTACT_DATA_PATH = "/com.ohos.contactsdataability/contacts/contact_data";
+
+Json::Value ParseDump()
+{
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    std::string errors;
+    std::string dump = OHOS::Contacts::DataShareMetrics::GetInstance().Dump();
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    reader->parse(dump.c_str(), dump.c_str() + dump.length(), &root, &errors);
+    return root;
+}
+
+Json::Value FindUri(const Json::Value &root, const std::string &operation, const std::string &uri)
+{
+    for (const auto &item : root["uris"]) {
+        if (item["operation"].asString() == operation && item["uri"].asString() == uri) {
+            return item;
+        }
+    }
+    return Json::Value();
+}
+}
+
+void DataShareMetricsTest::SetUp()
+{
+    OHOS::Contacts::DataShareMetrics::GetInstance().Reset();
+}
+
+void DataShareMetricsTest::TearDown()
+{
+    OHOS::Contacts::DataShareMetrics::GetInstance().Reset();
+}
+
+/*
+ * @tc.number  datashare_metrics_test_100
+ * @tc.name    Percentiles stay within one sub-bucket of the recorded values
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(DataShareMetricsTest, datashare_metrics_test_100, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++) {
+        histogram.Record(value);
+    }
+    EXPECT_EQ(1000, (int) histogram.Count());
+    EXPECT_EQ(1000, (int) histogram.Max());
+    uint64_t p50 = histogram.Percentile(50);
+    uint64_t p99 = histogram.Percentile(99);
+    EXPECT_GE(p50, 500u);
+    EXPECT_LE(p50, 500u + 500u / 8);
+    EXPECT_GE(p99, 990u);
+    EXPECT_LE(p99, 1000u);
+    histogram.Reset();
+    EXPECT_EQ(0, (int) histogram.Percentile(99));
+}
+
+/*
+ * @tc.number  datashare_metrics_test_200
+ * @tc.name    Operations are aggregated per operation and per uri, with row counters
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(DataShareMetricsTest, datashare_metrics_test_200, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::DataShareMetrics &metrics = OHOS::Contacts::DataShareMetrics::GetInstance();
+    metrics.Record(OHOS::Contacts::DataShareOperation::INSERT, RAW_CONTACT_PATH, 100, 1);
+    metrics.Record(OHOS::Contacts::DataShareOperation::INSERT, RAW_CONTACT_PATH, 300, 1);
+    metrics.Record(OHOS::Contacts::DataShareOperation::UPDATE, CONTACT_DATA_PATH, 50, 7);
+    metrics.Record(OHOS::Contacts::DataShareOperation::QUERY, CONTACT_DATA_PATH, 20,
+        OHOS::Contacts::DATASHARE_METRICS_ROWS_UNKNOWN);
+    Json::Value root = ParseDump();
+    Json::Value insert = FindUri(root, "insert", RAW_CONTACT_PATH);
+    EXPECT_EQ(2u, insert["count"].asUInt64());
+    EXPECT_EQ(2, insert["rows"].asInt64());
+    EXPECT_EQ(300u, insert["max_us"].asUInt64());
+    Json::Value update = FindUri(root, "update", CONTACT_DATA_PATH);
+    EXPECT_EQ(7, update["rows"].asInt64());
+    Json::Value query = FindUri(root, "query", CONTACT_DATA_PATH);
+    EXPECT_EQ(1u, query["count"].asUInt64());
+    EXPECT_EQ(0, query["rows"].asInt64());
+    EXPECT_EQ(3u, root["operations"].size());
+}
+
+/*
+ * @tc.number  datashare_metrics_test_300
+ * @tc.name    Concurrent recording from several threads loses no samples
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(DataShareMetricsTest, datashare_metrics_test_300, testing::ext::TestSize.Level1)
+{
+    constexpr int threadCount = 4;
+    constexpr int recordCount = 10000;
+    OHOS::Contacts::DataShareMetrics &metrics = OHOS::Contacts::DataShareMetrics::GetInstance();
+    metrics.Record(OHOS::Contacts::DataShareOperation::DELETE, RAW_CONTACT_PATH, 1, 1);
+    metrics.Reset();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back([&metrics]() {
+            for (int j = 0; j < recordCount; j++) {
+                metrics.Record(OHOS::Contacts::DataShareOperation::DELETE, RAW_CONTACT_PATH, j, 1);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    Json::Value item = FindUri(ParseDump(), "delete", RAW_CONTACT_PATH);
+    EXPECT_EQ((uint64_t) threadCount * recordCount, item["count"].asUInt64());
+    EXPECT_EQ((int64_t) threadCount * recordCount, item["rows"].asInt64());
+}
+
+/*
+ * @tc.number  datashare_metrics_test_400
+ * @tc.name    Slow samples keep the normalized sql and are bounded
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(DataShareMetricsTest, datashare_metrics_test_400, testing::ext::TestSize.Level1)
+{
+    EXPECT_EQ("SELECT * FROM raw_contact WHERE id IN (?) AND display_name = ? AND x1 = ?",
+        OHOS::Contacts::DataShareMetrics::NormalizeSql(
+            "SELECT *  FROM raw_contact WHERE id IN (1, 2,3) AND display_name = 'O''Neil' AND x1 = ?"));
+    OHOS::Contacts::DataShareMetrics &metrics = OHOS::Contacts::DataShareMetrics::GetInstance();
+    EXPECT_FALSE(OHOS::Contacts::DataShareMetrics::IsSlow(OHOS::Contacts::DATASHARE_SLOW_OPERATION_US - 1));
+    EXPECT_TRUE(OHOS::Contacts::DataShareMetrics::IsSlow(OHOS::Contacts::DATASHARE_SLOW_OPERATION_US));
+    for (size_t i = 0; i < OHOS::Contacts::DATASHARE_METRICS_MAX_SLOW_SAMPLES + 1; i++) {
+        metrics.RecordSlow(OHOS::Contacts::DataShareOperation::QUERY, RAW_CONTACT_PATH,
+            "SELECT * FROM raw_contact WHERE id = " + std::to_string(i), OHOS::Contacts::DATASHARE_SLOW_OPERATION_US);
+    }
+    Json::Value slow = ParseDump()["slow"];
+    ASSERT_EQ(OHOS::Contacts::DATASHARE_METRICS_MAX_SLOW_SAMPLES, slow.size());
+    EXPECT_EQ("SELECT * FROM raw_contact WHERE id = ?", slow[0]["sql"].asString());
+}
+} // namespace Test
+} // namespace Contacts
@@ -1283,5 +1283,85 @@ HWTEST_F(MergeContactTest, merge_Update_test_2700, testing::ext::TestSize.Level1
     CheckMergeResultId(resultIdVector, true);
     DeleteRawContact();
 }
+
+/*
+ * @tc.number  merge_BulkWrite_flags_test_2800
+ * @tc.name    bulk write and per-row triggers give a merged contact the same has_* flags
+ * @tc.desc    contacts 990001 and 990011 each merge a name raw contact and a second raw contact. The same writes run
+ *             per row on the first one and inside a bulk write on the second one, the flags must stay equal and
+ *             only follow the data of name_raw_contact_id
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(MergeContactTest, merge_BulkWrite_flags_test_2800, testing::ext::TestSize.Level1)
+{
+    HILOG_INFO("--- merge_BulkWrite_flags_test_2800 is starting! ---");
+    std::shared_ptr<OHOS::Contacts::ContactsDataBase> contactsDataBase =
+        OHOS::Contacts::ContactsDataBase::GetInstance();
+    ASSERT_NE(contactsDataBase, nullptr);
+    std::shared_ptr<OHOS::NativeRdb::RdbStore> store = contactsDataBase->contactStore_;
+    ASSERT_NE(store, nullptr);
+    // {contact_id, name raw contact, merged raw contact}，第一组逐行触发，第二组批量写
+    const std::vector<std::vector<std::string>> contacts = {{"990001", "990001", "990002"},
+        {"990011", "990011", "990012"}};
+    auto clear = [&store, &contacts]() {
+        for (const auto &ids : contacts) {
+            store->ExecuteSql("DELETE FROM contact_data WHERE raw_contact_id IN (?, ?)", {ids[1], ids[2]});
+            store->ExecuteSql("DELETE FROM raw_contact WHERE contact_id = ?", {ids[0]});
+            store->ExecuteSql("DELETE FROM contact WHERE id = ?", {ids[0]});
+        }
+    };
+    // rowArgs逐行触发执行，bulkArgs在批量写中执行
+    auto write = [&contactsDataBase, &store](const std::string &sql,
+        const std::vector<OHOS::NativeRdb::ValueObject> &rowArgs,
+        const std::vector<OHOS::NativeRdb::ValueObject> &bulkArgs) {
+        store->ExecuteSql(sql, rowArgs);
+        contactsDataBase->BeginTransaction();
+        contactsDataBase->BeginBulkWrite();
+        store->ExecuteSql(sql, bulkArgs);
+        EXPECT_EQ(contactsDataBase->EndBulkWrite(), OHOS::NativeRdb::E_OK);
+        contactsDataBase->Commit();
+    };
+    auto queryFlags = [&store](const std::string &contactId) {
+        auto resultSet = store->QuerySql("SELECT has_display_name, has_email, has_group, has_phone_number "
+            "FROM contact WHERE id = ?", {contactId});
+        std::vector<int> flags;
+        if (resultSet != nullptr && resultSet->GoToFirstRow() == OHOS::NativeRdb::E_OK) {
+            for (int i = 0; i < 4; i++) {
+                int flag = -1;
+                resultSet->GetInt(i, flag);
+                flags.push_back(flag);
+            }
+        }
+        if (resultSet != nullptr) {
+            resultSet->Close();
+        }
+        return flags;
+    };
+    clear();
+    for (const auto &ids : contacts) {
+        store->ExecuteSql("INSERT INTO contact (id, name_raw_contact_id) VALUES (?, ?)", {ids[0], ids[1]});
+        store->ExecuteSql("INSERT INTO raw_contact (id, contact_id) VALUES (?, ?), (?, ?)",
+            {ids[1], ids[0], ids[2], ids[0]});
+    }
+
+    // 合并进来的raw_contact的号码不影响标记
+    write("INSERT INTO contact_data (raw_contact_id, type_id, detail_info) VALUES (?, 1, 'merge@test.com'), "
+        "(?, 6, 'merge'), (?, 5, '13800000000')", {"990001", "990001", "990002"}, {"990011", "990011", "990012"});
+    EXPECT_EQ(queryFlags(contacts[0][0]), std::vector<int>({1, 1, 0, 0}));
+    EXPECT_EQ(queryFlags(contacts[1][0]), queryFlags(contacts[0][0]));
+
+    write("DELETE FROM contact_data WHERE raw_contact_id = ? AND type_id = 1", {"990001"}, {"990011"});
+    EXPECT_EQ(queryFlags(contacts[0][0]), std::vector<int>({1, 0, 0, 0}));
+    EXPECT_EQ(queryFlags(contacts[1][0]), queryFlags(contacts[0][0]));
+
+    // 号码移到name raw contact下后才设置has_phone_number
+    write("UPDATE contact_data SET raw_contact_id = ? WHERE raw_contact_id = ? AND type_id = 5", {"990001", "990002"},
+        {"990011", "990012"});
+    EXPECT_EQ(queryFlags(contacts[0][0]), std::vector<int>({1, 0, 0, 1}));
+    EXPECT_EQ(queryFlags(contacts[1][0]), queryFlags(contacts[0][0]));
+    clear();
+}
 } // namespace Test
 } // namespace Contacts
\ No newline at end of file
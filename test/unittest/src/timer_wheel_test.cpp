@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) Huawei Technologies Co., Ltd. 2024-2025. All rights reserved.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_wheel_test.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace Contacts {
+namespace Test {
+namespace {
+constexpr int64_t TICK_MS = 100;
+}
+
+int RecordTask::lastTag_ = 0;
+
+void TimerWheelTest::SetUp()
+{
+    clock_ = std::make_shared<ManualTimerClock>();
+    runTimes_.clear();
+    RecordTask::lastTag_ = 0;
+}
+
+void TimerWheelTest::AdvanceAndRun(OHOS::Contacts::TimerWheel &timerWheel, int64_t ms, int64_t stepMs)
+{
+    for (int64_t passed = 0; passed < ms; passed += stepMs) {
+        clock_->AdvanceMs(stepMs);
+        timerWheel.Advance();
+    }
+}
+
+/*
+ * @tc.number  timer_wheel_test_100
+ * @tc.name    Task runs at its deadline, not before
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_100, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), 1000);
+    AdvanceAndRun(timerWheel, 900, TICK_MS);
+    EXPECT_TRUE(runTimes_.empty());
+    AdvanceAndRun(timerWheel, 100, TICK_MS);
+    ASSERT_EQ(1, (int) runTimes_.size());
+    EXPECT_EQ(1000, runTimes_[0]);
+    EXPECT_EQ(0, (int) timerWheel.Pending());
+}
+
+/*
+ * @tc.number  timer_wheel_test_200
+ * @tc.name    Long delays cascade from the upper levels and the overflow list
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_200, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    std::vector<int64_t> delays = {6500, 409600, 30000000};
+    for (int64_t delay : delays) {
+        timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), delay);
+    }
+    AdvanceAndRun(timerWheel, delays.back(), TICK_MS);
+    ASSERT_EQ(delays.size(), runTimes_.size());
+    for (size_t i = 0; i < delays.size(); i++) {
+        EXPECT_EQ(delays[i], runTimes_[i]);
+    }
+}
+
+/*
+ * @tc.number  timer_wheel_test_300
+ * @tc.name    Same key with REPLACE keeps the first deadline and runs the latest task once
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_300, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    int submitCount = 5;
+    for (int i = 1; i <= submitCount; i++) {
+        timerWheel.Schedule("key", std::make_shared<RecordTask>(clock_, runTimes_, i), 1000,
+            OHOS::Contacts::TimerCoalescePolicy::REPLACE);
+        AdvanceAndRun(timerWheel, TICK_MS, TICK_MS);
+    }
+    AdvanceAndRun(timerWheel, 1000, TICK_MS);
+    ASSERT_EQ(1, (int) runTimes_.size());
+    EXPECT_EQ(1000, runTimes_[0]);
+    EXPECT_EQ(submitCount, RecordTask::lastTag_);
+}
+
+/*
+ * @tc.number  timer_wheel_test_400
+ * @tc.name    Same key with EXTEND pushes the deadline back
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_400, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    timerWheel.Schedule("key", std::make_shared<RecordTask>(clock_, runTimes_), 1000,
+        OHOS::Contacts::TimerCoalescePolicy::EXTEND);
+    AdvanceAndRun(timerWheel, 500, TICK_MS);
+    timerWheel.Schedule("key", std::make_shared<RecordTask>(clock_, runTimes_), 1000,
+        OHOS::Contacts::TimerCoalescePolicy::EXTEND);
+    AdvanceAndRun(timerWheel, 2000, TICK_MS);
+    ASSERT_EQ(1, (int) runTimes_.size());
+    EXPECT_EQ(1500, runTimes_[0]);
+}
+
+/*
+ * @tc.number  timer_wheel_test_500
+ * @tc.name    Cancel by id and by key
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_500, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    uint64_t id = timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), 1000);
+    timerWheel.Schedule("key", std::make_shared<RecordTask>(clock_, runTimes_), 1000);
+    EXPECT_TRUE(timerWheel.Cancel(id));
+    EXPECT_TRUE(timerWheel.Cancel("key"));
+    EXPECT_FALSE(timerWheel.Cancel("key"));
+    AdvanceAndRun(timerWheel, 2000, TICK_MS);
+    EXPECT_TRUE(runTimes_.empty());
+}
+
+/*
+ * @tc.number  timer_wheel_test_600
+ * @tc.name    Shutdown with drain runs pending tasks in deadline order and rejects new ones
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_600, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_, 2), 5000);
+    timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_, 1), 1000);
+    EXPECT_EQ(2, (int) timerWheel.Shutdown(true));
+    EXPECT_EQ(2, (int) runTimes_.size());
+    EXPECT_EQ(2, RecordTask::lastTag_);
+    EXPECT_EQ(OHOS::Contacts::TimerWheel::INVALID_TIMER_ID,
+        timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), 1000));
+}
+
+/*
+ * @tc.number  timer_wheel_test_700
+ * @tc.name    A late Advance catches up and runs every task that became due
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_700, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    int taskCount = 100;
+    for (int i = 1; i <= taskCount; i++) {
+        timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), i * 1000);
+    }
+    clock_->AdvanceMs(taskCount * 1000);
+    EXPECT_EQ(taskCount, (int) timerWheel.Advance());
+    EXPECT_EQ(0, (int) timerWheel.Pending());
+}
+
+/*
+ * @tc.number  timer_wheel_test_800
+ * @tc.name    A task added after a long idle period is placed relative to the current time
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_800, testing::ext::TestSize.Level1)
+{
+    OHOS::Contacts::TimerWheel timerWheel(clock_, TICK_MS);
+    // 空闲超过三层时间轮的范围，期间没有调用Advance
+    int64_t idleMs = 64 * 64 * 64 * TICK_MS + 12345;
+    clock_->AdvanceMs(idleMs);
+    timerWheel.Schedule(std::make_shared<RecordTask>(clock_, runTimes_), 1000);
+    clock_->AdvanceMs(900);
+    EXPECT_EQ(0, (int) timerWheel.Advance());
+    AdvanceAndRun(timerWheel, 500, TICK_MS);
+    ASSERT_EQ(1, (int) runTimes_.size());
+    EXPECT_GE(runTimes_[0], idleMs + 1000);
+    EXPECT_LE(runTimes_[0], idleMs + 1000 + TICK_MS);
+}
+
+/*
+ * @tc.number  timer_wheel_test_900
+ * @tc.name    Destroying a DelayAsyncTask drops the tasks that are not due yet
+ * @tc.desc    Function use case
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_900, testing::ext::TestSize.Level1)
+{
+    {
+        OHOS::Contacts::DelayAsyncTask delayTask(1000, clock_);
+        delayTask.put("key", std::make_shared<RecordTask>(clock_, runTimes_));
+        delayTask.put(std::make_shared<RecordTask>(clock_, runTimes_));
+        EXPECT_EQ(2, (int) delayTask.GetTimerWheel().Pending());
+    }
+    EXPECT_TRUE(runTimes_.empty());
+}
+
+/*
+ * @tc.number  timer_wheel_test_1000
+ * @tc.name    Change notifications within one interval are coalesced into one deferred publish
+ * @tc.desc    The first change after idle is published at once; a burst inside the interval is published by one
+ *             flush on the one-second delay task, carrying the latest change time
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(TimerWheelTest, timer_wheel_test_1000, testing::ext::TestSize.Level1)
+{
+    std::mutex publishedMutex;
+    std::vector<time_t> published;
+    auto publishedCount = [&publishedMutex, &published]() {
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        return published.size();
+    };
+    auto coalescer = std::make_shared<OHOS::Contacts::ChangeNotifyCoalescer>(
+        OHOS::Contacts::DelayAsyncTask::GetInstanceDelay1S(), "timer-wheel-test-1000",
+        OHOS::Contacts::DelayAsyncTask::DEFAULT_DELAY_MS, [&publishedMutex, &published](time_t changeTime) {
+            std::lock_guard<std::mutex> lock(publishedMutex);
+            published.push_back(changeTime);
+        });
+    coalescer->Notify(100);
+    EXPECT_EQ(1u, publishedCount());
+    coalescer->Notify(101);
+    coalescer->Notify(102);
+    coalescer->Notify(103);
+    EXPECT_EQ(1u, publishedCount());
+    // 延迟任务在一个间隔后到期，最多再等一个间隔
+    int64_t waitedMs = 0;
+    while (publishedCount() < 2u && waitedMs < 2 * OHOS::Contacts::DelayAsyncTask::DEFAULT_DELAY_MS) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TICK_MS));
+        waitedMs += TICK_MS;
+    }
+    std::lock_guard<std::mutex> lock(publishedMutex);
+    ASSERT_EQ(2u, published.size());
+    EXPECT_EQ(100, published[0]);
+    EXPECT_EQ(103, published[1]);
+}
+} // namespace Test
+} // namespace Contacts
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uri_utils_test.h"
+
+#include "contacts_data_ability.h"
+#include "contacts_database.h"
+#include "profile_database.h"
+#include "test_common.h"
+
+namespace Contacts {
+namespace Test {
+namespace {
+const std::map<std::string, int> TEST_ROUTES = {
+    {"/com.ohos.contactsdataability/contacts/raw_contact", OHOS::Contacts::CONTACTS_RAW_CONTACT},
+    {"/com.ohos.contactsdataability/profile/raw_contact", OHOS::Contacts::PROFILE_RAW_CONTACT},
+};
+}
+
+UriUtilsTest::UriUtilsTest() : routes_(TEST_ROUTES), routeTable_(TEST_ROUTES)
+{
+}
+
+OHOS::Contacts::UriInfo UriUtilsTest::Parse(const std::string &uri)
+{
+    return uriUtils_.ParseUri(uri, routeTable_);
+}
+
+/*
+ * @tc.number  uri_utils_test_100
+ * @tc.name    ParseUri with an empty authority and with a host
+ * @tc.desc    The path starts after the authority, the route code matches UriParse on OHOS::Uri
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_100, testing::ext::TestSize.Level1)
+{
+    std::string uri = ContactsUri::RAW_CONTACT;
+    OHOS::Contacts::UriInfo info = Parse(uri);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(info.path, "/com.ohos.contactsdataability/contacts/raw_contact");
+    OHOS::Uri ohosUri(uri);
+    EXPECT_EQ(info.code, uriUtils_.UriParse(ohosUri, routes_));
+    std::string hostUri = "datashare://device/com.ohos.contactsdataability/contacts/raw_contact";
+    info = Parse(hostUri);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(info.path, "/com.ohos.contactsdataability/contacts/raw_contact");
+    std::string authorityOnly = "datashare://device";
+    info = Parse(authorityOnly);
+    EXPECT_TRUE(info.path.empty());
+    EXPECT_EQ(info.code, OHOS::Contacts::OPERATION_ERROR);
+}
+
+/*
+ * @tc.number  uri_utils_test_200
+ * @tc.name    ParseUri without a query
+ * @tc.desc    All query parameters stay empty
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_200, testing::ext::TestSize.Level1)
+{
+    std::string uri = ContactsUri::RAW_CONTACT;
+    OHOS::Contacts::UriInfo info = Parse(uri);
+    EXPECT_TRUE(info.isSyncFromCloud.empty());
+    EXPECT_TRUE(info.isFromBatch.empty());
+    EXPECT_TRUE(info.handleType.empty());
+    std::string emptyQuery = uri + "?";
+    info = Parse(emptyQuery);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_TRUE(info.isSyncFromCloud.empty());
+    EXPECT_TRUE(info.handleType.empty());
+}
+
+/*
+ * @tc.number  uri_utils_test_300
+ * @tc.name    ParseUri with repeated and malformed parameters
+ * @tc.desc    The first occurrence wins and malformed parameters are skipped, same as getQueryParameter
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_300, testing::ext::TestSize.Level1)
+{
+    std::string uri = std::string(ContactsUri::RAW_CONTACT) +
+        "?handleType=first&&handleType=second&isSyncFromCloud=a=b&isFromBatch=true";
+    OHOS::Contacts::UriInfo info = Parse(uri);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(info.handleType, "first");
+    EXPECT_TRUE(info.isSyncFromCloud.empty());
+    EXPECT_EQ(info.isFromBatch, "true");
+    OHOS::Uri ohosUri(uri);
+    std::map<std::string, std::string> query = uriUtils_.getQueryParameter(ohosUri);
+    EXPECT_EQ(query["handleType"], std::string(info.handleType));
+    EXPECT_EQ(query.count("isSyncFromCloud"), 0U);
+}
+
+/*
+ * @tc.number  uri_utils_test_400
+ * @tc.name    ParseUri with a fragment
+ * @tc.desc    The fragment is neither part of the path nor of the last query value
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_400, testing::ext::TestSize.Level1)
+{
+    std::string uri = std::string(ContactsUri::RAW_CONTACT) + "?isSyncFromCloud=true#handleType=fragment";
+    OHOS::Contacts::UriInfo info = Parse(uri);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(info.isSyncFromCloud, "true");
+    EXPECT_TRUE(info.handleType.empty());
+    std::string fragmentOnly = std::string(ContactsUri::RAW_CONTACT) + "#isSyncFromCloud=true";
+    info = Parse(fragmentOnly);
+    EXPECT_EQ(info.code, OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(info.path, "/com.ohos.contactsdataability/contacts/raw_contact");
+    EXPECT_TRUE(info.isSyncFromCloud.empty());
+}
+
+/*
+ * @tc.number  uri_utils_test_500
+ * @tc.name    UriRouteTable lookups of unknown paths
+ * @tc.desc    Paths outside the table, including prefixes of known paths, return OPERATION_ERROR
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_500, testing::ext::TestSize.Level1)
+{
+    EXPECT_EQ(routeTable_.Find("/com.ohos.contactsdataability/contacts/unknown"), OHOS::Contacts::OPERATION_ERROR);
+    EXPECT_EQ(routeTable_.Find("/com.ohos.contactsdataability/contacts"), OHOS::Contacts::OPERATION_ERROR);
+    EXPECT_EQ(routeTable_.Find(""), OHOS::Contacts::OPERATION_ERROR);
+    std::string uri = "datashare:///com.ohos.contactsdataability/contacts/unknown?isSyncFromCloud=true";
+    OHOS::Contacts::UriInfo info = Parse(uri);
+    EXPECT_EQ(info.code, OHOS::Contacts::OPERATION_ERROR);
+    EXPECT_EQ(info.isSyncFromCloud, "true");
+    OHOS::Uri ohosUri(uri);
+    EXPECT_EQ(OHOS::AbilityRuntime::ContactsDataAbility::UriParseAndSwitch(ohosUri), OHOS::Contacts::OPERATION_ERROR);
+}
+
+/*
+ * @tc.number  uri_utils_test_600
+ * @tc.name    UriParseAndSwitch between the contacts and profile stores
+ * @tc.desc    The route code follows the uri and the ability switches to the matching store
+ * @tc.level   Level1
+ * @tc.size    MediumTest
+ * @tc.type    Function
+ */
+HWTEST_F(UriUtilsTest, uri_utils_test_600, testing::ext::TestSize.Level1)
+{
+    OHOS::Uri contactsUri(ContactsUri::RAW_CONTACT);
+    EXPECT_EQ(OHOS::AbilityRuntime::ContactsDataAbility::UriParseAndSwitch(contactsUri),
+        OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    auto contactsDataBase = OHOS::Contacts::ContactsDataBase::GetInstance();
+    EXPECT_EQ(contactsDataBase->store_, contactsDataBase->contactStore_);
+    OHOS::Uri profileUri(ProfileUri::RAW_CONTACT);
+    EXPECT_EQ(OHOS::AbilityRuntime::ContactsDataAbility::UriParseAndSwitch(profileUri),
+        OHOS::Contacts::PROFILE_RAW_CONTACT);
+    EXPECT_EQ(contactsDataBase->store_, OHOS::Contacts::ProfileDatabase::GetInstance()->store_);
+    EXPECT_EQ(OHOS::AbilityRuntime::ContactsDataAbility::UriParseAndSwitch(contactsUri),
+        OHOS::Contacts::CONTACTS_RAW_CONTACT);
+    EXPECT_EQ(contactsDataBase->store_, contactsDataBase->contactStore_);
+}
+} // namespace Test
+} // namespace Contacts